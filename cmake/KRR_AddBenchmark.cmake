@@ -0,0 +1,29 @@
+include(KRR_Message)
+
+function(krr_add_benchmark project_name module_name benchmark_name)
+    # ----------------------------------------------------------
+    # Retrieve arguments
+    # ----------------------------------------------------------
+    set(options "")
+    set(one_value_args "")
+    set(multi_value_args SOURCES HARD_DEPENDENCIES)
+
+    cmake_parse_arguments(
+        BENCHMARK
+        "${options}"
+        "${one_value_args}"
+        "${multi_value_args}"
+        ${ARGN})
+
+    krr_message(INFO "Adding benchmark ${BoldGreen}${project_name}::${module_name}::${benchmark_name}${ColorReset}")
+
+    # ----------------------------------------------------------
+    # Setup benchmark sources
+    # ----------------------------------------------------------
+    # Benchmarks are not registered to CTest, run them manually in the Release build.
+    set(benchmark_base_name ${project_name}.${module_name}.${benchmark_name})
+    add_executable(${benchmark_base_name} ${BENCHMARK_SOURCES})
+    target_link_libraries(${benchmark_base_name} PRIVATE benchmark::benchmark_main ${BENCHMARK_HARD_DEPENDENCIES})
+
+    set_target_properties(${benchmark_base_name} PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/benchmarks")
+endfunction()
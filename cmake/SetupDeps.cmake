@@ -22,6 +22,13 @@ if(KRR_BUILD_TESTS)
     find_package(GTest CONFIG REQUIRED)
 endif()
 
+if(KRR_BUILD_BENCHMARKS)
+    # ----------------------------------------------------------
+    # Google Benchmark
+    # ----------------------------------------------------------
+    find_package(benchmark CONFIG REQUIRED)
+endif()
+
 if(KRR_BUILD_COMPTIME_TESTS)
     # ----------------------------------------------------------
     # ut2
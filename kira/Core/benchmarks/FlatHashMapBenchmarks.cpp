@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <unordered_map>
+
+#include "kira/FlatHashMap.h"
+
+using namespace kira;
+
+//! NOTE(krr): `FlatHashMap` against `std::unordered_map` on the workloads of the scene visitors,
+//! whose keys are the node IDs, i.e., sequential integers: the lookups of the IDs there and not
+//! there, the insertions, and the copy and the iteration of the map of the accumulated transforms
+//! per transform node.
+
+namespace {
+/// As large as `float4x4`.
+using Matrix = std::array<float, 16>;
+
+template <typename Map> Map MakeMap(int64 size) {
+    Map map;
+    for (int64 i = 0; i < size; ++i)
+        map.emplace(static_cast<uint64>(i), Matrix{});
+    return map;
+}
+
+template <typename Map> void BM_Insert(benchmark::State &state) {
+    for (auto _ : state) {
+        auto map = MakeMap<Map>(state.range(0));
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map> void BM_FindHit(benchmark::State &state) {
+    auto const map = MakeMap<Map>(state.range(0));
+    auto const size = static_cast<uint64>(state.range(0));
+    uint64 key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(key));
+        key = (key + 7) % size;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map> void BM_FindMiss(benchmark::State &state) {
+    auto const map = MakeMap<Map>(state.range(0));
+    auto key = static_cast<uint64>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(map.find(key++));
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// What `ExtractNodeTransforms` does per transform node.
+template <typename Map> void BM_CopyIterate(benchmark::State &state) {
+    auto const map = MakeMap<Map>(state.range(0));
+    for (auto _ : state) {
+        auto copy = map;
+        for (auto &[key, matrix] : copy)
+            matrix[0] += 1.0F;
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using StdMap = std::unordered_map<uint64, Matrix>;
+using FlatMap = FlatHashMap<uint64, Matrix>;
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Insert, StdMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_Insert, FlatMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_FindHit, StdMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_FindHit, FlatMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_FindMiss, StdMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_FindMiss, FlatMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK_TEMPLATE(BM_CopyIterate, StdMap)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK_TEMPLATE(BM_CopyIterate, FlatMap)->RangeMultiplier(8)->Range(8, 512);
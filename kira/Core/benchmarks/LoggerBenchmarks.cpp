@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "kira/Logger.h"
+#include "kira/detail/AsyncSink.h"
+
+using namespace kira;
+
+//! NOTE(krr): The cost of a call on the thread which logs, i.e., what is left in the frame loop,
+//! for every mode of the loggers. The asynchronous loggers drop the records when they are full,
+//! s.t. the background thread writing into the file is not measured, see the `dropped` counter.
+
+namespace {
+std::filesystem::path const logPath = std::filesystem::temp_directory_path() / "kira.bench.log";
+std::filesystem::path const binaryPath =
+    std::filesystem::temp_directory_path() / "kira.bench.krrlog";
+
+template <detail::StringLiteral name>
+void BM_Log(benchmark::State &state, LoggerBuilder const &builder) {
+    auto const logger = builder.init();
+    LoggerCustomizationPoint<name, spdlog::level::info> logInfo;
+
+    int64 frame = 0;
+    for (auto _ : state)
+        logInfo("frame {} took {:.3f} ms, {} triangles", frame++, 16.6, 123456);
+    LogFlush<name>();
+
+    if (auto const sink = std::dynamic_pointer_cast<detail::AsyncSink>(logger->sinks().front()))
+        state.counters["dropped"] = static_cast<double>(sink->dropped());
+    spdlog::drop(std::string{name.value});
+}
+
+/// A call filtered out at runtime, which is the least a call costs unless removed at compile time.
+void BM_Filtered(benchmark::State &state) {
+    auto const logger = LoggerBuilder{"benchFiltered"}
+                            .to_console(false)
+                            .filter_level(spdlog::level::info)
+                            .init();
+    LoggerCustomizationPoint<"benchFiltered", spdlog::level::debug> logDebug;
+
+    int64 frame = 0;
+    for (auto _ : state)
+        logDebug("frame {} took {:.3f} ms, {} triangles", frame++, 16.6, 123456);
+    spdlog::drop("benchFiltered");
+}
+
+constexpr auto overflow = LogOverflowPolicy::DropNewest;
+
+void BM_Sync(benchmark::State &state) {
+    BM_Log<"benchSync">(
+        state, LoggerBuilder{"benchSync"}
+                   .to_console(false)
+                   .to_file(logPath)
+                   .filter_level(spdlog::level::info)
+    );
+}
+
+void BM_Async(benchmark::State &state) {
+    BM_Log<"benchAsync">(
+        state,
+        LoggerBuilder{"benchAsync"}.to_console(false).to_file(logPath).async(1 << 16, overflow)
+    );
+}
+
+void BM_Deferred(benchmark::State &state) {
+    BM_Log<"benchDeferred">(
+        state, LoggerBuilder{"benchDeferred"}
+                   .to_console(false)
+                   .to_file(logPath)
+                   .async(1 << 16, overflow)
+                   .deferred()
+    );
+}
+
+/// Nothing is formatted at all, but by `kira.Core.LogDecode`.
+void BM_DeferredBinary(benchmark::State &state) {
+    BM_Log<"benchBinary">(
+        state, LoggerBuilder{"benchBinary"}
+                   .to_console(false)
+                   .to_binary_file(binaryPath)
+                   .async(1 << 16, overflow)
+                   .deferred()
+    );
+}
+} // namespace
+
+BENCHMARK(BM_Filtered);
+BENCHMARK(BM_Sync);
+BENCHMARK(BM_Async);
+BENCHMARK(BM_Deferred);
+BENCHMARK(BM_DeferredBinary);
@@ -58,6 +58,15 @@ namespace kira {
 #define KIRA_LIFETIME_BOUND
 #endif
 
+/// Let the empty members, e.g., the hashers, take no space.
+#if KIRA_HAS_CPP_ATTRIBUTE(msvc::no_unique_address)
+#define KIRA_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#elif KIRA_HAS_CPP_ATTRIBUTE(no_unique_address)
+#define KIRA_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#else
+#define KIRA_NO_UNIQUE_ADDRESS
+#endif
+
 #if defined(__clang__) || defined(__GNUC__)
 #define KIRA_DIAGNOSTIC_PUSH         _Pragma("GCC diagnostic push")
 #define KIRA_IGNORE_UNUSED_PARAMETER _Pragma("GCC diagnostic ignored \"-Wunused-parameter\"")
@@ -0,0 +1,756 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KIRA_FLAT_HASH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define KIRA_FLAT_HASH_NEON 1
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "kira/Compiler.h"
+#include "kira/Types.h"
+
+namespace kira {
+//! NOTE(krr): The hash map and set of the Swiss tables (see Abseil's `flat_hash_map`), which keep
+//! the elements in a single array, s.t. neither an insertion allocates a node nor a lookup chases
+//! a pointer. A control byte per slot holds 7 bits of the hash of its element, or whether the slot
+//! is empty or deleted, and a lookup compares the control bytes of a group of 16 slots to those
+//! bits at once by SSE2 (or NEON), thus only compares the keys of the slots of the same 7 bits. The
+//! groups are probed quadratically from the one the rest of the hash points to, until a group with
+//! an empty slot. The table grows by 2 at the load of 7/8.
+//!
+//! Unlike `std::unordered_map`, the references to the elements are invalidated by the insertions,
+//! which may rehash, and the elements are iterated in no particular order.
+//!
+//! `std::hash` of the integers is the identity in libstdc++ and libc++, whose low bits are hardly
+//! random for the sequential IDs, thus the keys are hashed by `kira::Hash`, which mixes the
+//! integers and the pointers by a multiplication, and the others after `std::hash`.
+
+namespace detail {
+/// Mix the bits of `value`, s.t. each bit of the result depends on all the bits of `value`.
+[[nodiscard]] KIRA_FORCEINLINE uint64 MixHash(uint64 value) noexcept {
+    constexpr uint64 multiplier = 0x9e3779b97f4a7c15ULL;
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    auto const product = static_cast<uint128>(value) * multiplier;
+    return static_cast<uint64>(product) ^ static_cast<uint64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64 high = 0;
+    auto const low = _umul128(value, multiplier, &high);
+    return low ^ high;
+#else
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    return value ^ value >> 33;
+#endif
+}
+} // namespace detail
+
+/// The hash of the keys of `FlatHashMap` and `FlatHashSet`.
+template <typename T> struct Hash {
+    [[nodiscard]] std::size_t operator()(T const &value) const noexcept {
+        if constexpr (std::is_integral_v<T> or std::is_enum_v<T>)
+            return detail::MixHash(static_cast<uint64>(value));
+        else if constexpr (std::is_pointer_v<T>)
+            return detail::MixHash(reinterpret_cast<std::uintptr_t>(value));
+        else
+            return detail::MixHash(std::hash<T>{}(value));
+    }
+};
+
+namespace detail {
+/// The control byte of a slot, which is the 7 bits of the hash if full, or negative otherwise.
+using FlatCtrl = int8;
+
+inline constexpr FlatCtrl flatEmpty = -128;
+inline constexpr FlatCtrl flatDeleted = -2;
+/// The bytes past the slots of a table smaller than a group, which are neither full nor empty.
+inline constexpr FlatCtrl flatPadding = -1;
+
+/// The control bytes of a group of slots, which are compared at once.
+class FlatGroup {
+public:
+    static constexpr std::size_t width = 16;
+
+    explicit FlatGroup(FlatCtrl const *ctrl) noexcept {
+#if KIRA_FLAT_HASH_SSE2
+        bytes = _mm_load_si128(reinterpret_cast<__m128i const *>(ctrl));
+#elif KIRA_FLAT_HASH_NEON
+        bytes = vld1q_s8(ctrl);
+#else
+        std::memcpy(bytes, ctrl, width);
+#endif
+    }
+
+    /// The slots whose control byte is `h2`, by bits.
+    [[nodiscard]] uint32 Match(FlatCtrl h2) const noexcept {
+#if KIRA_FLAT_HASH_SSE2
+        return MoveMask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes));
+#elif KIRA_FLAT_HASH_NEON
+        return MoveMask(vceqq_s8(vdupq_n_s8(h2), bytes));
+#else
+        return Bits([h2](FlatCtrl ctrl) { return ctrl == h2; });
+#endif
+    }
+
+    [[nodiscard]] uint32 MatchEmpty() const noexcept { return Match(flatEmpty); }
+
+    [[nodiscard]] uint32 MatchEmptyOrDeleted() const noexcept {
+#if KIRA_FLAT_HASH_SSE2
+        return MoveMask(_mm_cmpgt_epi8(_mm_set1_epi8(flatPadding), bytes));
+#elif KIRA_FLAT_HASH_NEON
+        return MoveMask(vcltq_s8(bytes, vdupq_n_s8(flatPadding)));
+#else
+        return Bits([](FlatCtrl ctrl) { return ctrl < flatPadding; });
+#endif
+    }
+
+private:
+#if KIRA_FLAT_HASH_SSE2
+    static uint32 MoveMask(__m128i mask) noexcept {
+        return static_cast<uint32>(_mm_movemask_epi8(mask));
+    }
+
+    __m128i bytes;
+#elif KIRA_FLAT_HASH_NEON
+    static uint32 MoveMask(uint8x16_t mask) noexcept {
+        // A bit per lane, summed over each half.
+        constexpr uint8 weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        auto const bits = vandq_u8(mask, vld1q_u8(weights));
+        return static_cast<uint32>(vaddv_u8(vget_low_u8(bits))) |
+               static_cast<uint32>(vaddv_u8(vget_high_u8(bits))) << 8;
+    }
+
+    int8x16_t bytes;
+#else
+    template <typename Pred> uint32 Bits(Pred const &pred) const noexcept {
+        uint32 mask = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            mask |= static_cast<uint32>(pred(bytes[i])) << i;
+        return mask;
+    }
+
+    FlatCtrl bytes[width];
+#endif
+};
+
+/// The elements of `FlatHashMap`.
+template <typename K, typename V> struct FlatMapPolicy {
+    using key_type = K;
+    using value_type = std::pair<K const, V>;
+    static constexpr bool isSet = false;
+
+    static K const &GetKey(value_type const &value) noexcept { return value.first; }
+};
+
+/// The elements of `FlatHashSet`.
+template <typename K> struct FlatSetPolicy {
+    using key_type = K;
+    using value_type = K;
+    static constexpr bool isSet = true;
+
+    static K const &GetKey(value_type const &value) noexcept { return value; }
+};
+
+/// The table of `FlatHashMap` and `FlatHashSet`.
+template <typename Policy, typename Hasher, typename KeyEqual> class FlatHashTable {
+    template <bool Const> class Iterator;
+
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hasher;
+    using key_equal = KeyEqual;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using const_iterator = Iterator<true>;
+    using iterator = std::conditional_t<Policy::isSet, const_iterator, Iterator<false>>;
+
+    FlatHashTable() noexcept = default;
+
+    explicit FlatHashTable(size_type bucketCount, Hasher const &inHash = Hasher(),
+                           KeyEqual const &inEq = KeyEqual())
+        : hash(inHash), eq(inEq) {
+        reserve(bucketCount);
+    }
+
+    template <typename InputIt>
+    FlatHashTable(InputIt first, InputIt last, size_type bucketCount = 0) {
+        reserve(bucketCount);
+        insert(first, last);
+    }
+
+    FlatHashTable(std::initializer_list<value_type> values, size_type bucketCount = 0)
+        : FlatHashTable(values.begin(), values.end(), bucketCount) {}
+
+    FlatHashTable(FlatHashTable const &other) : hash(other.hash), eq(other.eq) {
+        if (other.size_ == 0)
+            return;
+
+        // The same layout, s.t. the control bytes are copied as they are.
+        Allocate(other.capacity_);
+        std::memcpy(ctrl, other.ctrl, CtrlBytes(capacity_));
+        size_type i = 0;
+        try {
+            for (; i < capacity_; ++i)
+                if (IsFull(ctrl[i]))
+                    new (slots + i) value_type(other.slots[i]);
+        } catch (...) {
+            for (size_type j = 0; j < i; ++j)
+                if (IsFull(ctrl[j]))
+                    slots[j].~value_type();
+            Deallocate();
+            throw;
+        }
+        size_ = other.size_;
+        growthLeft = other.growthLeft;
+    }
+
+    FlatHashTable(FlatHashTable &&other) noexcept
+        : ctrl(std::exchange(other.ctrl, nullptr)), slots(std::exchange(other.slots, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)), size_(std::exchange(other.size_, 0)),
+          growthLeft(std::exchange(other.growthLeft, 0)), hash(std::move(other.hash)),
+          eq(std::move(other.eq)) {}
+
+    FlatHashTable &operator=(FlatHashTable const &other) {
+        if (this != &other) {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashTable &operator=(FlatHashTable &&other) noexcept {
+        if (this != &other) {
+            FlatHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    FlatHashTable &operator=(std::initializer_list<value_type> values) {
+        clear();
+        insert(values);
+        return *this;
+    }
+
+    ~FlatHashTable() {
+        DestroySlots();
+        Deallocate();
+    }
+
+    /// \name Iterators
+    /// \{
+    [[nodiscard]] iterator begin() noexcept { return iterator(ctrl, slots, ctrl + capacity_); }
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(ctrl, slots, ctrl + capacity_);
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] iterator end() noexcept { return iterator(); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+    /// \}
+
+    /// \name Capacity
+    /// \{
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_type max_size() const noexcept {
+        return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+    }
+    [[nodiscard]] float load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0F
+                              : static_cast<float>(size_) / static_cast<float>(capacity_);
+    }
+    /// \}
+
+    /// \name Modifiers
+    /// \{
+    /// Destroy the elements, while keeping the capacity.
+    void clear() noexcept {
+        if (capacity_ == 0)
+            return;
+        DestroySlots();
+        ResetCtrl();
+        size_ = 0;
+        growthLeft = MaxLoad(capacity_);
+    }
+
+    std::pair<iterator, bool> insert(value_type const &value) {
+        return EmplaceByKey(Policy::GetKey(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type &&value) {
+        return EmplaceByKey(Policy::GetKey(value), std::move(value));
+    }
+
+    template <typename InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    void insert(std::initializer_list<value_type> values) { insert(values.begin(), values.end()); }
+
+    /// Construct an element of `args` if its key is not there.
+    template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+        if constexpr (sizeof...(Args) == 1 and
+                      (std::is_same_v<std::remove_cvref_t<Args>, value_type> and ...)) {
+            return EmplaceByKey(Policy::GetKey(args...), std::forward<Args>(args)...);
+        } else if constexpr (not Policy::isSet and sizeof...(Args) == 2) {
+            // The key without a temporary element, as `try_emplace()`.
+            auto &&key = std::get<0>(std::forward_as_tuple(args...));
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(key)>, key_type>)
+                return EmplaceByKey(key, std::forward<Args>(args)...);
+            else
+                return insert(value_type(std::forward<Args>(args)...));
+        } else {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+    }
+
+    /// Destroy the element of `key`, if any.
+    ///
+    /// \return The number of the elements destroyed.
+    size_type erase(key_type const &key) {
+        auto const index = FindIndex(key);
+        if (index == npos)
+            return 0;
+        EraseAt(index);
+        return 1;
+    }
+
+    /// Destroy the element at `pos`.
+    ///
+    /// \return The element after `pos`.
+    iterator erase(const_iterator pos) {
+        auto const index = static_cast<size_type>(pos.ctrl - ctrl);
+        EraseAt(index);
+        return iterator(ctrl + index, slots + index, ctrl + capacity_);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last)
+            first = erase(first);
+        return iterator(first.ctrl, const_cast<value_type *>(first.slot), first.end);
+    }
+
+    void swap(FlatHashTable &other) noexcept {
+        using std::swap;
+        swap(ctrl, other.ctrl);
+        swap(slots, other.slots);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growthLeft, other.growthLeft);
+        swap(hash, other.hash);
+        swap(eq, other.eq);
+    }
+    /// \}
+
+    /// \name Lookup
+    /// \{
+    [[nodiscard]] iterator find(key_type const &key) {
+        auto const index = FindIndex(key);
+        return index == npos ? end() : iterator(ctrl + index, slots + index, ctrl + capacity_);
+    }
+
+    [[nodiscard]] const_iterator find(key_type const &key) const {
+        auto const index = FindIndex(key);
+        return index == npos ? end()
+                             : const_iterator(ctrl + index, slots + index, ctrl + capacity_);
+    }
+
+    [[nodiscard]] bool contains(key_type const &key) const { return FindIndex(key) != npos; }
+
+    [[nodiscard]] size_type count(key_type const &key) const { return contains(key) ? 1 : 0; }
+    /// \}
+
+    /// \name Hash policy
+    /// \{
+    /// Make room for `count` elements without a rehash.
+    void reserve(size_type count) {
+        if (count <= size_ + growthLeft)
+            return;
+        size_type newCapacity = minCapacity;
+        while (MaxLoad(newCapacity) < count)
+            newCapacity *= 2;
+        Resize(newCapacity);
+    }
+
+    /// Rehash into the smallest capacity holding `count` elements and the elements there.
+    void rehash(size_type count) {
+        count = std::max(count, size_);
+        if (count == 0) {
+            FlatHashTable().swap(*this);
+            return;
+        }
+        size_type newCapacity = minCapacity;
+        while (MaxLoad(newCapacity) < count)
+            newCapacity *= 2;
+        Resize(newCapacity);
+    }
+
+    [[nodiscard]] hasher hash_function() const { return hash; }
+    [[nodiscard]] key_equal key_eq() const { return eq; }
+    /// \}
+
+    friend bool operator==(FlatHashTable const &lhs, FlatHashTable const &rhs) {
+        if (lhs.size_ != rhs.size_)
+            return false;
+        for (auto const &value : lhs) {
+            auto const it = rhs.find(Policy::GetKey(value));
+            if (it == rhs.end() or not(*it == value))
+                return false;
+        }
+        return true;
+    }
+
+    friend void swap(FlatHashTable &lhs, FlatHashTable &rhs) noexcept { lhs.swap(rhs); }
+
+protected:
+    static constexpr size_type npos = ~size_type{0};
+    static constexpr size_type minCapacity = 4;
+
+    /// Find the element of `key`, or construct one of `args`.
+    template <typename... Args>
+    std::pair<iterator, bool> EmplaceByKey(key_type const &key, Args &&...args) {
+        auto const h = hash(key);
+        if (auto const index = FindIndex(key, h); index != npos)
+            return {iterator(ctrl + index, slots + index, ctrl + capacity_), false};
+
+        auto index = PrepareInsert(h);
+        if (KIRA_LIKELY(index != npos)) {
+            new (slots + index) value_type(std::forward<Args>(args)...);
+        } else {
+            // Constructed before growing, as `key` and `args` may refer to the elements, which the
+            // growth moves away and frees.
+            value_type value(std::forward<Args>(args)...);
+            index = Grow(h);
+            new (slots + index) value_type(std::move(value));
+        }
+        CommitInsert(index, h);
+        return {iterator(ctrl + index, slots + index, ctrl + capacity_), true};
+    }
+
+private:
+    template <bool Const> class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, value_type const *, value_type *>;
+        using reference = std::conditional_t<Const, value_type const &, value_type &>;
+
+        Iterator() noexcept = default;
+
+        /// The non-const one converts to the const one.
+        template <bool OtherConst>
+            requires(Const and not OtherConst)
+        Iterator(Iterator<OtherConst> const &other) noexcept
+            : ctrl(other.ctrl), slot(other.slot), end(other.end) {}
+
+        [[nodiscard]] reference operator*() const noexcept { return *slot; }
+        [[nodiscard]] pointer operator->() const noexcept { return slot; }
+
+        Iterator &operator++() noexcept {
+            ++ctrl;
+            ++slot;
+            SkipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(Iterator const &lhs, Iterator const &rhs) noexcept {
+            return lhs.ctrl == rhs.ctrl;
+        }
+
+    private:
+        friend class FlatHashTable;
+        template <bool> friend class Iterator;
+
+        Iterator(FlatCtrl const *inCtrl, value_type *inSlot, FlatCtrl const *inEnd) noexcept
+            : ctrl(inCtrl), slot(inSlot), end(inEnd) {
+            SkipEmpty();
+        }
+
+        /// Move to the next full slot, or to the end, which is null.
+        void SkipEmpty() noexcept {
+            while (ctrl != end and not IsFull(*ctrl)) {
+                ++ctrl;
+                ++slot;
+            }
+            if (ctrl == end)
+                ctrl = end = nullptr;
+        }
+
+        FlatCtrl const *ctrl{nullptr};
+        pointer slot{nullptr};
+        FlatCtrl const *end{nullptr};
+    };
+
+    static constexpr bool IsFull(FlatCtrl value) noexcept { return value >= 0; }
+
+    static constexpr size_type CtrlBytes(size_type capacity) noexcept {
+        return std::max(capacity, FlatGroup::width);
+    }
+
+    /// The number of the elements before growing, which leaves a slot empty.
+    static constexpr size_type MaxLoad(size_type capacity) noexcept {
+        return capacity < FlatGroup::width ? capacity - 1 : capacity - capacity / 8;
+    }
+
+    static constexpr std::size_t alignment = std::max(FlatGroup::width, alignof(value_type));
+
+    static constexpr size_type SlotOffset(size_type capacity) noexcept {
+        return (CtrlBytes(capacity) + alignof(value_type) - 1) / alignof(value_type) *
+               alignof(value_type);
+    }
+
+    /// Allocate the control bytes and the slots of `capacity`, which are all empty.
+    void Allocate(size_type capacity) {
+        auto *bytes = static_cast<std::byte *>(::operator new(
+            SlotOffset(capacity) + capacity * sizeof(value_type), std::align_val_t{alignment}
+        ));
+        ctrl = reinterpret_cast<FlatCtrl *>(bytes);
+        slots = reinterpret_cast<value_type *>(bytes + SlotOffset(capacity));
+        capacity_ = capacity;
+        ResetCtrl();
+        growthLeft = MaxLoad(capacity);
+    }
+
+    void Deallocate() noexcept {
+        if (ctrl)
+            ::operator delete(ctrl, std::align_val_t{alignment});
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity_ = 0;
+    }
+
+    void ResetCtrl() noexcept {
+        std::memset(ctrl, static_cast<uint8>(flatEmpty), capacity_);
+        std::memset(
+            ctrl + capacity_, static_cast<uint8>(flatPadding), CtrlBytes(capacity_) - capacity_
+        );
+    }
+
+    void DestroySlots() noexcept {
+        if constexpr (not std::is_trivially_destructible_v<value_type>)
+            for (size_type i = 0; i < capacity_; ++i)
+                if (IsFull(ctrl[i]))
+                    slots[i].~value_type();
+    }
+
+    [[nodiscard]] size_type NumGroups() const noexcept {
+        return std::max<size_type>(capacity_ / FlatGroup::width, 1);
+    }
+
+    [[nodiscard]] static FlatCtrl H2(std::size_t h) noexcept {
+        return static_cast<FlatCtrl>(h & 0x7f);
+    }
+
+    [[nodiscard]] size_type FindIndex(key_type const &key) const {
+        return size_ == 0 ? npos : FindIndex(key, hash(key));
+    }
+
+    [[nodiscard]] size_type FindIndex(key_type const &key, std::size_t h) const {
+        if (capacity_ == 0)
+            return npos;
+        auto const mask = NumGroups() - 1;
+        auto const h2 = H2(h);
+        for (size_type group = (h >> 7) & mask, step = 1;; group = (group + step++) & mask) {
+            auto const base = group * FlatGroup::width;
+            FlatGroup const bytes(ctrl + base);
+            for (auto match = bytes.Match(h2); match != 0; match &= match - 1) {
+                auto const index = base + static_cast<size_type>(std::countr_zero(match));
+                if (KIRA_LIKELY(eq(Policy::GetKey(slots[index]), key)))
+                    return index;
+            }
+            if (bytes.MatchEmpty() != 0)
+                return npos;
+        }
+    }
+
+    /// The first slot of the probe sequence of `h` which is empty or deleted.
+    [[nodiscard]] size_type FindInsertSlot(std::size_t h) const noexcept {
+        auto const mask = NumGroups() - 1;
+        for (size_type group = (h >> 7) & mask, step = 1;; group = (group + step++) & mask) {
+            auto const base = group * FlatGroup::width;
+            if (auto const match = FlatGroup(ctrl + base).MatchEmptyOrDeleted(); match != 0)
+                return base + static_cast<size_type>(std::countr_zero(match));
+        }
+    }
+
+    /// The slot to construct the element of `h` in, or `npos` if there is no room.
+    [[nodiscard]] size_type PrepareInsert(std::size_t h) const noexcept {
+        if (capacity_ == 0)
+            return npos;
+        auto const index = FindInsertSlot(h);
+        if (growthLeft == 0 and ctrl[index] != flatDeleted)
+            return npos;
+        return index;
+    }
+
+    /// Make room for the element of `h`, and return its slot.
+    size_type Grow(std::size_t h) {
+        // Rehashed in place if mostly deleted.
+        if (capacity_ == 0)
+            Resize(minCapacity);
+        else
+            Resize(size_ < MaxLoad(capacity_) / 2 ? capacity_ : capacity_ * 2);
+        return FindInsertSlot(h);
+    }
+
+    void CommitInsert(size_type index, std::size_t h) noexcept {
+        if (ctrl[index] == flatEmpty)
+            --growthLeft;
+        ctrl[index] = H2(h);
+        ++size_;
+    }
+
+    void EraseAt(size_type index) noexcept {
+        slots[index].~value_type();
+        --size_;
+
+        // No probe sequence has passed a group with an empty slot, thus it stays empty.
+        auto const base = index / FlatGroup::width * FlatGroup::width;
+        if (FlatGroup(ctrl + base).MatchEmpty() != 0) {
+            ctrl[index] = flatEmpty;
+            ++growthLeft;
+        } else {
+            ctrl[index] = flatDeleted;
+        }
+    }
+
+    void Resize(size_type newCapacity) {
+        auto *const oldCtrl = ctrl;
+        auto *const oldSlots = slots;
+        auto const oldCapacity = capacity_;
+
+        Allocate(newCapacity);
+        for (size_type i = 0; i < oldCapacity; ++i) {
+            if (not IsFull(oldCtrl[i]))
+                continue;
+            auto const h = hash(Policy::GetKey(oldSlots[i]));
+            auto const index = FindInsertSlot(h);
+            new (slots + index) value_type(std::move(oldSlots[i]));
+            oldSlots[i].~value_type();
+            ctrl[index] = H2(h);
+        }
+        growthLeft = MaxLoad(newCapacity) - size_;
+        if (oldCtrl)
+            ::operator delete(oldCtrl, std::align_val_t{alignment});
+    }
+
+    FlatCtrl *ctrl{nullptr};
+    value_type *slots{nullptr};
+    size_type capacity_{0};
+    size_type size_{0};
+    size_type growthLeft{0};
+    KIRA_NO_UNIQUE_ADDRESS Hasher hash;
+    KIRA_NO_UNIQUE_ADDRESS KeyEqual eq;
+};
+} // namespace detail
+
+/// The hash map of the Swiss tables, mostly a drop-in replacement for `std::unordered_map`.
+///
+/// \remark The insertions invalidate the references and the iterators, see above.
+template <typename K, typename V, typename Hasher = Hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashMap : public detail::FlatHashTable<detail::FlatMapPolicy<K, V>, Hasher, KeyEqual> {
+    using Base = detail::FlatHashTable<detail::FlatMapPolicy<K, V>, Hasher, KeyEqual>;
+
+public:
+    using mapped_type = V;
+    using typename Base::iterator;
+    using typename Base::key_type;
+
+    using Base::Base;
+    using Base::operator=;
+
+    FlatHashMap() noexcept = default;
+
+    /// Construct the value of `key` of `args`, if `key` is not there.
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K const &key, Args &&...args) {
+        return this->EmplaceByKey(
+            key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+        return this->EmplaceByKey(
+            key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+    }
+
+    template <typename M> std::pair<iterator, bool> insert_or_assign(K const &key, M &&value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (not result.second)
+            result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    V &operator[](K const &key) { return try_emplace(key).first->second; }
+    V &operator[](K &&key) { return try_emplace(std::move(key)).first->second; }
+
+    /// \throw std::out_of_range If `key` is not there.
+    [[nodiscard]] V &at(K const &key) {
+        auto const it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("FlatHashMap::at: The key is not found");
+        return it->second;
+    }
+
+    /// \throw std::out_of_range If `key` is not there.
+    [[nodiscard]] V const &at(K const &key) const {
+        auto const it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("FlatHashMap::at: The key is not found");
+        return it->second;
+    }
+};
+
+/// The hash set of the Swiss tables, mostly a drop-in replacement for `std::unordered_set`.
+///
+/// \remark The insertions invalidate the iterators, see above.
+template <typename K, typename Hasher = Hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashSet : public detail::FlatHashTable<detail::FlatSetPolicy<K>, Hasher, KeyEqual> {
+    using Base = detail::FlatHashTable<detail::FlatSetPolicy<K>, Hasher, KeyEqual>;
+
+public:
+    using Base::Base;
+    using Base::operator=;
+
+    FlatHashSet() noexcept = default;
+};
+} // namespace kira
@@ -5,12 +5,36 @@
 #include <optional>
 
 #include "kira/Compiler.h"
+#include "kira/detail/LogRecord.h"
 #include "kira/detail/Logger.h"
 
+//! NOTE(krr): The levels below `KIRA_LOG_COMPILE_LEVEL` (one of `SPDLOG_LEVEL_*`, set by the CMake
+//! option `KRR_LOG_COMPILE_LEVEL`) are removed at compile time: their `Log.*` are empty inline
+//! functions, whose arguments are dropped by the optimizer as long as they have no side effect.
+//! The arguments which have one, or are too costly to be left to the optimizer, are guarded by
+//! \code{.cpp}
+//! if constexpr (LogTrace.enabled)
+//!     LogTrace("Loaded {:d} bones", CountBones(mesh));
+//! \endcode
+//! The levels above are still filtered at runtime, by `KRR_LOG_LEVEL` or the builder.
+#ifndef KIRA_LOG_COMPILE_LEVEL
+#define KIRA_LOG_COMPILE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
 namespace kira {
 /// The logger name by default.
 constexpr detail::StringLiteral defaultLoggerName = "kira";
 
+/// The lowest level compiled in, see `KIRA_LOG_COMPILE_LEVEL`.
+constexpr auto logCompileLevel = static_cast<spdlog::level::level_enum>(KIRA_LOG_COMPILE_LEVEL);
+
+/// What an asynchronous logger does when its queue is full.
+enum class LogOverflowPolicy : uint8 {
+    Block,      ///< Wait for the background thread to write a record.
+    DropOldest, ///< Drop the oldest record in the queue.
+    DropNewest, ///< Drop the record being logged.
+};
+
 /// The builder to create a logger.
 class LoggerBuilder {
 public:
@@ -35,6 +59,32 @@ public:
         return *this;
     }
 
+    /// Write the records on a background thread, through a queue of `queueSize` records.
+    ///
+    /// \remark \c LogFlush waits until the records queued before are written.
+    [[nodiscard]] LoggerBuilder &async(
+        std::size_t inQueueSize = defaultQueueSize,
+        LogOverflowPolicy overflow = LogOverflowPolicy::Block
+    ) noexcept {
+        this->queueSize = inQueueSize;
+        this->overflowPolicy = overflow;
+        return *this;
+    }
+
+    /// Defer the formatting of the calls whose arguments are all arithmetic to the background
+    /// thread, see \c detail::LogRecord. Implies \c async() if not set.
+    [[nodiscard]] LoggerBuilder &deferred(bool inDeferred = true) noexcept {
+        this->deferFormatting = inDeferred;
+        return *this;
+    }
+
+    /// Write the records into a binary file, which is decoded by `kira.Core.LogDecode` (see
+    /// `KRR_BUILD_TOOLS`). Implies \c async() if not set.
+    [[nodiscard]] LoggerBuilder &to_binary_file(std::filesystem::path const &inPath) noexcept {
+        this->binaryPath = inPath;
+        return *this;
+    }
+
     /// Initializes the logger with the previously specified configuration.
     std::shared_ptr<spdlog::logger> init() const;
 
@@ -43,6 +93,12 @@ private:
     bool console{true};
     std::optional<std::filesystem::path> path;
     std::optional<spdlog::level::level_enum> level;
+    std::size_t queueSize{0}; ///< Synchronous if zero.
+    LogOverflowPolicy overflowPolicy{LogOverflowPolicy::Block};
+    bool deferFormatting{false};
+    std::optional<std::filesystem::path> binaryPath;
+
+    static constexpr std::size_t defaultQueueSize = 8192;
 };
 
 /// \brief Get or create a thread-safe logger.
@@ -55,13 +111,7 @@ private:
 /// \return A pointer to the spdlog logger.
 /// \throw std::runtime_error If logger initialization fails.
 [[nodiscard]] inline spdlog::logger *GetLogger(std::string const &name) {
-    static std::mutex mutex;
-
-    std::lock_guard guard(mutex);
-    auto logger = spdlog::get(name);
-    if (KIRA_UNLIKELY(not logger))
-        logger = LoggerBuilder{name}.init();
-    return logger.get();
+    return detail::ResolveLogger(name, nullptr);
 }
 
 //! NOTE(krr): compile-time format check is not yet achieved. Turning into macros? No, you'll lose
@@ -76,16 +126,43 @@ private:
 //! is to use https://stackoverflow.com/a/78540292 (through `reinterpret_cast` and inheritance to
 //! `std::string_view`), but this results in a segfault in our codebase.
 
-template <detail::StringLiteral name, spdlog::level::level_enum lvl>
+template <
+    detail::StringLiteral name, spdlog::level::level_enum lvl,
+    spdlog::level::level_enum floor = logCompileLevel>
 struct LoggerCustomizationPoint {
+    /// Whether the level is compiled in.
+    static constexpr bool enabled = lvl >= floor;
+
     template <fmt::formattable<char>... Args>
-    void operator()(detail::FormatWithSourceLoc fmt, Args &&...args) {
-        GetLogger(name.value)
-            ->log(
-                detail::get_spdlog_source_loc(fmt.loc), lvl, fmt::runtime(fmt.fmt),
-                std::forward<Args>(args)...
-            );
+    void operator()(detail::FormatWithSourceLoc fmt, Args &&...args)
+        requires(enabled)
+    {
+        // The level is checked before anything else, s.t. a filtered call costs two loads: the slot
+        // (acquire), then the level of the logger (relaxed, in `should_log`). The level is not
+        // cached in the slot, since `spdlog::logger::set_level`, which is not virtual, and
+        // `spdlog::set_level` change it behind the slot, thus a cached copy would be stale.
+        auto *logger = detail::GetCachedLogger<name>();
+        if (not logger->should_log(lvl))
+            return;
+        if constexpr (detail::is_deferrable_log_call<Args...>) {
+            auto *sink = detail::loggerSlot<name>.deferred.load(std::memory_order_relaxed);
+            if (sink and fmt.literal) {
+                auto const record = detail::MakeLogRecord(logger->name(), fmt, lvl, args...);
+                detail::LogDeferred(*sink, record);
+                return;
+            }
+        }
+        logger->log(
+            detail::get_spdlog_source_loc(fmt.loc), lvl, fmt::runtime(fmt.fmt),
+            std::forward<Args>(args)...
+        );
     }
+
+    template <fmt::formattable<char>... Args>
+    KIRA_FORCEINLINE constexpr void
+    operator()(detail::FormatWithSourceLoc, Args &&...) const noexcept
+        requires(not enabled)
+    {}
 };
 
 //! We follow a design like CPO, because other submodules might want to change the \c
@@ -115,6 +192,6 @@ inline LoggerCustomizationPoint<defaultLoggerName, spdlog::level::level_enum::er
 
 /// Flush the logger.
 template <detail::StringLiteral name = defaultLoggerName> void LogFlush() {
-    GetLogger(name.value)->flush();
+    detail::GetCachedLogger<name>()->flush();
 }
 } // namespace kira
@@ -7,4 +7,8 @@ namespace kira {
 #define KIRA_DISALLOW_COPY_AND_ASSIGN(TypeName)                                                    \
     TypeName(const TypeName &) = delete;                                                           \
     TypeName &operator=(const TypeName &) = delete;
+
+/// \brief Concatenate the tokens after expanding them, e.g., to name a variable by `__LINE__`.
+#define KIRA_CONCAT_IMPL(a, b) a##b
+#define KIRA_CONCAT(a, b)      KIRA_CONCAT_IMPL(a, b)
 } // namespace kira
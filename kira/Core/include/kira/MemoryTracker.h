@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#include "kira/Macros.h"
+#include "kira/Types.h"
+
+#ifndef KIRA_ENABLE_MEMORY_TRACKER
+#define KIRA_ENABLE_MEMORY_TRACKER 0
+#endif
+
+namespace kira {
+//! NOTE(krr): The memory tracker replaces the global `operator new` and `operator delete`, and
+//! the allocations of `SmallVector`, s.t. each allocation is attributed to the memory category of
+//! the thread which allocates it, see `KIRA_MEMORY_SCOPE("name")`. The size and the category are
+//! kept in front of each allocation, s.t. the frees are attributed to the category allocating,
+//! even on another thread.
+//!
+//! The numbers of the allocations are counted by each thread, and summed when reported, while
+//! the live bytes of a category, thus its peak, are shared by the threads.
+//!
+//! It is only there if `KRR_ENABLE_MEMORY_TRACKER` is set in CMake, where the categories and the
+//! reports are there regardless, but nothing is counted.
+
+/// Whether the allocations are tracked.
+constexpr bool memoryTrackerEnabled = KIRA_ENABLE_MEMORY_TRACKER != 0;
+
+namespace detail {
+[[nodiscard]] uint32 RegisterMemoryCategory(std::string_view name);
+uint32 SetMemoryCategory(uint32 category) noexcept;
+
+#if KIRA_ENABLE_MEMORY_TRACKER
+/// The allocation functions of `SmallVector`, which must be freed by `TrackedFree()`.
+[[nodiscard]] void *TrackedMalloc(std::size_t size) noexcept;
+[[nodiscard]] void *TrackedRealloc(void *ptr, std::size_t size) noexcept;
+void TrackedFree(void *ptr) noexcept;
+#else
+[[nodiscard]] inline void *TrackedMalloc(std::size_t size) noexcept { return std::malloc(size); }
+[[nodiscard]] inline void *TrackedRealloc(void *ptr, std::size_t size) noexcept {
+    return std::realloc(ptr, size);
+}
+inline void TrackedFree(void *ptr) noexcept { std::free(ptr); }
+#endif
+} // namespace detail
+
+/// The category of the allocations, by name.
+///
+/// \remark The categories of the same name are the same. The categories past the 63rd are
+/// counted as "other".
+class MemoryCategory {
+public:
+    explicit MemoryCategory(std::string_view name) : id(detail::RegisterMemoryCategory(name)) {}
+
+    [[nodiscard]] uint32 GetId() const noexcept { return id; }
+
+private:
+    uint32 id;
+};
+
+/// Attribute the allocations of the calling thread to `category`, until the destruction.
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryCategory const &category) noexcept
+        : previous(detail::SetMemoryCategory(category.GetId())) {}
+
+    ~MemoryScope() noexcept { detail::SetMemoryCategory(previous); }
+
+    KIRA_DISALLOW_COPY_AND_ASSIGN(MemoryScope)
+
+private:
+    uint32 previous;
+};
+
+/// The allocations of a category.
+struct MemoryCategoryStats {
+    std::string_view name;
+    int64 liveBytes{0};
+    int64 peakBytes{0};
+    uint64 allocations{0}, deallocations{0};
+    uint64 allocatedBytes{0};
+
+    /// The allocations of the last frame, see \c MarkMemoryFrame().
+    uint64 frameAllocations{0};
+    uint64 frameAllocatedBytes{0};
+    int64 framePeakBytes{0};
+};
+
+/// The allocations of the categories so far, the first of which is "other".
+[[nodiscard]] std::vector<MemoryCategoryStats> GetMemoryStats();
+
+/// End the frame, whose allocations are then reported, see \c MemoryCategoryStats.
+void MarkMemoryFrame();
+
+/// Log the allocations of the categories, see \c GetMemoryStats().
+void LogMemoryStats();
+} // namespace kira
+
+#if KIRA_ENABLE_MEMORY_TRACKER
+/// Attribute the allocations to the category of `name` until the end of the enclosing scope.
+#define KIRA_MEMORY_SCOPE(name)                                                                    \
+    static ::kira::MemoryCategory const KIRA_CONCAT(kiraMemoryCategory, __LINE__){name};           \
+    ::kira::MemoryScope const KIRA_CONCAT(kiraMemoryScope, __LINE__) {                             \
+        KIRA_CONCAT(kiraMemoryCategory, __LINE__)                                                  \
+    }
+#else
+/// Attribute the allocations to the category of `name` until the end of the enclosing scope.
+#define KIRA_MEMORY_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "kira/Compiler.h"
+#include "kira/Macros.h"
+#include "kira/Types.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+
+#ifndef KIRA_ENABLE_PROFILER
+#define KIRA_ENABLE_PROFILER 0
+#endif
+
+namespace kira {
+//! NOTE(krr): The profiler records the zones opened by `KIRA_PROFILE_SCOPE("name")`, each into the
+//! buffer of the thread which opens it: a zone costs two reads of the clock and an append to the
+//! buffer, which is only written by its thread and only read by the exports, thus no lock is taken
+//! but when a thread records its first zone. The zones nest, and the time spent in the zones nested
+//! into one is subtracted from its self time.
+//!
+//! The clock is the TSC on x86-64, which is converted into the wall time when exported, and
+//! `std::chrono::steady_clock` elsewhere.
+//!
+//! The hardware counters (see `ProfileCounter`) are read as well at the start and the end of the
+//! zones once `EnableProfileCounters()` is called, through `perf_event_open` on Linux, which counts
+//! the user space of the thread which opens the zone. They are not there elsewhere, nor if perf is
+//! not permitted (see `/proc/sys/kernel/perf_event_paranoid`), e.g., in containers, or the PMU is
+//! not exposed, e.g., in virtual machines: the zones are recorded without them then. Reading them
+//! is a system call, s.t. the zones of less than a few microseconds are distorted.
+//!
+//! The zones are removed unless `KRR_ENABLE_PROFILER` is set in CMake, while `ProfileScope` and the
+//! exports are always there.
+
+/// Whether `KIRA_PROFILE_SCOPE` records the zones.
+constexpr bool profilerEnabled = KIRA_ENABLE_PROFILER != 0;
+
+namespace detail {
+/// Read the clock of the profiler, in the ticks of the TSC or in nanoseconds.
+[[nodiscard]] KIRA_FORCEINLINE uint64 ReadProfileClock() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch()
+    )
+                                   .count());
+#endif
+}
+} // namespace detail
+
+/// The hardware counters read by the zones.
+enum class ProfileCounter : uint8 { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses };
+
+constexpr std::size_t numProfileCounters = 5;
+
+/// The zone recorded from the construction to the destruction.
+///
+/// \remark The name is only referred to, thus must be a string literal.
+class ProfileScope {
+public:
+    template <std::size_t N>
+    explicit ProfileScope(char const (&inName)[N]) noexcept : name(inName) {
+        Enter();
+        begin = detail::ReadProfileClock();
+    }
+
+    ~ProfileScope() noexcept { Leave(detail::ReadProfileClock()); }
+
+    KIRA_DISALLOW_COPY_AND_ASSIGN(ProfileScope)
+
+private:
+    void Enter() noexcept;
+    void Leave(uint64 end) noexcept;
+
+    char const *name;
+    ProfileScope *parent{nullptr};
+    uint64 begin{0};
+    uint64 children{0};
+    bool counted{false};
+    std::array<uint64, numProfileCounters> counters;
+};
+
+/// The zones of the same name, over all the threads.
+struct ProfileZoneSummary {
+    std::string_view name;
+    uint64 count{0};
+    double totalMs{0}, selfMs{0}, minMs{0}, maxMs{0};
+
+    /// The hardware counters, summed over the zones which read them.
+    std::array<uint64, numProfileCounters> counters{};
+
+    /// The hardware counters read by any of the zones, by the bits of `ProfileCounter`.
+    uint8 counterMask{0};
+
+    [[nodiscard]] bool HasCounter(ProfileCounter counter) const noexcept {
+        return (counterMask >> static_cast<uint8>(counter) & 1) != 0;
+    }
+
+    [[nodiscard]] uint64 GetCounter(ProfileCounter counter) const noexcept {
+        return counters[static_cast<uint8>(counter)];
+    }
+
+    /// The instructions per cycle, or NaN if the counters are not read.
+    [[nodiscard]] double GetIpc() const noexcept {
+        return Ratio(ProfileCounter::Instructions, ProfileCounter::Cycles, 1);
+    }
+
+    /// The misses of `counter` per thousand instructions, or NaN if the counters are not read.
+    [[nodiscard]] double GetMpki(ProfileCounter counter) const noexcept {
+        return Ratio(counter, ProfileCounter::Instructions, 1000);
+    }
+
+private:
+    [[nodiscard]] double
+    Ratio(ProfileCounter num, ProfileCounter den, double scale) const noexcept {
+        if (not HasCounter(num) or not HasCounter(den) or GetCounter(den) == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+        return scale * static_cast<double>(GetCounter(num)) / static_cast<double>(GetCounter(den));
+    }
+};
+
+/// Aggregate the zones recorded so far, by name, sorted by the total time.
+[[nodiscard]] std::vector<ProfileZoneSummary> GetProfileSummary();
+
+/// Log the aggregate of the zones recorded so far, see \c GetProfileSummary().
+void LogProfileSummary();
+
+/// Write the zones recorded so far into `path`, in the JSON trace format of Chrome, which
+/// `chrome://tracing` and Perfetto open.
+///
+/// \throw std::runtime_error If the file cannot be written.
+void WriteChromeTrace(std::filesystem::path const &path);
+
+/// Read the hardware counters in the zones recorded from now on, or stop reading them.
+///
+/// \return Whether the counters are read from now on, where the reason is logged if they cannot be.
+bool EnableProfileCounters(bool enable = true);
+
+/// The number of the zones not recorded, since the buffer of their thread is full.
+[[nodiscard]] std::size_t GetProfileDropped() noexcept;
+
+/// Discard the zones recorded so far.
+///
+/// \warning No other thread may record a zone meanwhile.
+void ClearProfile();
+} // namespace kira
+
+#if KIRA_ENABLE_PROFILER
+/// Record a zone named by the string literal `name` until the end of the enclosing scope.
+#define KIRA_PROFILE_SCOPE(name)                                                                   \
+    ::kira::ProfileScope const KIRA_CONCAT(kiraProfileScope, __LINE__) { name }
+#else
+/// Record a zone named by the string literal `name` until the end of the enclosing scope.
+#define KIRA_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
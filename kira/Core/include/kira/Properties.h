@@ -15,10 +15,10 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
-#include <unordered_set>
 #include <utility>
 
 #include "kira/Anyhow.h"
+#include "kira/FlatHashMap.h"
 #include "kira/SmallVector.h"
 
 namespace kira {
@@ -33,11 +33,11 @@ struct PropertiesRoot {
     toml::table table;
     toml::array array;
     SmallVector<std::string> sourceLines;
-    std::unordered_set<toml::node const *> usedNodes;
+    FlatHashSet<toml::node const *> usedNodes;
 };
 
 void erase_used_nodes(
-    std::unordered_set<toml::node const *> &usedNodes, toml::node const &node
+    FlatHashSet<toml::node const *> &usedNodes, toml::node const &node
 ) noexcept;
 } // namespace detail
 
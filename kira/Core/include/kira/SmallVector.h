@@ -15,6 +15,8 @@
 // the following modifications:
 // - LLVM_GSL_OWNER -> KIRA_GSL_OWNER
 // - add [[nodiscard]] to suppress warnings
+// - free -> detail::TrackedFree, see kira/MemoryTracker.h
+// - add the Allocator parameter, see SmallVectorAllocatorBase
 // NOLINTBEGIN
 
 #pragma once
@@ -30,10 +32,12 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 
 #include "kira/Compiler.h"
+#include "kira/MemoryTracker.h"
 
 #if _MSC_VER
 #pragma warning(push)
@@ -78,6 +82,10 @@ protected:
     /// This function will report a fatal error if it cannot increase capacity.
     void grow_pod(void *FirstEl, size_t MinSize, size_t TSize);
 
+    /// The capacity \a grow_pod() grows to for at least \p MinSize elements,
+    /// for the allocators other than malloc.
+    size_t getGrownCapacity(size_t MinSize) const;
+
     /// If vector was first created with capacity 0, getFirstEl() points to the
     /// memory right after, an area unallocated. If a subsequent allocation,
     /// that grows the vector, happens to return the same pointer as getFirstEl(),
@@ -121,34 +129,132 @@ template <class T>
 using SmallVectorSizeType =
     std::conditional_t<sizeof(T) < 4 && sizeof(void *) >= 8, uint64_t, uint32_t>;
 
+/// Whether the allocators of the type are interchangeable, s.t. one is
+/// constructed when needed instead of kept in the vector, e.g., std::allocator.
+template <class Allocator>
+inline constexpr bool IsStatelessAllocator =
+    std::allocator_traits<Allocator>::is_always_equal::value &&
+    std::is_default_constructible<Allocator>::value;
+
+/// The allocator kept by a SmallVector, ahead of SmallVectorBase, s.t. no
+/// member lies between the latter and the inline elements.
+template <class Allocator> struct SmallVectorAllocatorHolder {
+    Allocator Alloc;
+};
+
+/// SmallVectorBase with the allocator of the heap buffer, which takes no space
+/// if stateless.
+///
+/// The buffer of std::allocator is malloc'd, as the upstream one, s.t. the
+/// trivially copyable elements are realloc'd, see \a grow_pod(). The others
+/// allocate a new buffer as std::vector, and are never propagated by the
+/// assignments and the swaps, as std::pmr::polymorphic_allocator, whose
+/// buffers are only taken over from the vectors of an equal allocator.
+template <class Size_T, class Allocator, bool = IsStatelessAllocator<Allocator>>
+class SmallVectorAllocatorBase : public SmallVectorBase<Size_T> {
+protected:
+    SmallVectorAllocatorBase(Allocator const &, void *FirstEl, size_t TotalCapacity)
+        : SmallVectorBase<Size_T>(FirstEl, TotalCapacity) {}
+
+public:
+    [[nodiscard]] Allocator get_allocator() const { return Allocator(); }
+};
+
+template <class Size_T, class Allocator>
+class SmallVectorAllocatorBase<Size_T, Allocator, false>
+    : SmallVectorAllocatorHolder<Allocator>,
+      public SmallVectorBase<Size_T> {
+protected:
+    SmallVectorAllocatorBase(Allocator const &InAlloc, void *FirstEl, size_t TotalCapacity)
+        : SmallVectorAllocatorHolder<Allocator>{InAlloc},
+          SmallVectorBase<Size_T>(FirstEl, TotalCapacity) {}
+
+public:
+    [[nodiscard]] Allocator get_allocator() const { return this->Alloc; }
+};
+
 /// Figure out the offset of the first element.
-template <class T, typename = void> struct SmallVectorAlignmentAndSize {
-    alignas(SmallVectorBase<
-            SmallVectorSizeType<T>>) char Base[sizeof(SmallVectorBase<SmallVectorSizeType<T>>)];
+template <class T, class Allocator> struct SmallVectorAlignmentAndSize {
+    using Header = SmallVectorAllocatorBase<SmallVectorSizeType<T>, Allocator>;
+    alignas(Header) char Base[sizeof(Header)];
     alignas(T) char FirstEl[sizeof(T)];
 };
 
 /// This is the part of SmallVectorTemplateBase which does not depend on whether
 /// the type T is a POD. The extra dummy template argument is used by ArrayRef
 /// to avoid unnecessarily requiring T to be complete.
-template <typename T, typename = void>
-class SmallVectorTemplateCommon : public SmallVectorBase<SmallVectorSizeType<T>> {
+template <typename T, typename Allocator = std::allocator<T>, typename = void>
+class SmallVectorTemplateCommon
+    : public SmallVectorAllocatorBase<SmallVectorSizeType<T>, Allocator> {
     using Base = SmallVectorBase<SmallVectorSizeType<T>>;
+    using Header = SmallVectorAllocatorBase<SmallVectorSizeType<T>, Allocator>;
 
 protected:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    /// Whether the heap buffer is malloc'd, see SmallVectorAllocatorBase.
+    static constexpr bool UsesMalloc = std::is_same<Allocator, std::allocator<T>>::value;
+
     /// Find the address of the first element.  For this pointer math to be valid
     /// with small-size of 0 for T with lots of alignment, it's important that
     /// SmallVectorStorage is properly-aligned even for small-size of 0.
     [[nodiscard]] void *getFirstEl() const {
+        using Layout = SmallVectorAlignmentAndSize<T, Allocator>;
         return const_cast<void *>(reinterpret_cast<void const *>(
-            reinterpret_cast<char const *>(this) + offsetof(SmallVectorAlignmentAndSize<T>, FirstEl)
+            reinterpret_cast<char const *>(this) + offsetof(Layout, FirstEl)
         ));
     }
     // Space after 'FirstEl' is clobbered, do not add any instance vars after it.
 
-    SmallVectorTemplateCommon(size_t Size) : Base(getFirstEl(), Size) {}
+    SmallVectorTemplateCommon(size_t Size, Allocator const &Alloc)
+        : Header(Alloc, getFirstEl(), Size) {}
 
-    void grow_pod(size_t MinSize, size_t TSize) { Base::grow_pod(getFirstEl(), MinSize, TSize); }
+    void grow_pod(size_t MinSize, size_t TSize) {
+        if constexpr (UsesMalloc) {
+            Base::grow_pod(getFirstEl(), MinSize, TSize);
+        } else {
+            size_t NewCapacity;
+            T *NewElts = allocateForGrow(MinSize, NewCapacity);
+
+            // Copy the elements over.  No need to run dtors on PODs.
+            if (this->size())
+                memcpy(NewElts, this->BeginX, this->size() * TSize);
+            freeAllocation();
+            this->set_allocation_range(NewElts, NewCapacity);
+        }
+    }
+
+    /// Allocate the buffer for \a grow() of the allocator, which is not malloc.
+    T *allocateForGrow(size_t MinSize, size_t &NewCapacity) {
+        NewCapacity = this->getGrownCapacity(MinSize);
+        Allocator Alloc = this->get_allocator();
+        T *NewElts = AllocTraits::allocate(Alloc, NewCapacity);
+        // See replaceAllocation(), which an arena hits if the vector of
+        // capacity 0 is allocated right before.
+        if (NewElts == getFirstEl()) {
+            T *Replacement = AllocTraits::allocate(Alloc, NewCapacity);
+            AllocTraits::deallocate(Alloc, NewElts, NewCapacity);
+            NewElts = Replacement;
+        }
+        return NewElts;
+    }
+
+    /// Free the heap buffer, if any.
+    void freeAllocation() {
+        if (isSmall())
+            return;
+        if constexpr (UsesMalloc) {
+            detail::TrackedFree(this->BeginX);
+        } else {
+            Allocator Alloc = this->get_allocator();
+            AllocTraits::deallocate(Alloc, static_cast<T *>(this->BeginX), this->capacity());
+        }
+    }
+
+    /// Return true if the heap buffer of \p RHS may be freed by this vector.
+    bool canStealAllocation(SmallVectorTemplateCommon const &RHS) const {
+        return this->get_allocator() == RHS.get_allocator();
+    }
 
     /// Return true if this is a smallvector which has not had dynamic
     /// memory allocated for it.
@@ -337,17 +443,19 @@ public:
 /// This catches the important case of std::pair<POD, POD>, which is not
 /// trivially assignable.
 template <
-    typename T, bool = (std::is_trivially_copy_constructible<T>::value) &&
-                       (std::is_trivially_move_constructible<T>::value) &&
-                       std::is_trivially_destructible<T>::value>
-class SmallVectorTemplateBase : public SmallVectorTemplateCommon<T> {
-    friend class SmallVectorTemplateCommon<T>;
+    typename T, typename Allocator,
+    bool = (std::is_trivially_copy_constructible<T>::value) &&
+           (std::is_trivially_move_constructible<T>::value) &&
+           std::is_trivially_destructible<T>::value>
+class SmallVectorTemplateBase : public SmallVectorTemplateCommon<T, Allocator> {
+    friend class SmallVectorTemplateCommon<T, Allocator>;
 
 protected:
     static constexpr bool TakesParamByValue = false;
     using ValueParamT = T const &;
 
-    SmallVectorTemplateBase(size_t Size) : SmallVectorTemplateCommon<T>(Size) {}
+    SmallVectorTemplateBase(size_t Size, Allocator const &Alloc)
+        : SmallVectorTemplateCommon<T, Allocator>(Size, Alloc) {}
 
     static void destroy_range(T *S, T *E) {
         while (S != E) {
@@ -440,26 +548,29 @@ public:
 };
 
 // Define this out-of-line to dissuade the C++ compiler from inlining it.
-template <typename T, bool TriviallyCopyable>
-void SmallVectorTemplateBase<T, TriviallyCopyable>::grow(size_t MinSize) {
+template <typename T, typename Allocator, bool TriviallyCopyable>
+void SmallVectorTemplateBase<T, Allocator, TriviallyCopyable>::grow(size_t MinSize) {
     size_t NewCapacity;
     T *NewElts = mallocForGrow(MinSize, NewCapacity);
     moveElementsForGrow(NewElts);
     takeAllocationForGrow(NewElts, NewCapacity);
 }
 
-template <typename T, bool TriviallyCopyable>
-T *SmallVectorTemplateBase<T, TriviallyCopyable>::mallocForGrow(
+template <typename T, typename Allocator, bool TriviallyCopyable>
+T *SmallVectorTemplateBase<T, Allocator, TriviallyCopyable>::mallocForGrow(
     size_t MinSize, size_t &NewCapacity
 ) {
-    return static_cast<T *>(SmallVectorBase<SmallVectorSizeType<T>>::mallocForGrow(
-        this->getFirstEl(), MinSize, sizeof(T), NewCapacity
-    ));
+    if constexpr (!SmallVectorTemplateCommon<T, Allocator>::UsesMalloc)
+        return this->allocateForGrow(MinSize, NewCapacity);
+    else
+        return static_cast<T *>(SmallVectorBase<SmallVectorSizeType<T>>::mallocForGrow(
+            this->getFirstEl(), MinSize, sizeof(T), NewCapacity
+        ));
 }
 
 // Define this out-of-line to dissuade the C++ compiler from inlining it.
-template <typename T, bool TriviallyCopyable>
-void SmallVectorTemplateBase<T, TriviallyCopyable>::moveElementsForGrow(T *NewElts) {
+template <typename T, typename Allocator, bool TriviallyCopyable>
+void SmallVectorTemplateBase<T, Allocator, TriviallyCopyable>::moveElementsForGrow(T *NewElts) {
     // Move the elements over.
     this->uninitialized_move(this->begin(), this->end(), NewElts);
 
@@ -468,13 +579,12 @@ void SmallVectorTemplateBase<T, TriviallyCopyable>::moveElementsForGrow(T *NewEl
 }
 
 // Define this out-of-line to dissuade the C++ compiler from inlining it.
-template <typename T, bool TriviallyCopyable>
-void SmallVectorTemplateBase<T, TriviallyCopyable>::takeAllocationForGrow(
+template <typename T, typename Allocator, bool TriviallyCopyable>
+void SmallVectorTemplateBase<T, Allocator, TriviallyCopyable>::takeAllocationForGrow(
     T *NewElts, size_t NewCapacity
 ) {
     // If this wasn't grown from the inline copy, deallocate the old space.
-    if (!this->isSmall())
-        free(this->begin());
+    this->freeAllocation();
 
     this->set_allocation_range(NewElts, NewCapacity);
 }
@@ -483,8 +593,9 @@ void SmallVectorTemplateBase<T, TriviallyCopyable>::takeAllocationForGrow(
 /// method implementations that are designed to work with trivially copyable
 /// T's. This allows using memcpy in place of copy/move construction and
 /// skipping destruction.
-template <typename T> class SmallVectorTemplateBase<T, true> : public SmallVectorTemplateCommon<T> {
-    friend class SmallVectorTemplateCommon<T>;
+template <typename T, typename Allocator>
+class SmallVectorTemplateBase<T, Allocator, true> : public SmallVectorTemplateCommon<T, Allocator> {
+    friend class SmallVectorTemplateCommon<T, Allocator>;
 
 protected:
     /// True if it's cheap enough to take parameters by value. Doing so avoids
@@ -495,7 +606,8 @@ protected:
     /// parameters by value.
     using ValueParamT = std::conditional_t<TakesParamByValue, T, T const &>;
 
-    SmallVectorTemplateBase(size_t Size) : SmallVectorTemplateCommon<T>(Size) {}
+    SmallVectorTemplateBase(size_t Size, Allocator const &Alloc)
+        : SmallVectorTemplateCommon<T, Allocator>(Size, Alloc) {}
 
     // No need to do a destroy loop for POD's.
     static void destroy_range(T *, T *) {}
@@ -577,8 +689,9 @@ public:
 
 /// This class consists of common code factored out of the SmallVector class to
 /// reduce code duplication based on the SmallVector 'N' template parameter.
-template <typename T> class SmallVectorImpl : public SmallVectorTemplateBase<T> {
-    using SuperClass = SmallVectorTemplateBase<T>;
+template <typename T, typename Allocator = std::allocator<T>>
+class SmallVectorImpl : public SmallVectorTemplateBase<T, Allocator> {
+    using SuperClass = SmallVectorTemplateBase<T, Allocator>;
 
 public:
     using iterator = typename SuperClass::iterator;
@@ -587,16 +700,18 @@ public:
     using size_type = typename SuperClass::size_type;
 
 protected:
-    using SmallVectorTemplateBase<T>::TakesParamByValue;
+    using SuperClass::TakesParamByValue;
     using ValueParamT = typename SuperClass::ValueParamT;
 
     // Default ctor - Initialize to empty.
-    explicit SmallVectorImpl(unsigned N) : SmallVectorTemplateBase<T>(N) {}
+    explicit SmallVectorImpl(unsigned N, Allocator const &Alloc = Allocator())
+        : SuperClass(N, Alloc) {}
 
+    /// Take the heap buffer of \p RHS, whose allocator must be equal.
     void assignRemote(SmallVectorImpl &&RHS) {
+        assert(this->canStealAllocation(RHS));
         this->destroy_range(this->begin(), this->end());
-        if (!this->isSmall())
-            free(this->begin());
+        this->freeAllocation();
         this->BeginX = RHS.BeginX;
         this->Size = RHS.Size;
         this->Capacity = RHS.Capacity;
@@ -606,8 +721,7 @@ protected:
     ~SmallVectorImpl() {
         // Subclass has already destructed this vector's elements.
         // If this wasn't grown from the inline copy, deallocate the old space.
-        if (!this->isSmall())
-            free(this->begin());
+        this->freeAllocation();
     }
 
 public:
@@ -970,12 +1084,14 @@ public:
     bool operator>=(SmallVectorImpl const &RHS) const { return !(*this < RHS); }
 };
 
-template <typename T> void SmallVectorImpl<T>::swap(SmallVectorImpl<T> &RHS) {
+template <typename T, typename Allocator>
+void SmallVectorImpl<T, Allocator>::swap(SmallVectorImpl<T, Allocator> &RHS) {
     if (this == &RHS)
         return;
 
-    // We can only avoid copying elements if neither vector is small.
-    if (!this->isSmall() && !RHS.isSmall()) {
+    // We can only avoid copying elements if neither vector is small, and the
+    // buffers are freed by either allocator.
+    if (!this->isSmall() && !RHS.isSmall() && this->canStealAllocation(RHS)) {
         std::swap(this->BeginX, RHS.BeginX);
         std::swap(this->Size, RHS.Size);
         std::swap(this->Capacity, RHS.Capacity);
@@ -1007,8 +1123,9 @@ template <typename T> void SmallVectorImpl<T>::swap(SmallVectorImpl<T> &RHS) {
     }
 }
 
-template <typename T>
-SmallVectorImpl<T> &SmallVectorImpl<T>::operator=(SmallVectorImpl<T> const &RHS) {
+template <typename T, typename Allocator>
+SmallVectorImpl<T, Allocator> &
+SmallVectorImpl<T, Allocator>::operator=(SmallVectorImpl<T, Allocator> const &RHS) {
     // Avoid self-assignment.
     if (this == &RHS)
         return *this;
@@ -1054,13 +1171,16 @@ SmallVectorImpl<T> &SmallVectorImpl<T>::operator=(SmallVectorImpl<T> const &RHS)
     return *this;
 }
 
-template <typename T> SmallVectorImpl<T> &SmallVectorImpl<T>::operator=(SmallVectorImpl<T> &&RHS) {
+template <typename T, typename Allocator>
+SmallVectorImpl<T, Allocator> &
+SmallVectorImpl<T, Allocator>::operator=(SmallVectorImpl<T, Allocator> &&RHS) {
     // Avoid self-assignment.
     if (this == &RHS)
         return *this;
 
-    // If the RHS isn't small, clear this vector and then steal its buffer.
-    if (!RHS.isSmall()) {
+    // If the RHS isn't small, clear this vector and then steal its buffer,
+    // unless freed by another allocator.
+    if (!RHS.isSmall() && this->canStealAllocation(RHS)) {
         this->assignRemote(std::move(RHS));
         return *this;
     }
@@ -1123,7 +1243,8 @@ template <typename T> struct alignas(T) SmallVectorStorage<T, 0> {};
 /// Forward declaration of SmallVector so that
 /// calculateSmallVectorDefaultInlinedElements can reference
 /// `sizeof(SmallVector<T, 0>)`.
-template <typename T, unsigned N> class KIRA_GSL_OWNER SmallVector;
+template <typename T, unsigned N, typename Allocator = std::allocator<T>>
+class KIRA_GSL_OWNER SmallVector;
 
 /// Helper class for calculating the default number of inline elements for
 /// `SmallVector<T>`.
@@ -1193,60 +1314,86 @@ template <typename T> struct CalculateSmallVectorDefaultInlinedElements {
 /// \warning This does not attempt to be exception safe.
 ///
 /// \see https://llvm.org/docs/ProgrammersManual.html#llvm-adt-smallvector-h
-template <typename T, unsigned N = CalculateSmallVectorDefaultInlinedElements<T>::value>
-class KIRA_GSL_OWNER SmallVector : public SmallVectorImpl<T>, SmallVectorStorage<T, N> {
+template <
+    typename T, unsigned N = CalculateSmallVectorDefaultInlinedElements<T>::value,
+    typename Allocator>
+class KIRA_GSL_OWNER SmallVector : public SmallVectorImpl<T, Allocator>, SmallVectorStorage<T, N> {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
-    SmallVector() : SmallVectorImpl<T>(N) {}
+    SmallVector() : SmallVectorImpl<T, Allocator>(N) {}
+
+    explicit SmallVector(Allocator const &Alloc) : SmallVectorImpl<T, Allocator>(N, Alloc) {}
 
     ~SmallVector() {
         // Destroy the constructed elements in the vector.
         this->destroy_range(this->begin(), this->end());
     }
 
-    explicit SmallVector(size_t Size) : SmallVectorImpl<T>(N) { this->resize(Size); }
+    explicit SmallVector(size_t Size, Allocator const &Alloc = Allocator())
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
+        this->resize(Size);
+    }
 
-    SmallVector(size_t Size, T const &Value) : SmallVectorImpl<T>(N) { this->assign(Size, Value); }
+    SmallVector(size_t Size, T const &Value, Allocator const &Alloc = Allocator())
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
+        this->assign(Size, Value);
+    }
 
     template <typename ItTy, typename = EnableIfConvertibleToInputIterator<ItTy>>
-    SmallVector(ItTy S, ItTy E) : SmallVectorImpl<T>(N) {
+    SmallVector(ItTy S, ItTy E, Allocator const &Alloc = Allocator())
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
         this->append(S, E);
     }
 
     template <typename RangeTy>
-    explicit SmallVector(iterator_range<RangeTy> const &R) : SmallVectorImpl<T>(N) {
+    explicit SmallVector(iterator_range<RangeTy> const &R) : SmallVectorImpl<T, Allocator>(N) {
         this->append(R.begin(), R.end());
     }
 
-    SmallVector(std::initializer_list<T> IL) : SmallVectorImpl<T>(N) { this->append(IL); }
+    SmallVector(std::initializer_list<T> IL, Allocator const &Alloc = Allocator())
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
+        this->append(IL);
+    }
 
     template <typename U, typename = std::enable_if_t<std::is_convertible<U, T>::value>>
-    explicit SmallVector(ArrayRef<U> A) : SmallVectorImpl<T>(N) {
+    explicit SmallVector(ArrayRef<U> A) : SmallVectorImpl<T, Allocator>(N) {
         this->append(A.begin(), A.end());
     }
 
-    SmallVector(SmallVector const &RHS) : SmallVectorImpl<T>(N) {
+    SmallVector(SmallVector const &RHS)
+        : SmallVector(
+              RHS, AllocTraits::select_on_container_copy_construction(RHS.get_allocator())
+          ) {}
+
+    SmallVector(SmallVector const &RHS, Allocator const &Alloc)
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
         if (!RHS.empty())
-            SmallVectorImpl<T>::operator=(RHS);
+            SmallVectorImpl<T, Allocator>::operator=(RHS);
     }
 
     SmallVector &operator=(SmallVector const &RHS) {
-        SmallVectorImpl<T>::operator=(RHS);
+        SmallVectorImpl<T, Allocator>::operator=(RHS);
         return *this;
     }
 
-    SmallVector(SmallVector &&RHS) : SmallVectorImpl<T>(N) {
+    SmallVector(SmallVector &&RHS) : SmallVector(::std::move(RHS), RHS.get_allocator()) {}
+
+    SmallVector(SmallVector &&RHS, Allocator const &Alloc)
+        : SmallVectorImpl<T, Allocator>(N, Alloc) {
         if (!RHS.empty())
-            SmallVectorImpl<T>::operator=(::std::move(RHS));
+            SmallVectorImpl<T, Allocator>::operator=(::std::move(RHS));
     }
 
-    SmallVector(SmallVectorImpl<T> &&RHS) : SmallVectorImpl<T>(N) {
+    SmallVector(SmallVectorImpl<T, Allocator> &&RHS)
+        : SmallVectorImpl<T, Allocator>(N, RHS.get_allocator()) {
         if (!RHS.empty())
-            SmallVectorImpl<T>::operator=(::std::move(RHS));
+            SmallVectorImpl<T, Allocator>::operator=(::std::move(RHS));
     }
 
     SmallVector &operator=(SmallVector &&RHS) {
-        if (N) {
-            SmallVectorImpl<T>::operator=(::std::move(RHS));
+        if (N || !this->canStealAllocation(RHS)) {
+            SmallVectorImpl<T, Allocator>::operator=(::std::move(RHS));
             return *this;
         }
         // SmallVectorImpl<T>::operator= does not leverage N==0. Optimize the
@@ -1262,8 +1409,8 @@ public:
         return *this;
     }
 
-    SmallVector &operator=(SmallVectorImpl<T> &&RHS) {
-        SmallVectorImpl<T>::operator=(::std::move(RHS));
+    SmallVector &operator=(SmallVectorImpl<T, Allocator> &&RHS) {
+        SmallVectorImpl<T, Allocator>::operator=(::std::move(RHS));
         return *this;
     }
 
@@ -1273,7 +1420,8 @@ public:
     }
 };
 
-template <typename T, unsigned N> inline size_t capacity_in_bytes(SmallVector<T, N> const &X) {
+template <typename T, unsigned N, typename Allocator>
+inline size_t capacity_in_bytes(SmallVector<T, N, Allocator> const &X) {
     return X.capacity_in_bytes();
 }
 
@@ -1300,6 +1448,13 @@ template <typename Out, typename R> SmallVector<Out> to_vector_of(R &&Range) {
     return {std::begin(Range), std::end(Range)};
 }
 
+namespace pmr {
+/// A SmallVector whose heap buffer is allocated from a memory resource, e.g.,
+/// a std::pmr::monotonic_buffer_resource released once the frame is done.
+template <typename T, unsigned N = CalculateSmallVectorDefaultInlinedElements<T>::value>
+using SmallVector = kira::SmallVector<T, N, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+
 // Explicit instantiations
 extern template class kira::SmallVectorBase<uint32_t>;
 #if SIZE_MAX > UINT32_MAX
@@ -1313,14 +1468,16 @@ extern template class kira::SmallVectorBase<uint64_t>;
 
 namespace std {
 /// Implement std::swap in terms of SmallVector swap.
-template <typename T>
-inline void swap(kira::SmallVectorImpl<T> &LHS, kira::SmallVectorImpl<T> &RHS) {
+template <typename T, typename Allocator>
+inline void
+swap(kira::SmallVectorImpl<T, Allocator> &LHS, kira::SmallVectorImpl<T, Allocator> &RHS) {
     LHS.swap(RHS);
 }
 
 /// Implement std::swap in terms of SmallVector swap.
-template <typename T, unsigned N>
-inline void swap(kira::SmallVector<T, N> &LHS, kira::SmallVector<T, N> &RHS) {
+template <typename T, unsigned N, typename Allocator>
+inline void
+swap(kira::SmallVector<T, N, Allocator> &LHS, kira::SmallVector<T, N, Allocator> &RHS) {
     LHS.swap(RHS);
 }
 } // end namespace std
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "kira/Macros.h"
+#include "kira/Types.h"
+
+namespace kira {
+//! NOTE(krr): The thread pool shared by the kira modules, s.t. a parallel loop nested into another
+//! one, or run from another module, neither oversubscribes the cores nor waits for them. Each
+//! worker owns a deque of tasks (see `detail::WorkStealingDeque`), where it pushes the tasks it
+//! spawns and pops the latest one, while the idle workers steal the oldest ones of the others,
+//! preferably of the workers on the same NUMA node. The threads which are not workers queue their
+//! tasks into a shared queue instead.
+//!
+//! A thread waiting for its tasks (see `TaskGroup::Wait()`) runs the queued tasks meanwhile, s.t.
+//! the tasks may wait for the tasks they spawn, and the caller of a parallel loop works on it as
+//! well. The idle workers sleep until a task is queued, and the waiting threads until a task of
+//! their group is queued or the group is done.
+//!
+//! The number of the threads, including the caller, is `KRR_NUM_THREADS`, or the number of the
+//! cores, and `KRR_THREAD_AFFINITY` pins the workers to the cores (see `ThreadAffinity`), both read
+//! when the pool is first used:
+//!
+//!     KRR_NUM_THREADS=8 KRR_THREAD_AFFINITY=scatter ./app
+//!
+//! The workers are named `kira-worker-N`, as are their threads in the profilers and the debuggers.
+
+class TaskGroup;
+
+/// How the workers are pinned to the cores.
+enum class ThreadAffinity : uint8 {
+    /// Not pinned, i.e., scheduled by the operating system.
+    None,
+    /// Pinned to the cores in order, filling a NUMA node before the next one.
+    Compact,
+    /// Pinned to the cores of the NUMA nodes in turn, which spreads the bandwidth over the nodes.
+    Scatter,
+};
+
+namespace detail {
+/// The task queued into the pool, which is destroyed once run.
+struct Task {
+    explicit Task(TaskGroup &inGroup) noexcept : group(&inGroup) {}
+    virtual ~Task() = default;
+    virtual void Run() = 0;
+
+    TaskGroup *group;
+};
+
+template <typename Func> struct FunctionTask final : Task {
+    template <typename F>
+    FunctionTask(TaskGroup &inGroup, F &&inFunc) : Task(inGroup), func(std::forward<F>(inFunc)) {}
+    void Run() override { func(); }
+
+    Func func;
+};
+} // namespace detail
+
+/// The pool of the worker threads, which run the tasks of `TaskGroup`.
+class ThreadPool {
+public:
+    /// \param numThreads The number of the threads, including the caller, i.e., one more than the
+    /// workers, where a single thread runs the tasks when waited for.
+    explicit ThreadPool(std::size_t numThreads, ThreadAffinity affinity = ThreadAffinity::None);
+    ~ThreadPool();
+
+    KIRA_DISALLOW_COPY_AND_ASSIGN(ThreadPool)
+
+    /// The pool shared by the kira modules, configured by the environment, see above.
+    static ThreadPool &GetInstance();
+
+    /// The number of the threads which run the tasks, including the caller.
+    [[nodiscard]] std::size_t GetConcurrency() const noexcept;
+
+    /// The index of the calling thread among the workers of this pool, if it is one.
+    [[nodiscard]] std::optional<std::size_t> GetWorkerIndex() const noexcept;
+
+private:
+    friend class TaskGroup;
+
+    void Submit(detail::Task *task);
+    void Wait(TaskGroup &group);
+
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+/// The tasks which are waited for together.
+///
+/// \remark The tasks may run more tasks into the group, and wait for the groups of their own.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &inPool = ThreadPool::GetInstance()) noexcept : pool(&inPool) {}
+
+    /// Wait for the tasks, whose exceptions are discarded, see \c Wait().
+    ~TaskGroup() noexcept {
+        if (pending.load(std::memory_order_acquire) != 0)
+            pool->Wait(*this);
+    }
+
+    KIRA_DISALLOW_COPY_AND_ASSIGN(TaskGroup)
+
+    /// Queue `func()` to be run by the pool.
+    template <typename Func> void Run(Func &&func) {
+        auto *task = new detail::FunctionTask<std::decay_t<Func>>(*this, std::forward<Func>(func));
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool->Submit(task);
+    }
+
+    /// Wait for the tasks queued so far, and the tasks they queue, running the queued tasks
+    /// meanwhile.
+    ///
+    /// \throw The first exception thrown by the tasks, after which the tasks not started yet are
+    /// skipped.
+    void Wait() {
+        pool->Wait(*this);
+        std::lock_guard guard(errorMutex);
+        if (error)
+            std::rethrow_exception(std::exchange(error, nullptr));
+    }
+
+    /// Whether a task has thrown, s.t. the tasks not started yet are skipped.
+    [[nodiscard]] bool IsCancelled() const noexcept {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class ThreadPool;
+
+    ThreadPool *pool;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<bool> cancelled{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+namespace detail {
+/// The grain of `[begin, end)`, s.t. each thread gets about 8 of the ranges.
+[[nodiscard]] inline std::size_t
+GetParallelGrain(std::size_t begin, std::size_t end, std::size_t grain, ThreadPool const &pool) {
+    if (grain != 0)
+        return grain;
+    return std::max<std::size_t>(1, (end - begin) / (8 * pool.GetConcurrency()));
+}
+
+template <typename Func>
+void ParallelForRange(
+    TaskGroup &group, std::size_t begin, std::size_t end, std::size_t grain, Func const &func
+) {
+    // The upper halves are queued, where they are stolen by the idle threads, which split them
+    // further.
+    while (end - begin > grain) {
+        auto const mid = begin + (end - begin) / 2;
+        group.Run([&group, mid, end, grain, &func] {
+            ParallelForRange(group, mid, end, grain, func);
+        });
+        end = mid;
+    }
+    func(begin, end);
+}
+
+template <typename T, typename Map, typename Combine>
+T ParallelReduceRange(
+    ThreadPool &pool, std::size_t begin, std::size_t end, std::size_t grain, Map const &map,
+    Combine const &combine
+) {
+    if (end - begin <= grain)
+        return map(begin, end);
+
+    auto const mid = begin + (end - begin) / 2;
+    std::optional<T> upper;
+    TaskGroup group(pool);
+    group.Run([&] { upper.emplace(ParallelReduceRange<T>(pool, mid, end, grain, map, combine)); });
+    auto lower = ParallelReduceRange<T>(pool, begin, mid, grain, map, combine);
+    group.Wait();
+    return combine(std::move(lower), std::move(*upper));
+}
+} // namespace detail
+
+/// Run `func(first, last)` for the ranges covering `[begin, end)` on the pool, and wait for them.
+///
+/// \param grain The largest range, or 0 to choose one by the number of the threads.
+/// \throw The first exception thrown by `func`, see \c TaskGroup::Wait().
+template <typename Func>
+void ParallelFor(
+    std::size_t begin, std::size_t end, Func const &func, std::size_t grain = 0,
+    ThreadPool &pool = ThreadPool::GetInstance()
+) {
+    if (begin >= end)
+        return;
+    TaskGroup group(pool);
+    detail::ParallelForRange(
+        group, begin, end, detail::GetParallelGrain(begin, end, grain, pool), func
+    );
+    group.Wait();
+}
+
+/// Reduce `[begin, end)` by `combine` of `map(first, last)` of its ranges on the pool.
+///
+/// The ranges are split in halves until no longer than `grain`, and combined in the same order,
+/// s.t. the result only depends on `grain`, not on the threads running them.
+///
+/// \param identity The result if `[begin, end)` is empty.
+/// \param grain The largest range, or 0 to choose one by the number of the threads.
+/// \throw The first exception thrown by `map` or `combine`.
+template <typename T, typename Map, typename Combine>
+T ParallelReduce(
+    std::size_t begin, std::size_t end, T identity, Map const &map, Combine const &combine,
+    std::size_t grain = 0, ThreadPool &pool = ThreadPool::GetInstance()
+) {
+    if (begin >= end)
+        return identity;
+    return detail::ParallelReduceRange<T>(
+        pool, begin, end, detail::GetParallelGrain(begin, end, grain, pool), map, combine
+    );
+}
+} // namespace kira
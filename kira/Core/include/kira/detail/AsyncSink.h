@@ -0,0 +1,71 @@
+#pragma once
+
+#include <spdlog/sinks/sink.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "kira/Logger.h"
+#include "kira/detail/LogRecord.h"
+
+namespace kira::detail {
+//! NOTE(krr): The asynchronous loggers only copy the record (the formatted message, the level,
+//! the time and the source location) into a bounded ring on the thread which logs. The ring is the
+//! bounded queue of Dmitry Vyukov: the producers only race on the position, through a CAS, and
+//! each cell is handed over by its sequence number, s.t. no lock is taken by the producers unless
+//! the queue is full under `LogOverflowPolicy::Block`. A background thread pops the records, and
+//! formats and writes them into the sinks, which may then stall on a slow filesystem without
+//! stalling the callers.
+//!
+//! The cells only hold the size of their record, whose bytes are in a byte ring of 128 bytes per
+//! cell: a fixed-size header, followed by either the logger name and the formatted message, or the
+//! arguments of a deferred record (see `LogRecord`), which is only formatted by the background
+//! thread if there is a sink to write it into. The position of a cell and its bytes are claimed by
+//! the same CAS, s.t. the bytes are in the order of the cells, and the consumers, which are
+//! serialized, release them in that order. The queue is full when either ring is.
+//!
+//! The producers may pop the oldest records as well, which is how `LogOverflowPolicy::DropOldest`
+//! makes room.
+
+/// The sink which queues the records, and writes them into `sinks` on a background thread.
+class AsyncSink final : public spdlog::sinks::sink {
+public:
+    /// \param queueSize The number of the records queued at most, rounded up to a power of two,
+    /// of which the long ones take the room of several.
+    /// \param binaryPath The binary file to write the records into as well, if any.
+    /// \throw std::runtime_error If the binary file cannot be created.
+    AsyncSink(
+        std::span<spdlog::sink_ptr const> sinks, std::size_t queueSize, LogOverflowPolicy policy,
+        std::optional<std::filesystem::path> const &binaryPath = std::nullopt
+    );
+    ~AsyncSink() override;
+
+    AsyncSink(AsyncSink const &) = delete;
+    AsyncSink &operator=(AsyncSink const &) = delete;
+
+public:
+    void log(spdlog::details::log_msg const &msg) override;
+
+    /// Queue a deferred record.
+    void log(LogRecord const &record);
+
+    /// Wait until the records queued before are written, and flush the sinks.
+    void flush() override;
+
+    void set_pattern(std::string const &pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    /// The number of the records which can be queued.
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /// The number of the records dropped by the overflow policy so far.
+    [[nodiscard]] std::size_t dropped() const noexcept;
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+} // namespace kira::detail
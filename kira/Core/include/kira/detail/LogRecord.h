@@ -0,0 +1,146 @@
+#pragma once
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/os.h>
+
+#include <bit>
+#include <concepts>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include "kira/Types.h"
+#include "kira/detail/Logger.h"
+
+namespace kira::detail {
+//! NOTE(krr): The deferred records hold what a call to `Log.*` knows before formatting: the format
+//! string, the source location, the level, the time, the thread, and the arguments, which must all
+//! be arithmetic, as their bits. They are trivially copyable, s.t. queuing one costs a copy of a
+//! few cache lines, and formatting it is left to the background thread of the asynchronous logger,
+//! or to `kira.Core.LogDecode` when the records are written into a binary file.
+//!
+//! The strings (the format string, the logger name and the source location) are only referred to,
+//! thus must outlive the logger: the format string is only deferred if it is known at compile
+//! time, i.e., a string literal in practice, see `FormatWithSourceLoc`.
+
+/// The types of the deferred arguments.
+enum class LogArgType : uint8 { Bool, Char, Int64, UInt64, Float, Double };
+
+/// Whether an argument of type `T` is copied into a deferred record rather than formatted.
+template <typename T>
+concept is_deferrable_log_arg =
+    std::same_as<T, bool> or std::same_as<T, char> or std::same_as<T, float> or
+    std::same_as<T, double> or
+    (std::integral<T> and not std::same_as<T, wchar_t> and not std::same_as<T, char8_t> and
+     not std::same_as<T, char16_t> and not std::same_as<T, char32_t>);
+
+/// The log record whose message is formatted later.
+struct LogRecord {
+    static constexpr std::size_t maxArgs = 8;
+
+    std::string_view loggerName;
+    std::string_view fmt;
+    spdlog::source_loc loc;
+    spdlog::log_clock::time_point time;
+    std::size_t threadId;
+    spdlog::level::level_enum level;
+    uint8 numArgs;
+    LogArgType types[maxArgs];
+    uint64 values[maxArgs];
+};
+
+static_assert(std::is_trivially_copyable_v<LogRecord>);
+
+/// Whether a call with the arguments `Args` can be deferred.
+template <typename... Args>
+concept is_deferrable_log_call = sizeof...(Args) <= LogRecord::maxArgs and
+                                 (is_deferrable_log_arg<std::remove_cvref_t<Args>> and ...);
+
+/// Capture a call into a record.
+template <typename... Args>
+    requires(is_deferrable_log_call<Args...>)
+[[nodiscard]] LogRecord MakeLogRecord(
+    std::string_view loggerName, FormatWithSourceLoc const &fmt, spdlog::level::level_enum level,
+    Args const &...args
+) {
+    LogRecord record;
+    record.loggerName = loggerName;
+    record.fmt = fmt.fmt;
+    record.loc = get_spdlog_source_loc(fmt.loc);
+    record.time = spdlog::log_clock::now();
+    record.threadId = spdlog::details::os::thread_id();
+    record.level = level;
+    record.numArgs = sizeof...(Args);
+
+    std::size_t i = 0;
+    [[maybe_unused]] auto const capture = [&]<typename T>(T arg) {
+        if constexpr (std::same_as<T, bool>) {
+            record.types[i] = LogArgType::Bool;
+            record.values[i] = arg;
+        } else if constexpr (std::same_as<T, char>) {
+            record.types[i] = LogArgType::Char;
+            record.values[i] = static_cast<unsigned char>(arg);
+        } else if constexpr (std::same_as<T, float>) {
+            record.types[i] = LogArgType::Float;
+            record.values[i] = std::bit_cast<uint32>(arg);
+        } else if constexpr (std::same_as<T, double>) {
+            record.types[i] = LogArgType::Double;
+            record.values[i] = std::bit_cast<uint64>(arg);
+        } else if constexpr (std::is_signed_v<T>) {
+            record.types[i] = LogArgType::Int64;
+            record.values[i] = static_cast<uint64>(static_cast<int64>(arg));
+        } else {
+            record.types[i] = LogArgType::UInt64;
+            record.values[i] = static_cast<uint64>(arg);
+        }
+        ++i;
+    };
+    (capture(static_cast<std::remove_cvref_t<Args>>(args)), ...);
+    return record;
+}
+
+/// Format the message of `record` into `out`.
+///
+/// \remark A format string which does not match the arguments is reported in the message.
+void FormatLogRecord(LogRecord const &record, spdlog::memory_buf_t &out);
+
+/// The records written into, and read from, a binary log file.
+///
+/// \remark The files are not portable across the architectures.
+class BinaryLogFile {
+public:
+    BinaryLogFile(BinaryLogFile const &) = delete;
+    BinaryLogFile &operator=(BinaryLogFile const &) = delete;
+    ~BinaryLogFile();
+
+    /// Create the file at `path` to write the records into.
+    /// \throw std::runtime_error If the file cannot be created.
+    [[nodiscard]] static BinaryLogFile Create(std::filesystem::path const &path);
+
+    /// Open the file at `path` to read the records from.
+    /// \throw std::runtime_error If the file cannot be opened, or is not a binary log file.
+    [[nodiscard]] static BinaryLogFile Open(std::filesystem::path const &path);
+
+    BinaryLogFile(BinaryLogFile &&other) noexcept;
+
+    /// Write a deferred record.
+    void Write(LogRecord const &record);
+
+    /// Write a record which is formatted already.
+    void Write(spdlog::details::log_msg const &msg);
+
+    /// Read the next record, whose message is formatted already.
+    ///
+    /// \return The record, whose string views refer to `buffer`, or nothing at the end of the file.
+    /// \throw std::runtime_error If the file is truncated.
+    [[nodiscard]] std::optional<spdlog::details::log_msg> Read(spdlog::memory_buf_t &buffer);
+
+    void Flush();
+
+private:
+    explicit BinaryLogFile(std::FILE *file) noexcept : file(file) {}
+
+    std::FILE *file;
+};
+} // namespace kira::detail
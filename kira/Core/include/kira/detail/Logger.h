@@ -2,10 +2,12 @@
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <filesystem>
 #include <source_location>
-#include <unordered_map>
 
+#include "kira/Compiler.h"
+#include "kira/FlatHashMap.h"
 #include "kira/Types.h"
 
 namespace kira::detail {
@@ -23,24 +25,104 @@ template <size_t N> struct StringLiteral {
     constexpr operator std::string_view() const { return value; }
 };
 
+/// The pattern of the messages, see `spdlog::pattern_formatter`.
+#ifdef NDEBUG
+constexpr std::string_view loggerPattern = "[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v";
+#else
+constexpr std::string_view loggerPattern = "[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] [%s:%#] %v";
+#endif
+
 /// Helper struct to construct the source location.
 struct FormatWithSourceLoc {
     std::string_view fmt;
     std::source_location loc;
+    /// Whether `fmt` is known at compile time, thus of the static storage, which the deferred
+    /// records may refer to.
+    bool literal;
 
 public:
+    /// The string literals, and the other `constexpr` arrays of `char const`.
+    ///
+    /// \remark A `char const` array filled at runtime cannot be told apart from a literal by its
+    /// type, thus has to be wrapped by `fmt::runtime`, see below.
+    template <std::size_t N>
+    consteval FormatWithSourceLoc(
+        char const (&fmt)[N], std::source_location const &loc = std::source_location::current()
+    )
+        : fmt(fmt), loc(loc), literal(true) {}
+
     /// https://stackoverflow.com/questions/57547273/how-to-use-source-location-in-a-variadic-template-function
     ///
     /// It will be tricky to enable both `source_location` and compile-time check
     /// in `fmt::print`. I'll stay with `fmt::runtime` for now.
+    ///
+    /// The other strings, e.g., the buffers on the stack, are formatted by the call.
     template <typename T>
         requires(std::is_convertible_v<T, std::string_view>)
     constexpr FormatWithSourceLoc(
-        T fmt, std::source_location const &loc = std::source_location::current()
+        T &&fmt, std::source_location const &loc = std::source_location::current()
+    )
+        : fmt(fmt), loc(loc), literal(false) {}
+
+    /// The strings wrapped by `fmt::runtime`, which are never deferred, as those above.
+    constexpr FormatWithSourceLoc(
+        decltype(fmt::runtime(std::string_view{})) fmt,
+        std::source_location const &loc = std::source_location::current()
     )
-        : fmt(std::move(fmt)), loc(loc) {}
+        : fmt(fmt.str.data(), fmt.str.size()), loc(loc), literal(false) {}
+};
+
+//! NOTE(krr): The loggers are resolved once per name: the logger is kept in an atomic slot shared
+//! by all the levels of the name, s.t. a call only loads the slot and checks the level of the
+//! logger, without locking nor looking up the registry of spdlog. The slots are reset when the
+//! logger is destroyed (e.g., by `spdlog::shutdown()`), or when another logger of the same name is
+//! created by `LoggerBuilder`, and the logger is then resolved again by the next call.
+
+class AsyncSink;
+struct LogRecord;
+
+/// The slot of the cached logger of a name.
+struct LoggerSlot {
+    std::atomic<spdlog::logger *> logger{nullptr};
+    /// The sink of the logger which takes the deferred records, if any.
+    std::atomic<AsyncSink *> deferred{nullptr};
 };
 
+/// The slot of the cached logger of `name`.
+template <StringLiteral name> inline LoggerSlot loggerSlot;
+
+/// Get or create the logger of `name` and cache it into `slot`, if any.
+///
+/// \note The loggers created by other means than \c LoggerBuilder are not cached.
+[[nodiscard]] spdlog::logger *ResolveLogger(std::string const &name, LoggerSlot *slot);
+
+/// Reset the slots of `name`, or only those holding `logger` if not null.
+void ResetLoggerSlots(std::string const &name, spdlog::logger const *logger = nullptr) noexcept;
+
+/// Get the cached logger of `name`, which is resolved by the first call.
+template <StringLiteral name> [[nodiscard]] KIRA_FORCEINLINE spdlog::logger *GetCachedLogger() {
+    // Acquire the construction of the logger, which is free on most of the platforms.
+    if (auto *logger = loggerSlot<name>.logger.load(std::memory_order_acquire); KIRA_LIKELY(logger))
+        return logger;
+    return ResolveLogger(name.value, &loggerSlot<name>);
+}
+
+/// The logger created by \c LoggerBuilder, which resets its slots when destroyed.
+class CachedLogger final : public spdlog::logger {
+public:
+    using spdlog::logger::logger;
+
+    CachedLogger(CachedLogger const &) = delete;
+    CachedLogger &operator=(CachedLogger const &) = delete;
+    ~CachedLogger() override { ResetLoggerSlots(name(), this); }
+
+    /// The sink which takes the deferred records, owned by the logger, if any.
+    AsyncSink *deferredSink{nullptr};
+};
+
+/// Queue a deferred record into `sink`.
+void LogDeferred(AsyncSink &sink, LogRecord const &record);
+
 /// The singleton to manage the sinks.
 class SinkManager {
 public:
@@ -78,6 +160,6 @@ public:
 
 private:
     spdlog::sink_ptr consoleSink;
-    std::unordered_map<std::filesystem::path, spdlog::sink_ptr> fileSinks;
+    FlatHashMap<std::filesystem::path, spdlog::sink_ptr> fileSinks;
 };
 } // namespace kira::detail
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "kira/Types.h"
+
+namespace kira::detail {
+//! NOTE(krr): The deque of Chase and Lev, with the memory orders of Lê et al., "Correct and
+//! Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013): its owner pushes and pops at the
+//! bottom without a CAS but for the last element, while the thieves take the top through a CAS on
+//! it. The fences of the paper are folded into the sequentially consistent accesses of `bottom` and
+//! `top`, which cost the same on x86-64 and are understood by the thread sanitizer.
+//!
+//! The ring is doubled when full, where the smaller ones are kept until the destruction, since a
+//! thief may still be reading from them.
+
+/// The deque of the pointers which one thread pushes and pops, and the others steal.
+template <typename T> class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 256) {
+        std::size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        rings.push_back(std::make_unique<Ring>(size));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(WorkStealingDeque const &) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque const &) = delete;
+
+    /// Push `value` at the bottom, by the owner.
+    void Push(T *value) {
+        auto const b = bottom.load(std::memory_order_relaxed);
+        auto const t = top.load(std::memory_order_acquire);
+        auto *current = ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64>(current->mask))
+            current = Grow(current, t, b);
+        current->Store(b, value);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// Pop the bottom, by the owner, or null if empty.
+    T *Pop() noexcept {
+        auto const b = bottom.load(std::memory_order_relaxed) - 1;
+        auto *current = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto *value = current->Load(b);
+        if (t == b) {
+            // The last one, which a thief may take meanwhile.
+            if (not top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+                ))
+                value = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    /// Take the top, by any thread, or null if empty or taken by another thread meanwhile.
+    T *Steal() noexcept {
+        auto t = top.load(std::memory_order_seq_cst);
+        auto const b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b)
+            return nullptr;
+
+        auto *value = ring.load(std::memory_order_acquire)->Load(t);
+        if (not top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+            ))
+            return nullptr;
+        return value;
+    }
+
+    /// Whether the deque looks empty, which may be outdated once returned.
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return top.load(std::memory_order_relaxed) >= bottom.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Ring {
+        explicit Ring(std::size_t size) : mask(size - 1), slots(new std::atomic<T *>[size]) {}
+
+        T *Load(int64 i) const noexcept {
+            return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Store(int64 i, T *value) noexcept {
+            slots[static_cast<std::size_t>(i) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T *>[]> slots;
+    };
+
+    Ring *Grow(Ring *current, int64 t, int64 b) {
+        rings.push_back(std::make_unique<Ring>(2 * (current->mask + 1)));
+        auto *grown = rings.back().get();
+        for (auto i = t; i < b; ++i)
+            grown->Store(i, current->Load(i));
+        ring.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    alignas(64) std::atomic<int64> top{0};
+    alignas(64) std::atomic<int64> bottom{0};
+    std::atomic<Ring *> ring;
+
+    // Only touched by the owner.
+    std::vector<std::unique_ptr<Ring>> rings;
+};
+} // namespace kira::detail
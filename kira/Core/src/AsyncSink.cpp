@@ -0,0 +1,395 @@
+#include "kira/detail/AsyncSink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kira::detail {
+namespace {
+/// The cell of the ring, whose sequence tells whether it is to be written or read, and the size
+/// of its record in the byte ring.
+struct Cell {
+    std::atomic<uint32> sequence;
+    uint32 size;
+};
+
+/// The fixed part of a record in the byte ring, followed by, if deferred, the views of the logger
+/// name and of the format string and the arguments, or else, the logger name and the message.
+struct RecordHeader {
+    spdlog::log_clock::time_point time;
+    std::size_t threadId;
+    spdlog::source_loc loc;
+    spdlog::level::level_enum level;
+    bool deferred;
+    uint8 numArgs;
+    uint32 nameSize;
+    uint32 payloadSize;
+};
+
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+
+/// The bytes per record of the byte ring, which most records fit in.
+constexpr std::size_t bytesPerRecord = 128;
+/// The bytes of the byte ring at least, s.t. the small queues take long messages as well.
+constexpr std::size_t minBytes = 4096;
+
+constexpr std::size_t cacheLineSize = 64;
+} // namespace
+
+struct AsyncSink::State {
+    State(
+        std::span<spdlog::sink_ptr const> inSinks, std::size_t queueSize, LogOverflowPolicy policy,
+        std::optional<std::filesystem::path> const &binaryPath
+    )
+        : sinks(inSinks.begin(), inSinks.end()), policy(policy),
+          mask(std::bit_ceil(std::max<std::size_t>(queueSize, 2)) - 1),
+          byteMask(std::bit_ceil(std::max((mask + 1) * bytesPerRecord, minBytes)) - 1),
+          cells(std::make_unique<Cell[]>(mask + 1)),
+          bytes(std::make_unique<std::byte[]>(byteMask + 1)) {
+        if (binaryPath)
+            binary.emplace(BinaryLogFile::Create(binaryPath.value()));
+        for (std::size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(static_cast<uint32>(i), std::memory_order_relaxed);
+        worker = std::jthread([this] { Run(); });
+    }
+
+    ~State() {
+        stopping.store(true);
+        Wake();
+    }
+
+    /// Copy `size` bytes of `data` into the byte ring at `pos`, wrapping around its end.
+    void CopyIn(uint32 pos, void const *data, std::size_t size) noexcept {
+        auto const offset = pos & byteMask;
+        auto const first = std::min(size, byteMask + 1 - offset);
+        std::memcpy(bytes.get() + offset, data, first);
+        std::memcpy(bytes.get(), static_cast<std::byte const *>(data) + first, size - first);
+    }
+
+    /// Copy `size` bytes of the byte ring at `pos` into `data`, wrapping around its end.
+    void CopyOut(uint32 pos, void *data, std::size_t size) const noexcept {
+        auto const offset = pos & byteMask;
+        auto const first = std::min(size, byteMask + 1 - offset);
+        std::memcpy(data, bytes.get() + offset, first);
+        std::memcpy(static_cast<std::byte *>(data) + first, bytes.get(), size - first);
+    }
+
+    /// Fill a cell of the ring and `size` bytes of the byte ring by `fill`, unless either is full.
+    ///
+    /// \remark The cell and the bytes are claimed at once, s.t. the bytes are in the order of the
+    /// cells, and are released in that order.
+    template <typename Fill> bool TryPush(uint32 size, Fill const &fill) {
+        auto positions = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            auto const pos = static_cast<uint32>(positions);
+            auto const head = static_cast<uint32>(positions >> 32);
+            auto &cell = cells[pos & mask];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<int32>(sequence - pos);
+            if (diff == 0) {
+                if (head + size - byteTail.load(std::memory_order_acquire) > byteMask + 1)
+                    return false;
+                auto const next = uint64{pos + 1} | uint64{head + size} << 32;
+                if (enqueuePos.compare_exchange_weak(
+                        positions, next, std::memory_order_relaxed
+                    )) {
+                    fill(head);
+                    cell.size = size;
+                    // Sequentially consistent for the handshake with the sleep, see `Wake()`.
+                    cell.sequence.store(pos + 1);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                positions = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Take the oldest record by `take` of its bytes, unless the ring is empty.
+    ///
+    /// \remark The consumers are serialized, s.t. the bytes are released in order.
+    template <typename Take> bool TryPop(Take const &take) {
+        std::lock_guard guard(popMutex);
+        auto const pos = dequeuePos.load(std::memory_order_relaxed);
+        auto &cell = cells[pos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            return false;
+        auto const tail = byteTail.load(std::memory_order_relaxed);
+        take(tail, cell.size);
+        byteTail.store(tail + cell.size, std::memory_order_release);
+        cell.sequence.store(static_cast<uint32>(pos + mask + 1), std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] bool Empty() const {
+        auto const pos = dequeuePos.load(std::memory_order_relaxed);
+        return cells[pos & mask].sequence.load() != pos + 1;
+    }
+
+    /// Queue a record of `size` bytes by `fill`, as told by the overflow policy.
+    template <typename Fill> void Push(uint32 size, Fill const &fill) {
+        switch (policy) {
+        case LogOverflowPolicy::Block:
+            if (not TryPush(size, fill)) {
+                Wake();
+                WaitConsumed([&](std::size_t) { return TryPush(size, fill); });
+            }
+            break;
+        case LogOverflowPolicy::DropOldest:
+            while (not TryPush(size, fill)) {
+                if (TryPop([](uint32, uint32) {})) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    Consume();
+                }
+            }
+            break;
+        case LogOverflowPolicy::DropNewest:
+            if (not TryPush(size, fill)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        }
+
+        Wake();
+    }
+
+    /// Count a record written or dropped, and wake the threads waiting for it.
+    void Consume() {
+        consumed.fetch_add(1);
+        if (waiters.load() != 0)
+            consumed.notify_all();
+    }
+
+    /// Wait until `pred` holds, which is checked again whenever a record is consumed.
+    template <typename Pred> void WaitConsumed(Pred pred) {
+        waiters.fetch_add(1);
+        for (auto count = consumed.load(); not pred(count); count = consumed.load())
+            consumed.wait(count);
+        waiters.fetch_sub(1);
+    }
+
+    /// Wake the background thread if it sleeps.
+    ///
+    /// \remark The record is published by a sequentially consistent store of its cell, before
+    /// `sleeping` is loaded here, while `Run()` stores `sleeping` before loading the cell in
+    /// `Empty()`. In the single total order of these operations, either the record is seen there,
+    /// or the sleep here. Unlike a pair of fences, this is also understood by ThreadSanitizer.
+    void Wake() {
+        if (sleeping.load() and sleeping.exchange(false))
+            sleeping.notify_one();
+    }
+
+    void Run() {
+        std::vector<std::byte> taken;
+        auto const take = [&](uint32 pos, uint32 size) {
+            taken.resize(size);
+            CopyOut(pos, taken.data(), size);
+        };
+
+        while (true) {
+            {
+                // Held while writing, s.t. `flush()` does not miss the record being written.
+                std::lock_guard guard(writeMutex);
+                if (TryPop(take)) {
+                    Write(taken);
+                    Consume();
+                    continue;
+                }
+            }
+
+            if (stopping.load())
+                return;
+
+            // The handshake with `Wake()`, see there.
+            sleeping.store(true);
+            if (not Empty() or stopping.load()) {
+                sleeping.store(false);
+                continue;
+            }
+            sleeping.wait(true);
+        }
+    }
+
+    /// Write a record taken from the byte ring.
+    void Write(std::span<std::byte const> bytes) {
+        RecordHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        auto const *data = bytes.data() + sizeof(header);
+        if (header.deferred) {
+            LogRecord record;
+            std::memcpy(&record.loggerName, data, sizeof(record.loggerName));
+            data += sizeof(record.loggerName);
+            std::memcpy(&record.fmt, data, sizeof(record.fmt));
+            data += sizeof(record.fmt);
+            std::memcpy(record.types, data, header.numArgs * sizeof(LogArgType));
+            data += header.numArgs * sizeof(LogArgType);
+            std::memcpy(record.values, data, header.numArgs * sizeof(uint64));
+            record.loc = header.loc;
+            record.time = header.time;
+            record.threadId = header.threadId;
+            record.level = header.level;
+            record.numArgs = header.numArgs;
+            Write(record);
+        } else {
+            auto const *name = reinterpret_cast<char const *>(data);
+            spdlog::details::log_msg msg{
+                header.time, header.loc, spdlog::string_view_t{name, header.nameSize},
+                header.level, spdlog::string_view_t{name + header.nameSize, header.payloadSize}
+            };
+            msg.thread_id = header.threadId;
+            Write(msg);
+        }
+    }
+
+    void Write(LogRecord const &record) {
+        if (binary)
+            Guard([&] { binary->Write(record); });
+        if (sinks.empty())
+            return;
+
+        spdlog::memory_buf_t buffer;
+        FormatLogRecord(record, buffer);
+        spdlog::details::log_msg msg{
+            record.time, record.loc, record.loggerName, record.level,
+            spdlog::string_view_t{buffer.data(), buffer.size()}
+        };
+        msg.thread_id = record.threadId;
+        WriteSinks(msg);
+    }
+
+    void Write(spdlog::details::log_msg const &msg) {
+        if (binary)
+            Guard([&] { binary->Write(msg); });
+        WriteSinks(msg);
+    }
+
+    void WriteSinks(spdlog::details::log_msg const &msg) {
+        for (auto const &sink : sinks) {
+            if (not sink->should_log(msg.level))
+                continue;
+            Guard([&] { sink->log(msg); });
+        }
+    }
+
+    /// Report the failures to write, which have no caller to be thrown to.
+    template <typename F> static void Guard(F const &write) {
+        try {
+            write();
+        } catch (std::exception const &e) {
+            fmt::print(stderr, "kira: Failed to write a log record: {}\n", e.what());
+        }
+    }
+
+    std::vector<spdlog::sink_ptr> sinks;
+    std::optional<BinaryLogFile> binary;
+    LogOverflowPolicy const policy;
+    std::size_t const mask;
+    std::size_t const byteMask;
+    std::unique_ptr<Cell[]> cells;
+    std::unique_ptr<std::byte[]> bytes;
+
+    // The positions are written by different threads, thus kept on their own cache lines. The
+    // position of the cells and the head of the byte ring are claimed together, in 32 bits each.
+    alignas(cacheLineSize) std::atomic<uint64> enqueuePos{0};
+    alignas(cacheLineSize) std::atomic<uint32> dequeuePos{0};
+    std::atomic<uint32> byteTail{0};
+    std::mutex popMutex;
+    alignas(cacheLineSize) std::atomic<std::size_t> consumed{0};
+    std::atomic<std::size_t> waiters{0};
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> stopping{false};
+    std::mutex writeMutex;
+
+    // Declared last, s.t. it is joined before the rest is destroyed.
+    std::jthread worker;
+};
+
+AsyncSink::AsyncSink(
+    std::span<spdlog::sink_ptr const> sinks, std::size_t queueSize, LogOverflowPolicy policy,
+    std::optional<std::filesystem::path> const &binaryPath
+)
+    : state(std::make_unique<State>(sinks, queueSize, policy, binaryPath)) {}
+
+AsyncSink::~AsyncSink() = default;
+
+void AsyncSink::log(spdlog::details::log_msg const &msg) {
+    // Truncated if longer than the byte ring.
+    auto const room = state->byteMask + 1 - sizeof(RecordHeader);
+    auto const nameSize = static_cast<uint32>(std::min(msg.logger_name.size(), room));
+    auto const payloadSize = static_cast<uint32>(std::min(msg.payload.size(), room - nameSize));
+    RecordHeader const header{
+        msg.time, msg.thread_id, msg.source, msg.level, false, 0, nameSize, payloadSize
+    };
+    auto const size = sizeof(header) + nameSize + payloadSize;
+    state->Push(static_cast<uint32>(size), [&](uint32 pos) {
+        state->CopyIn(pos, &header, sizeof(header));
+        pos += sizeof(header);
+        state->CopyIn(pos, msg.logger_name.data(), nameSize);
+        state->CopyIn(pos + nameSize, msg.payload.data(), payloadSize);
+    });
+}
+
+void AsyncSink::log(LogRecord const &record) {
+    RecordHeader const header{
+        record.time, record.threadId, record.loc, record.level, true, record.numArgs, 0, 0
+    };
+    auto const typesSize = record.numArgs * sizeof(LogArgType);
+    auto const valuesSize = record.numArgs * sizeof(uint64);
+    auto const size = sizeof(header) + sizeof(record.loggerName) + sizeof(record.fmt) + typesSize +
+                      valuesSize;
+    state->Push(static_cast<uint32>(size), [&](uint32 pos) {
+        state->CopyIn(pos, &header, sizeof(header));
+        pos += sizeof(header);
+        state->CopyIn(pos, &record.loggerName, sizeof(record.loggerName));
+        pos += sizeof(record.loggerName);
+        state->CopyIn(pos, &record.fmt, sizeof(record.fmt));
+        pos += sizeof(record.fmt);
+        state->CopyIn(pos, record.types, typesSize);
+        state->CopyIn(pos + typesSize, record.values, valuesSize);
+    });
+}
+
+void AsyncSink::flush() {
+    // The records before `target` are either consumed, or being written under the lock.
+    auto const target = static_cast<uint32>(state->enqueuePos.load());
+    state->Wake();
+    state->WaitConsumed([&](std::size_t count) {
+        return static_cast<int32>(static_cast<uint32>(count) - target) >= 0;
+    });
+
+    std::lock_guard guard(state->writeMutex);
+    if (state->binary)
+        state->binary->Flush();
+    for (auto const &sink : state->sinks)
+        sink->flush();
+}
+
+void AsyncSink::set_pattern(std::string const &pattern) {
+    for (auto const &sink : state->sinks)
+        sink->set_pattern(pattern);
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+    for (auto const &sink : state->sinks)
+        sink->set_formatter(formatter->clone());
+}
+
+std::size_t AsyncSink::capacity() const noexcept { return state->mask + 1; }
+
+std::size_t AsyncSink::dropped() const noexcept {
+    return state->dropped.load(std::memory_order_relaxed);
+}
+
+void LogDeferred(AsyncSink &sink, LogRecord const &record) { sink.log(record); }
+} // namespace kira::detail
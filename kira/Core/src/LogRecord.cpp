@@ -0,0 +1,209 @@
+#include "kira/detail/LogRecord.h"
+
+#include <fmt/args.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace kira::detail {
+namespace {
+constexpr std::array<char, 8> binaryLogMagic = {'K', 'R', 'R', 'L', 'O', 'G', '1', '\n'};
+
+/// The fixed part of a record in a binary file, followed by the types and the values of the
+/// arguments, the logger name, the message (or the format string), the file name and the function
+/// name.
+struct BinaryLogHeader {
+    int64 time;
+    uint64 threadId;
+    uint32 nameSize, messageSize, fileSize, functionSize;
+    int32 line;
+    uint8 level;
+    uint8 deferred;
+    uint8 numArgs;
+    uint8 padding;
+};
+
+static_assert(sizeof(BinaryLogHeader) == 40);
+
+std::string_view CStringView(char const *str) { return str ? std::string_view{str} : ""; }
+
+void Append(spdlog::memory_buf_t &buffer, void const *data, std::size_t size) {
+    auto const *bytes = static_cast<char const *>(data);
+    buffer.append(bytes, bytes + size);
+}
+
+/// Write a record into `file`, by a single call to `fwrite`.
+void WriteBinary(
+    std::FILE *file, BinaryLogHeader header, std::string_view name, std::string_view message,
+    spdlog::source_loc const &loc, LogRecord const *record
+) {
+    auto const fileName = CStringView(loc.filename), function = CStringView(loc.funcname);
+    header.nameSize = static_cast<uint32>(name.size());
+    header.messageSize = static_cast<uint32>(message.size());
+    header.fileSize = static_cast<uint32>(fileName.size());
+    header.functionSize = static_cast<uint32>(function.size());
+    header.line = loc.line;
+
+    spdlog::memory_buf_t buffer;
+    Append(buffer, &header, sizeof(header));
+    if (record) {
+        Append(buffer, record->types, header.numArgs * sizeof(LogArgType));
+        Append(buffer, record->values, header.numArgs * sizeof(uint64));
+    }
+    for (auto const str : {name, message, fileName, function})
+        Append(buffer, str.data(), str.size());
+
+    if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+        throw std::runtime_error("Failed to write into the binary log file");
+}
+
+int64 ToNanoseconds(spdlog::log_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+} // namespace
+
+void FormatLogRecord(LogRecord const &record, spdlog::memory_buf_t &out) {
+    fmt::dynamic_format_arg_store<fmt::format_context> args;
+    args.reserve(record.numArgs, 0);
+    for (std::size_t i = 0; i < record.numArgs; ++i) {
+        auto const value = record.values[i];
+        switch (record.types[i]) {
+        case LogArgType::Bool: args.push_back(value != 0); break;
+        case LogArgType::Char: args.push_back(static_cast<char>(value)); break;
+        case LogArgType::Int64: args.push_back(static_cast<int64>(value)); break;
+        case LogArgType::UInt64: args.push_back(value); break;
+        case LogArgType::Float:
+            args.push_back(std::bit_cast<float>(static_cast<uint32>(value)));
+            break;
+        case LogArgType::Double: args.push_back(std::bit_cast<double>(value)); break;
+        }
+    }
+
+    auto const size = out.size();
+    try {
+        fmt::vformat_to(fmt::appender(out), record.fmt, args);
+    } catch (fmt::format_error const &e) {
+        out.resize(size);
+        fmt::format_to(fmt::appender(out), "[kira: {} in \"{}\"]", e.what(), record.fmt);
+    }
+}
+
+BinaryLogFile::~BinaryLogFile() {
+    if (file)
+        std::fclose(file);
+}
+
+BinaryLogFile::BinaryLogFile(BinaryLogFile &&other) noexcept : file(other.file) {
+    other.file = nullptr;
+}
+
+BinaryLogFile BinaryLogFile::Create(std::filesystem::path const &path) {
+    BinaryLogFile result{std::fopen(path.string().c_str(), "wb")};
+    if (not result.file or
+        std::fwrite(binaryLogMagic.data(), 1, binaryLogMagic.size(), result.file) !=
+            binaryLogMagic.size())
+        throw std::runtime_error(
+            fmt::format("Failed to create the binary log file {}", path.string())
+        );
+    return result;
+}
+
+BinaryLogFile BinaryLogFile::Open(std::filesystem::path const &path) {
+    BinaryLogFile result{std::fopen(path.string().c_str(), "rb")};
+    if (not result.file)
+        throw std::runtime_error(
+            fmt::format("Failed to open the binary log file {}", path.string())
+        );
+
+    std::array<char, binaryLogMagic.size()> magic{};
+    if (std::fread(magic.data(), 1, magic.size(), result.file) != magic.size() or
+        magic != binaryLogMagic)
+        throw std::runtime_error(fmt::format("{} is not a binary log file", path.string()));
+    return result;
+}
+
+void BinaryLogFile::Write(LogRecord const &record) {
+    BinaryLogHeader header{};
+    header.time = ToNanoseconds(record.time);
+    header.threadId = record.threadId;
+    header.level = static_cast<uint8>(record.level);
+    header.deferred = 1;
+    header.numArgs = record.numArgs;
+    WriteBinary(file, header, record.loggerName, record.fmt, record.loc, &record);
+}
+
+void BinaryLogFile::Write(spdlog::details::log_msg const &msg) {
+    BinaryLogHeader header{};
+    header.time = ToNanoseconds(msg.time);
+    header.threadId = msg.thread_id;
+    header.level = static_cast<uint8>(msg.level);
+    WriteBinary(
+        file, header, {msg.logger_name.data(), msg.logger_name.size()},
+        {msg.payload.data(), msg.payload.size()}, msg.source, nullptr
+    );
+}
+
+std::optional<spdlog::details::log_msg> BinaryLogFile::Read(spdlog::memory_buf_t &buffer) {
+    BinaryLogHeader header{};
+    if (auto const count = std::fread(&header, 1, sizeof(header), file); count != sizeof(header)) {
+        if (count == 0 and std::feof(file))
+            return std::nullopt;
+        throw std::runtime_error("The binary log file is truncated");
+    }
+
+    auto const read = [&](void *data, std::size_t size) {
+        if (std::fread(data, 1, size, file) != size)
+            throw std::runtime_error("The binary log file is truncated");
+    };
+
+    LogRecord record{};
+    if (header.numArgs > LogRecord::maxArgs)
+        throw std::runtime_error("The binary log file is corrupted");
+    record.numArgs = header.numArgs;
+    read(record.types, header.numArgs * sizeof(LogArgType));
+    read(record.values, header.numArgs * sizeof(uint64));
+
+    // The strings, where the file name and the function name are terminated by '\0' for spdlog.
+    std::string strings(header.nameSize + header.messageSize, '\0');
+    read(strings.data(), strings.size());
+    buffer.clear();
+    buffer.resize(header.fileSize + header.functionSize + 2);
+    read(buffer.data(), header.fileSize);
+    buffer[header.fileSize] = '\0';
+    read(buffer.data() + header.fileSize + 1, header.functionSize);
+    buffer[header.fileSize + header.functionSize + 1] = '\0';
+
+    auto const name = std::string_view{strings}.substr(0, header.nameSize);
+    auto const message = std::string_view{strings}.substr(header.nameSize);
+    auto const nameOffset = buffer.size();
+    Append(buffer, name.data(), name.size());
+    auto const messageOffset = buffer.size();
+    if (header.deferred) {
+        record.fmt = message;
+        FormatLogRecord(record, buffer);
+    } else {
+        Append(buffer, message.data(), message.size());
+    }
+
+    // Referred to only after the buffer is filled, which may reallocate.
+    auto const *data = buffer.data();
+    spdlog::source_loc const loc{
+        data, header.line, header.functionSize != 0 ? data + header.fileSize + 1 : nullptr
+    };
+    spdlog::details::log_msg msg{
+        spdlog::log_clock::time_point{std::chrono::duration_cast<spdlog::log_clock::duration>(
+            std::chrono::nanoseconds{header.time}
+        )},
+        header.fileSize != 0 ? loc : spdlog::source_loc{},
+        spdlog::string_view_t{data + nameOffset, header.nameSize},
+        static_cast<spdlog::level::level_enum>(header.level),
+        spdlog::string_view_t{data + messageOffset, buffer.size() - messageOffset}
+    };
+    msg.thread_id = header.threadId;
+    return msg;
+}
+
+void BinaryLogFile::Flush() { std::fflush(file); }
+} // namespace kira::detail
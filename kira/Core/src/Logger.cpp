@@ -4,7 +4,13 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include "kira/FlatHashMap.h"
+#include "kira/MemoryTracker.h"
 #include "kira/SmallVector.h"
+#include "kira/detail/AsyncSink.h"
+
+#include <algorithm>
+#include <mutex>
 
 #if _WIN32
 #include <Windows.h>
@@ -45,6 +51,62 @@ bool SinkManager::DropFileSink(std::filesystem::path const &path) noexcept {
     return false;
 }
 
+namespace {
+/// The slots of the cached loggers, by the names.
+struct LoggerSlots {
+    std::mutex mutex;
+    FlatHashMap<std::string, SmallVector<LoggerSlot *>> slots;
+
+    static LoggerSlots &GetInstance() {
+        // Leaked, since the loggers still in the registry of spdlog reset their slots at exit.
+        static auto *instance = new LoggerSlots;
+        return *instance;
+    }
+};
+} // namespace
+
+spdlog::logger *ResolveLogger(std::string const &name, LoggerSlot *slot) {
+    static std::mutex mutex;
+
+    // Released after the lock, since the last reference destroys the logger, which resets the
+    // slots.
+    std::shared_ptr<spdlog::logger> logger;
+    std::lock_guard guard(mutex);
+    logger = spdlog::get(name);
+    if (KIRA_UNLIKELY(not logger))
+        logger = LoggerBuilder{name}.init();
+
+    if (auto *cached = dynamic_cast<CachedLogger *>(logger.get()); slot && cached) {
+        auto &instance = LoggerSlots::GetInstance();
+        std::lock_guard slotsGuard(instance.mutex);
+        auto &slots = instance.slots[name];
+        if (std::find(slots.begin(), slots.end(), slot) == slots.end())
+            slots.push_back(slot);
+        // Published by the logger, which is loaded first.
+        slot->deferred.store(cached->deferredSink, std::memory_order_relaxed);
+        slot->logger.store(logger.get(), std::memory_order_release);
+    }
+    return logger.get();
+}
+
+void ResetLoggerSlots(std::string const &name, spdlog::logger const *logger) noexcept {
+    auto &instance = LoggerSlots::GetInstance();
+    std::lock_guard guard(instance.mutex);
+    auto const it = instance.slots.find(name);
+    if (it == instance.slots.end())
+        return;
+
+    for (auto *slot : it->second) {
+        // Another logger of the name may have been cached already.
+        auto *expected = const_cast<spdlog::logger *>(logger);
+        if (logger and
+            not slot->logger.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed))
+            continue;
+        slot->logger.store(nullptr, std::memory_order_relaxed);
+        slot->deferred.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
 bool SinkManager::DropAllSinks() noexcept {
     auto const changed = consoleSink.get() != nullptr || !fileSinks.empty();
     consoleSink.reset();
@@ -82,6 +144,7 @@ std::string safe_getenv(char const *name) {
 } // namespace
 
 std::shared_ptr<spdlog::logger> LoggerBuilder::init() const {
+    KIRA_MEMORY_SCOPE("Logger");
     auto &sinkManager = detail::SinkManager::GetInstance();
     SmallVector<spdlog::sink_ptr> sinks;
 
@@ -89,20 +152,29 @@ std::shared_ptr<spdlog::logger> LoggerBuilder::init() const {
         sinks.push_back(sinkManager.CreateConsoleSink());
     if (path)
         sinks.push_back(sinkManager.CreateFileSink(path.value()));
+
+    std::shared_ptr<detail::AsyncSink> asyncSink;
+    if (queueSize != 0 or deferFormatting or binaryPath) {
+        asyncSink = std::make_shared<detail::AsyncSink>(
+            std::span{sinks.data(), sinks.size()}, queueSize != 0 ? queueSize : defaultQueueSize,
+            overflowPolicy, binaryPath
+        );
+        sinks.clear();
+        sinks.push_back(asyncSink);
+    }
     if (not level) {
         if (auto const envVal = safe_getenv("KRR_LOG_LEVEL"); !envVal.empty())
             spdlog::cfg::helpers::load_levels(envVal);
     }
 
-    auto logger = std::make_shared<spdlog::logger>(std::string{name}, sinks.begin(), sinks.end());
+    auto logger =
+        std::make_shared<detail::CachedLogger>(std::string{name}, sinks.begin(), sinks.end());
+    if (deferFormatting)
+        logger->deferredSink = asyncSink.get();
 
     try {
         spdlog::initialize_logger(logger);
-#ifdef NDEBUG
-        logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v");
-#else
-        logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] [%s:%#] %v");
-#endif
+        logger->set_pattern(std::string{detail::loggerPattern});
     } catch (std::exception const &e) {
         auto const str = fmt::format("kira: Failed to initialize logger: {}\n", e.what());
         fmt::print(stderr, "{:s}", str);
@@ -113,6 +185,9 @@ std::shared_ptr<spdlog::logger> LoggerBuilder::init() const {
     // Override the environment variable if the level is set.
     if (level)
         logger->set_level(level.value());
+
+    // The loggers of the name cached before are replaced by this one.
+    detail::ResetLoggerSlots(logger->name());
     return logger;
 }
 } // namespace kira
@@ -0,0 +1,422 @@
+#include "kira/MemoryTracker.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "kira/Compiler.h"
+#include "kira/Logger.h"
+
+namespace kira {
+namespace {
+constexpr std::size_t maxMemoryCategories = 64;
+
+/// The counters of a category in a thread, which are only written by the thread.
+struct ThreadCategoryCounters {
+    std::atomic<uint64> allocations{0};
+    std::atomic<uint64> deallocations{0};
+    std::atomic<uint64> allocatedBytes{0};
+};
+
+/// The counters of a thread, linked into the registry until the thread exits.
+struct ThreadMemory {
+    std::array<ThreadCategoryCounters, maxMemoryCategories> counters;
+    ThreadMemory *prev{nullptr}, *next{nullptr};
+};
+
+/// The counters of a category shared by the threads.
+struct alignas(64) CategoryState {
+    std::atomic<int64> liveBytes{0};
+    std::atomic<int64> peakBytes{0};
+    std::atomic<int64> framePeakBytes{0};
+
+    // The counters of the threads which exited.
+    std::atomic<uint64> allocations{0};
+    std::atomic<uint64> deallocations{0};
+    std::atomic<uint64> allocatedBytes{0};
+};
+
+/// The allocations of a category, summed over the threads.
+struct CategoryTotals {
+    uint64 allocations{0}, deallocations{0}, allocatedBytes{0};
+};
+
+struct MemoryRegistry {
+    std::array<CategoryState, maxMemoryCategories> categories;
+
+    // The threads, and the categories, each under its own lock, s.t. registering a category may
+    // allocate.
+    std::mutex threadMutex;
+    ThreadMemory *threads{nullptr};
+    std::mutex categoryMutex;
+    std::array<std::string, maxMemoryCategories> names;
+    std::size_t numCategories{1};
+
+    // The totals at the end of the last two frames.
+    std::array<CategoryTotals, maxMemoryCategories> frameBegin, frameEnd;
+    std::array<int64, maxMemoryCategories> framePeakBytes{};
+
+    MemoryRegistry() { names[0] = "other"; }
+
+    static MemoryRegistry &GetInstance() {
+        // Constructed in place, since `operator new` is tracked by it, and leaked, since the
+        // allocations go on while the statics are destroyed.
+        alignas(MemoryRegistry) static std::byte storage[sizeof(MemoryRegistry)];
+        static auto *instance = new (storage) MemoryRegistry;
+        return *instance;
+    }
+
+    /// Sum the counters of the categories over the threads.
+    void Sum(std::array<CategoryTotals, maxMemoryCategories> &totals) {
+        std::lock_guard guard(threadMutex);
+        for (std::size_t i = 0; i < maxMemoryCategories; ++i) {
+            totals[i].allocations = categories[i].allocations.load(std::memory_order_relaxed);
+            totals[i].deallocations = categories[i].deallocations.load(std::memory_order_relaxed);
+            totals[i].allocatedBytes =
+                categories[i].allocatedBytes.load(std::memory_order_relaxed);
+        }
+        for (auto const *thread = threads; thread; thread = thread->next)
+            for (std::size_t i = 0; i < maxMemoryCategories; ++i) {
+                auto const &counters = thread->counters[i];
+                totals[i].allocations += counters.allocations.load(std::memory_order_relaxed);
+                totals[i].deallocations += counters.deallocations.load(std::memory_order_relaxed);
+                totals[i].allocatedBytes +=
+                    counters.allocatedBytes.load(std::memory_order_relaxed);
+            }
+    }
+};
+
+thread_local uint32 thisMemoryCategory = 0;
+
+#if KIRA_ENABLE_MEMORY_TRACKER
+void Increment(std::atomic<uint64> &counter, uint64 value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void UpdateMax(std::atomic<int64> &max, int64 value) noexcept {
+    auto current = max.load(std::memory_order_relaxed);
+    while (value > current and
+           not max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+}
+
+thread_local ThreadMemory *thisThreadMemory = nullptr;
+thread_local bool thisThreadMemoryRetired = false;
+
+/// Fold the counters of the calling thread into the categories, as it exits.
+struct ThreadMemoryGuard {
+    ~ThreadMemoryGuard() {
+        auto &registry = MemoryRegistry::GetInstance();
+        auto *memory = std::exchange(thisThreadMemory, nullptr);
+        thisThreadMemoryRetired = true;
+
+        std::lock_guard guard(registry.threadMutex);
+        for (std::size_t i = 0; i < maxMemoryCategories; ++i) {
+            auto const &counters = memory->counters[i];
+            auto &category = registry.categories[i];
+            category.allocations.fetch_add(counters.allocations.load(std::memory_order_relaxed));
+            category.deallocations.fetch_add(
+                counters.deallocations.load(std::memory_order_relaxed)
+            );
+            category.allocatedBytes.fetch_add(
+                counters.allocatedBytes.load(std::memory_order_relaxed)
+            );
+        }
+        (memory->prev ? memory->prev->next : registry.threads) = memory->next;
+        if (memory->next)
+            memory->next->prev = memory->prev;
+        memory->~ThreadMemory();
+        std::free(memory);
+    }
+};
+
+/// The counters of the calling thread, or null once it exits.
+ThreadMemory *GetThisThreadMemory() noexcept {
+    if (KIRA_LIKELY(thisThreadMemory) or thisThreadMemoryRetired)
+        return thisThreadMemory;
+
+    // Not by `operator new`, which is being tracked.
+    auto *storage = std::malloc(sizeof(ThreadMemory));
+    if (not storage)
+        return nullptr;
+    auto *memory = new (storage) ThreadMemory;
+
+    auto &registry = MemoryRegistry::GetInstance();
+    {
+        std::lock_guard guard(registry.threadMutex);
+        memory->next = registry.threads;
+        if (registry.threads)
+            registry.threads->prev = memory;
+        registry.threads = memory;
+    }
+    thisThreadMemory = memory;
+    thread_local ThreadMemoryGuard guard;
+    static_cast<void>(guard);
+    return memory;
+}
+
+void RecordAllocation(uint32 category, std::size_t size) noexcept {
+    auto &state = MemoryRegistry::GetInstance().categories[category];
+    if (auto *memory = GetThisThreadMemory()) {
+        Increment(memory->counters[category].allocations, 1);
+        Increment(memory->counters[category].allocatedBytes, size);
+    } else {
+        state.allocations.fetch_add(1, std::memory_order_relaxed);
+        state.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    auto const live =
+        state.liveBytes.fetch_add(static_cast<int64>(size), std::memory_order_relaxed) +
+        static_cast<int64>(size);
+    UpdateMax(state.peakBytes, live);
+    UpdateMax(state.framePeakBytes, live);
+}
+
+void RecordDeallocation(uint32 category, std::size_t size) noexcept {
+    auto &state = MemoryRegistry::GetInstance().categories[category];
+    if (auto *memory = GetThisThreadMemory())
+        Increment(memory->counters[category].deallocations, 1);
+    else
+        state.deallocations.fetch_add(1, std::memory_order_relaxed);
+    state.liveBytes.fetch_sub(static_cast<int64>(size), std::memory_order_relaxed);
+}
+
+/// The header in front of each tracked allocation.
+struct AllocationHeader {
+    std::size_t size;
+    uint32 category;
+    uint32 offset;
+};
+
+constexpr std::size_t headerSize = 16;
+static_assert(sizeof(AllocationHeader) <= headerSize);
+
+AllocationHeader &GetHeader(void *ptr) noexcept {
+    return *std::launder(
+        reinterpret_cast<AllocationHeader *>(static_cast<std::byte *>(ptr) - headerSize)
+    );
+}
+
+/// Allocate `size` bytes aligned to `alignment`, after the header, which is aligned as well.
+void *Allocate(std::size_t size, std::size_t alignment) noexcept {
+    auto const offset = std::max(headerSize, alignment);
+    if (size > std::numeric_limits<std::size_t>::max() - 2 * offset)
+        return nullptr;
+
+#if defined(_WIN32)
+    auto *base = _aligned_malloc(size + offset, offset);
+#else
+    auto *base = alignment <= headerSize
+                     ? std::malloc(size + offset)
+                     : std::aligned_alloc(offset, (size + 2 * offset - 1) / offset * offset);
+#endif
+    if (not base)
+        return nullptr;
+
+    auto *ptr = static_cast<std::byte *>(base) + offset;
+    auto const category = thisMemoryCategory;
+    new (ptr - headerSize) AllocationHeader{size, category, static_cast<uint32>(offset)};
+    RecordAllocation(category, size);
+    return ptr;
+}
+
+void Deallocate(void *ptr) noexcept {
+    if (not ptr)
+        return;
+    auto const header = GetHeader(ptr);
+    RecordDeallocation(header.category, header.size);
+#if defined(_WIN32)
+    _aligned_free(static_cast<std::byte *>(ptr) - header.offset);
+#else
+    std::free(static_cast<std::byte *>(ptr) - header.offset);
+#endif
+}
+
+void *AllocateOrThrow(std::size_t size, std::size_t alignment) {
+    while (true) {
+        if (auto *ptr = Allocate(size, alignment))
+            return ptr;
+        auto const handler = std::get_new_handler();
+        if (not handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+#endif
+} // namespace
+
+namespace detail {
+uint32 RegisterMemoryCategory(std::string_view name) {
+    auto &registry = MemoryRegistry::GetInstance();
+    std::lock_guard guard(registry.categoryMutex);
+    auto const first = registry.names.begin();
+    auto const last = first + static_cast<std::ptrdiff_t>(registry.numCategories);
+    if (auto const it = std::find(first, last, name); it != last)
+        return static_cast<uint32>(it - first);
+    if (registry.numCategories == maxMemoryCategories)
+        return 0;
+    registry.names[registry.numCategories] = name;
+    return static_cast<uint32>(registry.numCategories++);
+}
+
+uint32 SetMemoryCategory(uint32 category) noexcept {
+    return std::exchange(thisMemoryCategory, category);
+}
+
+#if KIRA_ENABLE_MEMORY_TRACKER
+void *TrackedMalloc(std::size_t size) noexcept { return Allocate(size, headerSize); }
+
+void *TrackedRealloc(void *ptr, std::size_t size) noexcept {
+    if (not ptr)
+        return TrackedMalloc(size);
+
+    // Allocated by `TrackedMalloc()`, whose header is the offset.
+    auto const header = GetHeader(ptr);
+    if (size > std::numeric_limits<std::size_t>::max() - headerSize)
+        return nullptr;
+#if defined(_WIN32)
+    auto *base = _aligned_realloc(static_cast<std::byte *>(ptr) - headerSize, size + headerSize,
+                                  headerSize);
+#else
+    auto *base = std::realloc(static_cast<std::byte *>(ptr) - headerSize, size + headerSize);
+#endif
+    if (not base)
+        return nullptr;
+
+    RecordDeallocation(header.category, header.size);
+    auto *newPtr = static_cast<std::byte *>(base) + headerSize;
+    auto const category = thisMemoryCategory;
+    new (newPtr - headerSize) AllocationHeader{size, category, static_cast<uint32>(headerSize)};
+    RecordAllocation(category, size);
+    return newPtr;
+}
+
+void TrackedFree(void *ptr) noexcept { Deallocate(ptr); }
+#endif
+} // namespace detail
+
+std::vector<MemoryCategoryStats> GetMemoryStats() {
+    if constexpr (not memoryTrackerEnabled)
+        return {};
+
+    // Not attributed to the category of the caller.
+    static MemoryCategory const other{"other"};
+    MemoryScope const scope{other};
+
+    auto &registry = MemoryRegistry::GetInstance();
+    std::vector<MemoryCategoryStats> result(maxMemoryCategories);
+    std::array<CategoryTotals, maxMemoryCategories> totals;
+    registry.Sum(totals);
+
+    std::lock_guard guard(registry.categoryMutex);
+    result.resize(registry.numCategories);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        auto &stats = result[i];
+        auto const &state = registry.categories[i];
+        stats.name = registry.names[i];
+        stats.liveBytes = state.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = state.peakBytes.load(std::memory_order_relaxed);
+        stats.allocations = totals[i].allocations;
+        stats.deallocations = totals[i].deallocations;
+        stats.allocatedBytes = totals[i].allocatedBytes;
+        stats.frameAllocations =
+            registry.frameEnd[i].allocations - registry.frameBegin[i].allocations;
+        stats.frameAllocatedBytes =
+            registry.frameEnd[i].allocatedBytes - registry.frameBegin[i].allocatedBytes;
+        stats.framePeakBytes = registry.framePeakBytes[i];
+    }
+    return result;
+}
+
+void MarkMemoryFrame() {
+    if constexpr (not memoryTrackerEnabled)
+        return;
+
+    auto &registry = MemoryRegistry::GetInstance();
+    std::array<CategoryTotals, maxMemoryCategories> totals;
+    registry.Sum(totals);
+
+    std::lock_guard guard(registry.categoryMutex);
+    registry.frameBegin = std::exchange(registry.frameEnd, totals);
+    for (std::size_t i = 0; i < maxMemoryCategories; ++i) {
+        auto &state = registry.categories[i];
+        registry.framePeakBytes[i] = state.framePeakBytes.exchange(
+            state.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed
+        );
+    }
+}
+
+void LogMemoryStats() {
+    if constexpr (not memoryTrackerEnabled) {
+        LogWarn("Memory: The allocations are not tracked, see `KRR_ENABLE_MEMORY_TRACKER`");
+        return;
+    }
+
+    constexpr double KiB = 1024.0;
+    LogInfo(
+        "{:<24s} {:>12s} {:>12s} {:>12s} {:>14s} {:>14s} {:>14s}", "category", "live (KiB)",
+        "peak (KiB)", "allocations", "frame allocs", "frame (KiB)", "frame peak"
+    );
+    for (auto const &stats : GetMemoryStats())
+        LogInfo(
+            "{:<24s} {:>12.1f} {:>12.1f} {:>12d} {:>14d} {:>14.1f} {:>14.1f}", stats.name,
+            static_cast<double>(stats.liveBytes) / KiB, static_cast<double>(stats.peakBytes) / KiB,
+            stats.allocations, stats.frameAllocations,
+            static_cast<double>(stats.frameAllocatedBytes) / KiB,
+            static_cast<double>(stats.framePeakBytes) / KiB
+        );
+}
+} // namespace kira
+
+#if KIRA_ENABLE_MEMORY_TRACKER
+// NOLINTBEGIN
+void *operator new(std::size_t size) {
+    return kira::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new[](std::size_t size) {
+    return kira::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return kira::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return kira::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept {
+    return kira::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+    return kira::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return kira::Allocate(size, static_cast<std::size_t>(alignment));
+}
+void *
+operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return kira::Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept { kira::Deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { kira::Deallocate(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { kira::Deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { kira::Deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { kira::Deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { kira::Deallocate(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { kira::Deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { kira::Deallocate(ptr); }
+void operator delete(void *ptr, std::nothrow_t const &) noexcept { kira::Deallocate(ptr); }
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept { kira::Deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t, std::nothrow_t const &) noexcept {
+    kira::Deallocate(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t, std::nothrow_t const &) noexcept {
+    kira::Deallocate(ptr);
+}
+// NOLINTEND
+#endif
@@ -0,0 +1,463 @@
+#include "kira/Profiler.h"
+
+#include <spdlog/details/os.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "kira/Logger.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace kira {
+namespace {
+/// A zone, recorded when it is closed.
+struct ProfileEvent {
+    char const *name;
+    uint64 begin, end;
+    uint64 self;
+    uint8 counterMask;
+    std::array<uint64, numProfileCounters> counters;
+};
+
+/// The chunk of the buffer of a thread, whose events before `count` are written.
+struct ProfileChunk {
+    static constexpr std::size_t capacity = 4096;
+
+    std::atomic<std::size_t> count{0};
+    std::atomic<ProfileChunk *> next{nullptr};
+    ProfileEvent events[capacity];
+};
+
+/// The chunks of a thread at most, i.e., 1M zones.
+constexpr std::size_t maxProfileChunks = 256;
+
+void FreeChunks(ProfileChunk *chunk) {
+    while (chunk)
+        delete std::exchange(chunk, chunk->next.load(std::memory_order_relaxed));
+}
+
+/// The buffer of a thread, which is only appended to by the thread.
+struct ProfileThread {
+    explicit ProfileThread(std::size_t threadId) noexcept : threadId(threadId) {}
+    ~ProfileThread() { FreeChunks(head.next.load(std::memory_order_relaxed)); }
+
+    /// Append `event`, or return false if the buffer is full.
+    bool Push(ProfileEvent const &event) noexcept {
+        auto count = tail->count.load(std::memory_order_relaxed);
+        if (count == ProfileChunk::capacity) {
+            auto *next = numChunks < maxProfileChunks ? new (std::nothrow) ProfileChunk : nullptr;
+            if (not next)
+                return false;
+            // Published after it is constructed, s.t. the readers see an empty chunk.
+            tail->next.store(next, std::memory_order_release);
+            tail = next;
+            ++numChunks;
+            count = 0;
+        }
+        tail->events[count] = event;
+        tail->count.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Visit the events written so far, from any thread.
+    template <typename F> void ForEach(F const &visit) const {
+        auto const *chunk = &head;
+        for (; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            auto const count = chunk->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i)
+                visit(chunk->events[i]);
+        }
+    }
+
+    /// Discard the events, while the thread records none.
+    void Clear() noexcept {
+        FreeChunks(head.next.exchange(nullptr, std::memory_order_relaxed));
+        head.count.store(0, std::memory_order_relaxed);
+        tail = &head;
+        numChunks = 1;
+    }
+
+    std::size_t const threadId;
+    ProfileScope *current{nullptr};
+    ProfileChunk head;
+    ProfileChunk *tail{&head};
+    std::size_t numChunks{1};
+};
+
+struct ProfileRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileThread>> threads;
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<bool> countersEnabled{false};
+    uint64 const startTicks{detail::ReadProfileClock()};
+    std::chrono::steady_clock::time_point const startTime{std::chrono::steady_clock::now()};
+
+    static ProfileRegistry &GetInstance() {
+        // Leaked, since the threads may still record zones while the statics are destroyed.
+        static auto *instance = new ProfileRegistry;
+        return *instance;
+    }
+
+    /// The threads which recorded a zone so far.
+    std::vector<ProfileThread const *> GetThreads() {
+        std::lock_guard guard(mutex);
+        std::vector<ProfileThread const *> result;
+        result.reserve(threads.size());
+        for (auto const &thread : threads)
+            result.push_back(thread.get());
+        return result;
+    }
+
+    /// The nanoseconds per tick of the clock of the profiler.
+    [[nodiscard]] double NanosecondsPerTick() const {
+#if defined(__x86_64__) || defined(_M_X64)
+        // Measured since the start, which is precise enough past a few milliseconds.
+        constexpr auto minInterval = std::chrono::milliseconds(10);
+        auto const elapsed = std::chrono::steady_clock::now() - startTime;
+        if (elapsed < minInterval)
+            std::this_thread::sleep_for(minInterval - elapsed);
+        auto const ticks = detail::ReadProfileClock() - startTicks;
+        auto const time = std::chrono::steady_clock::now() - startTime;
+        return std::chrono::duration<double, std::nano>(time).count() / static_cast<double>(ticks);
+#else
+        return 1.0;
+#endif
+    }
+};
+
+thread_local ProfileThread *thisProfileThread = nullptr;
+
+constexpr std::array<std::string_view, numProfileCounters> profileCounterNames = {
+    "cycles", "instructions", "L1D misses", "LLC misses", "branch misses"
+};
+
+/// The hardware counters of a thread, opened as a group s.t. they are read at once.
+class ProfileCounters {
+public:
+    ProfileCounters() = default;
+    ProfileCounters(ProfileCounters const &) = delete;
+    ProfileCounters &operator=(ProfileCounters const &) = delete;
+    ~ProfileCounters() { Close(); }
+
+    /// Open the counters of the calling thread, or return the error if none can be.
+    int Open() noexcept {
+#if defined(__linux__)
+        constexpr uint64 l1dReadMiss = PERF_COUNT_HW_CACHE_L1D |
+                                       PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                                       PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+        constexpr std::array<std::pair<uint32, uint64>, numProfileCounters> configs = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, l1dReadMiss},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+        // The counters which cannot be opened, e.g., not supported by the PMU, are left out.
+        int error = 0;
+        for (std::size_t i = 0; i < numProfileCounters; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = configs[i].first;
+            attr.config = configs[i].second;
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.disabled = leader == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            auto const fd = static_cast<int>(
+                syscall(SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC)
+            );
+            if (fd == -1) {
+                error = errno;
+                continue;
+            }
+            if (leader == -1)
+                leader = fd;
+            fds[numOpened] = fd;
+            order[numOpened++] = static_cast<uint8>(i);
+            mask |= static_cast<uint8>(1U << i);
+        }
+
+        if (leader == -1)
+            return error;
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return 0;
+#else
+        return ENOSYS;
+#endif
+    }
+
+    /// Read the counters into `values`, by `ProfileCounter`.
+    [[nodiscard]] bool Read(std::array<uint64, numProfileCounters> &values) const noexcept {
+#if defined(__linux__)
+        // See `PERF_FORMAT_GROUP`, the values follow the number of them in the order of opening.
+        std::array<uint64, numProfileCounters + 1> buffer;
+        auto const size = static_cast<ssize_t>((numOpened + 1) * sizeof(uint64));
+        if (read(leader, buffer.data(), static_cast<std::size_t>(size)) != size)
+            return false;
+        for (std::size_t i = 0; i < numOpened; ++i)
+            values[order[i]] = buffer[i + 1];
+        return true;
+#else
+        static_cast<void>(values);
+        return false;
+#endif
+    }
+
+    [[nodiscard]] uint8 GetMask() const noexcept { return mask; }
+
+private:
+    void Close() noexcept {
+#if defined(__linux__)
+        for (std::size_t i = 0; i < numOpened; ++i)
+            close(fds[i]);
+#endif
+        numOpened = 0;
+        leader = -1;
+        mask = 0;
+    }
+
+    int leader{-1};
+    std::size_t numOpened{0};
+    std::array<int, numProfileCounters> fds{};
+    std::array<uint8, numProfileCounters> order{};
+    uint8 mask{0};
+};
+
+/// The counters of the calling thread, opened on the first zone, and closed when it exits.
+struct ThisProfileCounters {
+    bool opened{false};
+    ProfileCounters counters;
+};
+
+thread_local ThisProfileCounters thisProfileCounters;
+
+/// The counters of the calling thread, if they are read.
+ProfileCounters const *GetThisProfileCounters() noexcept {
+    if (not ProfileRegistry::GetInstance().countersEnabled.load(std::memory_order_relaxed))
+        return nullptr;
+    if (KIRA_UNLIKELY(not thisProfileCounters.opened)) {
+        thisProfileCounters.opened = true;
+        thisProfileCounters.counters.Open();
+    }
+    return thisProfileCounters.counters.GetMask() != 0 ? &thisProfileCounters.counters : nullptr;
+}
+
+ProfileThread &GetThisProfileThread() {
+    if (KIRA_UNLIKELY(not thisProfileThread)) {
+        auto &registry = ProfileRegistry::GetInstance();
+        auto thread = std::make_unique<ProfileThread>(spdlog::details::os::thread_id());
+        std::lock_guard guard(registry.mutex);
+        thisProfileThread = registry.threads.emplace_back(std::move(thread)).get();
+    }
+    return *thisProfileThread;
+}
+
+/// Write `str` as a JSON string.
+void WriteJsonString(std::FILE *file, std::string_view str) {
+    std::fputc('"', file);
+    for (char const c : str) {
+        if (c == '"' or c == '\\')
+            fmt::print(file, "\\{}", c);
+        else if (static_cast<unsigned char>(c) < 0x20)
+            fmt::print(file, "\\u{:04x}", static_cast<int>(c));
+        else
+            std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+} // namespace
+
+void ProfileScope::Enter() noexcept {
+    auto &thread = GetThisProfileThread();
+    parent = std::exchange(thread.current, this);
+    if (auto const *profileCounters = GetThisProfileCounters())
+        counted = profileCounters->Read(counters);
+}
+
+void ProfileScope::Leave(uint64 end) noexcept {
+    ProfileEvent event{name, begin, end, 0, 0, {}};
+    if (counted and thisProfileCounters.counters.Read(event.counters)) {
+        event.counterMask = thisProfileCounters.counters.GetMask();
+        for (std::size_t i = 0; i < numProfileCounters; ++i)
+            event.counters[i] -= counters[i];
+    }
+
+    auto &thread = *thisProfileThread;
+    thread.current = parent;
+
+    auto const elapsed = end - begin;
+    if (parent)
+        parent->children += elapsed;
+    event.self = elapsed - std::min(children, elapsed);
+    if (not thread.Push(event))
+        ProfileRegistry::GetInstance().dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<ProfileZoneSummary> GetProfileSummary() {
+    auto &registry = ProfileRegistry::GetInstance();
+    auto const msPerTick = registry.NanosecondsPerTick() * 1e-6;
+
+    std::unordered_map<std::string_view, ProfileZoneSummary> zones;
+    for (auto const *thread : registry.GetThreads()) {
+        thread->ForEach([&](ProfileEvent const &event) {
+            auto const ms = static_cast<double>(event.end - event.begin) * msPerTick;
+            auto &zone = zones[event.name];
+            if (zone.count == 0) {
+                zone.name = event.name;
+                zone.minMs = zone.maxMs = ms;
+            }
+            ++zone.count;
+            zone.totalMs += ms;
+            zone.selfMs += static_cast<double>(event.self) * msPerTick;
+            zone.minMs = std::min(zone.minMs, ms);
+            zone.maxMs = std::max(zone.maxMs, ms);
+            zone.counterMask |= event.counterMask;
+            for (std::size_t i = 0; i < numProfileCounters; ++i)
+                if (event.counterMask >> i & 1)
+                    zone.counters[i] += event.counters[i];
+        });
+    }
+
+    std::vector<ProfileZoneSummary> result;
+    result.reserve(zones.size());
+    for (auto const &[name, zone] : zones)
+        result.push_back(zone);
+    std::ranges::sort(result, [](auto const &lhs, auto const &rhs) {
+        return lhs.totalMs != rhs.totalMs ? lhs.totalMs > rhs.totalMs : lhs.name < rhs.name;
+    });
+    return result;
+}
+
+void LogProfileSummary() {
+    auto const zones = GetProfileSummary();
+    LogInfo("Profile: {:d} zones", zones.size());
+    if (auto const dropped = GetProfileDropped(); dropped != 0)
+        LogWarn("Profile: {:d} zones are dropped, since the buffers are full", dropped);
+
+    LogInfo(
+        "{:<40s} {:>10s} {:>12s} {:>12s} {:>10s} {:>10s}", "zone", "count", "total (ms)",
+        "self (ms)", "mean (us)", "max (us)"
+    );
+    for (auto const &zone : zones)
+        LogInfo(
+            "{:<40s} {:>10d} {:>12.3f} {:>12.3f} {:>10.3f} {:>10.3f}", zone.name, zone.count,
+            zone.totalMs, zone.selfMs, zone.totalMs * 1e3 / static_cast<double>(zone.count),
+            zone.maxMs * 1e3
+        );
+
+    if (std::ranges::none_of(zones, [](auto const &zone) { return zone.counterMask != 0; }))
+        return;
+    LogInfo(
+        "{:<40s} {:>10s} {:>12s} {:>12s} {:>12s}", "zone", "IPC", "L1D MPKI", "LLC MPKI",
+        "branch MPKI"
+    );
+    for (auto const &zone : zones)
+        LogInfo(
+            "{:<40s} {:>10.3f} {:>12.3f} {:>12.3f} {:>12.3f}", zone.name, zone.GetIpc(),
+            zone.GetMpki(ProfileCounter::L1DMisses), zone.GetMpki(ProfileCounter::LLCMisses),
+            zone.GetMpki(ProfileCounter::BranchMisses)
+        );
+}
+
+void WriteChromeTrace(std::filesystem::path const &path) {
+    auto &registry = ProfileRegistry::GetInstance();
+    auto const usPerTick = registry.NanosecondsPerTick() * 1e-3;
+
+    auto const close = [](std::FILE *file) { std::fclose(file); };
+    std::unique_ptr<std::FILE, decltype(close)> file{
+        std::fopen(path.string().c_str(), "wb"), close
+    };
+    if (not file)
+        throw std::runtime_error(fmt::format("Failed to create the trace file {}", path.string()));
+
+    auto const pid = spdlog::details::os::pid();
+    bool first = true;
+    std::fputs(R"({"displayTimeUnit":"ns","traceEvents":[)", file.get());
+    for (auto const *thread : registry.GetThreads()) {
+        thread->ForEach([&](ProfileEvent const &event) {
+            auto const begin = static_cast<int64>(event.begin - registry.startTicks);
+            std::fputs(first ? "\n{\"name\":" : ",\n{\"name\":", file.get());
+            WriteJsonString(file.get(), event.name);
+            fmt::print(
+                file.get(),
+                R"(,"cat":"kira","ph":"X","pid":{},"tid":{},"ts":{:.3f},"dur":{:.3f})", pid,
+                thread->threadId, static_cast<double>(begin) * usPerTick,
+                static_cast<double>(event.end - event.begin) * usPerTick
+            );
+            if (event.counterMask != 0) {
+                char separator = '{';
+                std::fputs(",\"args\":", file.get());
+                for (std::size_t i = 0; i < numProfileCounters; ++i)
+                    if (event.counterMask >> i & 1)
+                        fmt::print(
+                            file.get(), "{}\"{}\":{}", std::exchange(separator, ','),
+                            profileCounterNames[i], event.counters[i]
+                        );
+                std::fputc('}', file.get());
+            }
+            std::fputc('}', file.get());
+            first = false;
+        });
+    }
+    std::fputs("\n]}\n", file.get());
+
+    if (std::ferror(file.get()) or std::fclose(file.release()) != 0)
+        throw std::runtime_error(fmt::format("Failed to write the trace file {}", path.string()));
+}
+
+bool EnableProfileCounters(bool enable) {
+    auto &registry = ProfileRegistry::GetInstance();
+    if (not enable) {
+        registry.countersEnabled.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Probed on the calling thread, whose counters are then kept for its zones.
+    if (not thisProfileCounters.opened) {
+        thisProfileCounters.opened = true;
+        if (auto const error = thisProfileCounters.counters.Open(); error != 0) {
+            LogWarn(
+                "Profile: The hardware counters are unavailable: {:s}, see "
+                "/proc/sys/kernel/perf_event_paranoid",
+                std::strerror(error)
+            );
+            return false;
+        }
+    }
+    if (thisProfileCounters.counters.GetMask() == 0)
+        return false;
+    registry.countersEnabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t GetProfileDropped() noexcept {
+    return ProfileRegistry::GetInstance().dropped.load(std::memory_order_relaxed);
+}
+
+void ClearProfile() {
+    auto &registry = ProfileRegistry::GetInstance();
+    std::lock_guard guard(registry.mutex);
+    for (auto const &thread : registry.threads)
+        thread->Clear();
+    registry.dropped.store(0, std::memory_order_relaxed);
+}
+} // namespace kira
@@ -62,7 +62,7 @@ get_diagnostic_impl(toml::source_region const &region, auto const &sourceLines)
 
 namespace detail {
 void erase_used_nodes(
-    std::unordered_set<toml::node const *> &usedNodes, toml::node const &node
+    FlatHashSet<toml::node const *> &usedNodes, toml::node const &node
 ) noexcept {
     usedNodes.erase(&node);
 
@@ -12,10 +12,12 @@
 
 // NOTE(krr): this file is a modified version of llvm/ADT/SmallVector.cpp, with
 // the following modifications:
-// - llvm::safe_alloc -> std::malloc (because we do use exceptions)
-// - llvm::safe_realloc -> std::realloc
+// - llvm::safe_alloc -> detail::TrackedMalloc (because we do use exceptions)
+// - llvm::safe_realloc -> detail::TrackedRealloc
+// - free -> detail::TrackedFree, see kira/MemoryTracker.h
 // - removed LLVM_ENABLE_EXCEPTIONS
 // - suppresed warnings by [[maybe_unused]]
+// - add SmallVectorBase::getGrownCapacity for the allocators, see SmallVector.h
 // NOLINTBEGIN
 
 #include "kira/SmallVector.h"
@@ -114,14 +116,18 @@ static size_t getNewCapacity(size_t MinSize, [[maybe_unused]] size_t TSize, size
     return std::clamp(NewCapacity, MinSize, MaxSize);
 }
 
+template <class Size_T> size_t SmallVectorBase<Size_T>::getGrownCapacity(size_t MinSize) const {
+    return getNewCapacity<Size_T>(MinSize, 0, this->capacity());
+}
+
 template <class Size_T>
 void *SmallVectorBase<Size_T>::replaceAllocation(
     void *NewElts, size_t TSize, size_t NewCapacity, size_t VSize
 ) {
-    void *NewEltsReplace = std::malloc(NewCapacity * TSize);
+    void *NewEltsReplace = detail::TrackedMalloc(NewCapacity * TSize);
     if (VSize)
         memcpy(NewEltsReplace, NewElts, VSize * TSize);
-    free(NewElts);
+    detail::TrackedFree(NewElts);
     return NewEltsReplace;
 }
 
@@ -133,7 +139,7 @@ void *SmallVectorBase<Size_T>::mallocForGrow(
     NewCapacity = getNewCapacity<Size_T>(MinSize, TSize, this->capacity());
     // Even if capacity is not 0 now, if the vector was originally created with
     // capacity 0, it's possible for the malloc to return FirstEl.
-    void *NewElts = std::malloc(NewCapacity * TSize);
+    void *NewElts = detail::TrackedMalloc(NewCapacity * TSize);
     if (NewElts == FirstEl)
         NewElts = replaceAllocation(NewElts, TSize, NewCapacity);
     return NewElts;
@@ -145,7 +151,7 @@ void SmallVectorBase<Size_T>::grow_pod(void *FirstEl, size_t MinSize, size_t TSi
     size_t NewCapacity = getNewCapacity<Size_T>(MinSize, TSize, this->capacity());
     void *NewElts;
     if (BeginX == FirstEl) {
-        NewElts = std::malloc(NewCapacity * TSize);
+        NewElts = detail::TrackedMalloc(NewCapacity * TSize);
         if (NewElts == FirstEl)
             NewElts = replaceAllocation(NewElts, TSize, NewCapacity);
 
@@ -153,7 +159,7 @@ void SmallVectorBase<Size_T>::grow_pod(void *FirstEl, size_t MinSize, size_t TSi
         memcpy(NewElts, this->BeginX, size() * TSize);
     } else {
         // If this wasn't grown from the inline copy, grow the allocated space.
-        NewElts = std::realloc(this->BeginX, NewCapacity * TSize);
+        NewElts = detail::TrackedRealloc(this->BeginX, NewCapacity * TSize);
         if (NewElts == FirstEl)
             NewElts = replaceAllocation(NewElts, TSize, NewCapacity, size());
     }
@@ -0,0 +1,446 @@
+#include "kira/ThreadPool.h"
+
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#include "kira/Logger.h"
+#include "kira/Profiler.h"
+#include "kira/detail/WorkStealingDeque.h"
+
+namespace kira {
+namespace {
+/// A core the process may run on.
+struct Core {
+    uint32 cpu;
+    uint32 node;
+};
+
+std::string ReadEnvironment(char const *name) {
+#if defined(_WIN32)
+    char *value = nullptr;
+    std::size_t size = 0;
+    if (_dupenv_s(&value, &size, name) != 0 or value == nullptr)
+        return {};
+    std::string result(value);
+    std::free(value);
+    return result;
+#else
+    char const *value = std::getenv(name);
+    return value ? std::string(value) : std::string{};
+#endif
+}
+
+#if defined(__linux__)
+/// Parse the list of the CPUs of sysfs, e.g., `0-3,8-11`.
+std::vector<uint32> ParseCpuList(std::string_view list) {
+    std::vector<uint32> cpus;
+    while (not list.empty()) {
+        auto const comma = list.find(',');
+        auto const item = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        uint32 first = 0, last = 0;
+        auto const dash = item.find('-');
+        auto const end = item.data() + item.size();
+        if (std::from_chars(item.data(), end, first).ec != std::errc{})
+            continue;
+        last = first;
+        if (dash != std::string_view::npos and
+            std::from_chars(item.data() + dash + 1, end, last).ec != std::errc{})
+            continue;
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+#endif
+
+/// The cores the process may run on, in order.
+std::vector<Core> GetCores() {
+    std::vector<Core> cores;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return cores;
+
+    std::vector<uint32> nodes(CPU_SETSIZE, 0);
+    std::error_code ec;
+    for (auto const &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        auto const name = entry.path().filename().string();
+        uint32 node = 0;
+        if (not name.starts_with("node") or
+            std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc{})
+            continue;
+
+        std::string list;
+        std::getline(std::ifstream(entry.path() / "cpulist"), list);
+        for (auto const cpu : ParseCpuList(list))
+            if (cpu < CPU_SETSIZE)
+                nodes[cpu] = node;
+    }
+
+    for (uint32 cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            cores.push_back({cpu, nodes[cpu]});
+#elif defined(_WIN32)
+    DWORD_PTR process = 0, system = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+        for (uint32 cpu = 0; cpu < 8 * sizeof(DWORD_PTR); ++cpu)
+            if (process >> cpu & 1)
+                cores.push_back({cpu, 0});
+#endif
+    return cores;
+}
+
+/// The cores of the workers by `affinity`, or none if they are not pinned.
+std::vector<Core> AssignCores(std::size_t numWorkers, ThreadAffinity affinity) {
+    if (affinity == ThreadAffinity::None or numWorkers == 0)
+        return {};
+
+    auto cores = GetCores();
+    if (cores.empty()) {
+        LogWarn("ThreadPool: The cores are unknown, thus the workers are not pinned");
+        return {};
+    }
+
+    std::stable_sort(cores.begin(), cores.end(), [](Core const &lhs, Core const &rhs) {
+        return lhs.node < rhs.node;
+    });
+    if (affinity == ThreadAffinity::Scatter) {
+        // Take the next core of each node in turn.
+        std::vector<Core> scattered;
+        scattered.reserve(cores.size());
+        std::vector<std::pair<std::size_t, std::size_t>> nodes; // [begin, end) of each node
+        for (std::size_t i = 0; i < cores.size(); ++i)
+            if (i == 0 or cores[i].node != cores[i - 1].node)
+                nodes.emplace_back(i, i + 1);
+            else
+                nodes.back().second = i + 1;
+        for (std::size_t round = 0; scattered.size() < cores.size(); ++round)
+            for (auto const &[begin, end] : nodes)
+                if (begin + round < end)
+                    scattered.push_back(cores[begin + round]);
+        cores = std::move(scattered);
+    }
+
+    // The first core is left to the caller.
+    std::vector<Core> assigned(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        assigned[i] = cores[(i + 1) % cores.size()];
+    return assigned;
+}
+
+/// Name the calling thread, and pin it to `core` if any.
+void SetupWorkerThread(std::size_t index, std::optional<Core> const &core) {
+    auto const name = fmt::format("kira-worker-{:d}", index);
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    if (core) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core->cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            LogWarn("ThreadPool: Failed to pin the worker {:d} to the CPU {:d}", index, core->cpu);
+    }
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#elif defined(_WIN32)
+    SetThreadDescription(GetCurrentThread(), std::wstring(name.begin(), name.end()).c_str());
+    if (core and SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << core->cpu) == 0)
+        LogWarn("ThreadPool: Failed to pin the worker {:d} to the CPU {:d}", index, core->cpu);
+#endif
+    static_cast<void>(core);
+}
+
+/// The number of the threads of the shared pool, by `KRR_NUM_THREADS`.
+std::size_t ReadNumThreads() {
+    auto const hardware = std::max(1U, std::thread::hardware_concurrency());
+    auto const value = ReadEnvironment("KRR_NUM_THREADS");
+    if (value.empty())
+        return hardware;
+
+    std::size_t numThreads = 0;
+    auto const [end, ec] = std::from_chars(value.data(), value.data() + value.size(), numThreads);
+    if (ec != std::errc{} or end != value.data() + value.size() or numThreads == 0) {
+        LogWarn("ThreadPool: Invalid `KRR_NUM_THREADS`: {:s}, which is {:d} then", value, hardware);
+        return hardware;
+    }
+    return numThreads;
+}
+
+/// The affinity of the shared pool, by `KRR_THREAD_AFFINITY`.
+ThreadAffinity ReadAffinity() {
+    auto const value = ReadEnvironment("KRR_THREAD_AFFINITY");
+    if (value.empty() or value == "none")
+        return ThreadAffinity::None;
+    if (value == "compact")
+        return ThreadAffinity::Compact;
+    if (value == "scatter")
+        return ThreadAffinity::Scatter;
+    LogWarn("ThreadPool: Invalid `KRR_THREAD_AFFINITY`: {:s}, which is none then", value);
+    return ThreadAffinity::None;
+}
+
+struct alignas(64) Worker {
+    detail::WorkStealingDeque<detail::Task> deque;
+
+    // The workers to steal from, those on the same NUMA node first, of which there are `numNear`.
+    std::vector<std::size_t> victims;
+    std::size_t numNear{0};
+    uint32 seed{0};
+
+    std::thread thread;
+};
+
+/// The threads sleeping until `epoch` is increased.
+struct alignas(64) Parking {
+    std::atomic<uint64> epoch{0};
+    std::atomic<uint32> sleepers{0};
+
+    /// Wake a sleeping thread, or all of them.
+    void Wake(bool all) noexcept {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) == 0)
+            return;
+        if (all)
+            epoch.notify_all();
+        else
+            epoch.notify_one();
+    }
+};
+
+/// A xorshift step, to start stealing from a random victim.
+uint32 NextRandom(uint32 &seed) noexcept {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/// The pool and the index of the worker running on this thread, if any.
+thread_local void const *thisPool = nullptr;
+thread_local std::size_t thisWorkerIndex = 0;
+} // namespace
+
+struct ThreadPool::State {
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // The tasks queued by the threads which are not workers.
+    std::mutex queueMutex;
+    std::deque<detail::Task *> queue;
+    std::atomic<std::size_t> queued{0};
+
+    // The idle workers sleep on `idle`, which is woken whenever a task is queued, while the threads
+    // waiting for a group sleep on its parking, which is woken whenever a task of the group is
+    // queued or the group is done. A group done thus only wakes its waiter, together with the
+    // waiters of the groups sharing the parking. The parkings are owned by the pool, since a group
+    // may be destroyed as soon as it is done.
+    Parking idle;
+    std::array<Parking, 64> groupParkings;
+    std::atomic<bool> stopping{false};
+
+    Parking &ParkingOf(TaskGroup const *group) noexcept {
+        auto const hash = uint64{reinterpret_cast<std::uintptr_t>(group)} * 0x9e3779b97f4a7c15U;
+        return groupParkings[(hash >> 32) % groupParkings.size()];
+    }
+
+    /// Take a task for `self`, which is null unless the calling thread is a worker.
+    detail::Task *FindTask(Worker *self) {
+        if (self)
+            if (auto *task = self->deque.Pop())
+                return task;
+
+        if (queued.load(std::memory_order_acquire) != 0) {
+            std::lock_guard guard(queueMutex);
+            if (not queue.empty()) {
+                auto *task = queue.front();
+                queue.pop_front();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        if (workers.empty())
+            return nullptr;
+        if (not self) {
+            thread_local uint32 seed = 0x9e3779b9U;
+            auto const first = NextRandom(seed) % workers.size();
+            for (std::size_t i = 0; i < workers.size(); ++i)
+                if (auto *task = workers[(first + i) % workers.size()]->deque.Steal())
+                    return task;
+            return nullptr;
+        }
+
+        // The near victims first, then the far ones, each from a random one.
+        auto const steal = [&](std::size_t begin, std::size_t end) -> detail::Task * {
+            if (begin == end)
+                return nullptr;
+            auto const first = NextRandom(self->seed) % (end - begin);
+            for (std::size_t i = 0; i < end - begin; ++i) {
+                auto const victim = self->victims[begin + (first + i) % (end - begin)];
+                if (auto *task = workers[victim]->deque.Steal())
+                    return task;
+            }
+            return nullptr;
+        };
+        if (auto *task = steal(0, self->numNear))
+            return task;
+        return steal(self->numNear, self->victims.size());
+    }
+
+    void Execute(detail::Task *task) noexcept {
+        auto &group = *task->group;
+        if (not group.cancelled.load(std::memory_order_relaxed)) {
+            try {
+                task->Run();
+            } catch (...) {
+                std::lock_guard guard(group.errorMutex);
+                if (not group.error)
+                    group.error = std::current_exception();
+                group.cancelled.store(true, std::memory_order_relaxed);
+            }
+        }
+        delete task;
+
+        // The group may be destroyed right after, by the thread waiting for it.
+        auto &parking = ParkingOf(&group);
+        if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            parking.Wake(true);
+    }
+
+    /// Run the tasks until `done()`, sleeping on `parking` while there are none.
+    template <typename Done> void RunUntil(Worker *self, Parking &parking, Done const &done) {
+        constexpr int maxSpins = 64;
+        int spins = 0;
+        while (not done()) {
+            if (auto *task = FindTask(self)) {
+                Execute(task);
+                spins = 0;
+                continue;
+            }
+            if (++spins < maxSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Registered before reading the epoch, s.t. the threads queuing a task afterward either
+            // see the sleeper and wake it, or increase the epoch before it is read.
+            parking.sleepers.fetch_add(1, std::memory_order_seq_cst);
+            auto const current = parking.epoch.load(std::memory_order_seq_cst);
+            auto *task = done() ? nullptr : FindTask(self);
+            if (not task and not done())
+                parking.epoch.wait(current, std::memory_order_seq_cst);
+            parking.sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (task)
+                Execute(task);
+            spins = 0;
+        }
+    }
+};
+
+ThreadPool::ThreadPool(std::size_t numThreads, ThreadAffinity affinity)
+    : state(std::make_unique<State>()) {
+    auto const numWorkers = std::max<std::size_t>(numThreads, 1) - 1;
+    auto const cores = AssignCores(numWorkers, affinity);
+
+    auto &workers = state->workers;
+    workers.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->seed = static_cast<uint32>(0x9e3779b9U * (i + 1));
+    }
+    for (std::size_t i = 0; i < numWorkers; ++i) {
+        auto &worker = *workers[i];
+        auto const node = cores.empty() ? 0 : cores[i].node;
+        for (std::size_t j = 0; j < numWorkers; ++j)
+            if (j != i and (cores.empty() or cores[j].node == node))
+                worker.victims.push_back(j);
+        worker.numNear = worker.victims.size();
+        for (std::size_t j = 0; j < numWorkers; ++j)
+            if (j != i and not cores.empty() and cores[j].node != node)
+                worker.victims.push_back(j);
+    }
+
+    for (std::size_t i = 0; i < numWorkers; ++i) {
+        auto const core = cores.empty() ? std::nullopt : std::optional{cores[i]};
+        workers[i]->thread = std::thread([this, i, core] {
+            SetupWorkerThread(i, core);
+            thisPool = this;
+            thisWorkerIndex = i;
+            state->RunUntil(state->workers[i].get(), state->idle, [&] {
+                return state->stopping.load(std::memory_order_relaxed);
+            });
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    state->stopping.store(true, std::memory_order_relaxed);
+    state->idle.Wake(true);
+    for (auto &worker : state->workers)
+        worker->thread.join();
+
+    // The tasks left in the queues, whose groups are not waited for yet, run here instead of
+    // leaking, s.t. their groups are done when they are destroyed.
+    while (auto *task = state->FindTask(nullptr))
+        state->Execute(task);
+}
+
+ThreadPool &ThreadPool::GetInstance() {
+    // Never destroyed, s.t. a task calling `std::exit()` does not join its own thread.
+    static auto *instance = new ThreadPool(ReadNumThreads(), ReadAffinity());
+    return *instance;
+}
+
+std::size_t ThreadPool::GetConcurrency() const noexcept { return state->workers.size() + 1; }
+
+std::optional<std::size_t> ThreadPool::GetWorkerIndex() const noexcept {
+    if (thisPool != this)
+        return std::nullopt;
+    return thisWorkerIndex;
+}
+
+void ThreadPool::Submit(detail::Task *task) {
+    // The task may be run and destroyed as soon as it is queued.
+    auto const *group = task->group;
+    if (thisPool == this) {
+        state->workers[thisWorkerIndex]->deque.Push(task);
+    } else {
+        std::lock_guard guard(state->queueMutex);
+        state->queue.push_back(task);
+        state->queued.fetch_add(1, std::memory_order_release);
+    }
+    state->idle.Wake(false);
+    // The waiter of the group helps with its tasks, and is the only thread to run them without the
+    // workers.
+    state->ParkingOf(group).Wake(true);
+}
+
+void ThreadPool::Wait(TaskGroup &group) {
+    if (group.pending.load(std::memory_order_acquire) == 0)
+        return;
+
+    KIRA_PROFILE_SCOPE("ThreadPool::Wait");
+    auto *self = thisPool == this ? state->workers[thisWorkerIndex].get() : nullptr;
+    state->RunUntil(self, state->ParkingOf(&group), [&] {
+        return group.pending.load(std::memory_order_acquire) == 0;
+    });
+}
+} // namespace kira
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "kira/FlatHashMap.h"
+
+using namespace kira;
+
+namespace {
+/// The hash sending every key into the same group, s.t. the probing is exercised.
+struct CollidingHash {
+    std::size_t operator()(uint64 key) const noexcept { return key % 3 << 7; }
+};
+
+struct alignas(32) Aligned {
+    uint64 value;
+    bool operator==(Aligned const &) const = default;
+};
+} // namespace
+
+TEST(FlatHashMapTests, Basic) {
+    FlatHashMap<uint64, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.erase(1), 0);
+
+    EXPECT_TRUE(map.emplace(1, 10).second);
+    EXPECT_FALSE(map.emplace(1, 20).second);
+    EXPECT_TRUE(map.insert({2, 20}).second);
+    EXPECT_TRUE(map.try_emplace(3, 30).second);
+    map[4] = 40;
+    ++map[4];
+    EXPECT_FALSE(map.insert_or_assign(1, 11).second);
+
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.at(1), 11);
+    EXPECT_EQ(map.at(4), 41);
+    EXPECT_THROW((void)map.at(5), std::out_of_range);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.count(3), 1);
+
+    auto it = map.find(2);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, 20);
+    map.erase(it);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.erase(3), 1);
+    EXPECT_EQ(map.size(), 2);
+
+    int sum = 0;
+    for (auto const &[key, value] : map)
+        sum += value;
+    EXPECT_EQ(sum, 11 + 41);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_GT(map.capacity(), 0);
+}
+
+TEST(FlatHashMapTests, Random) {
+    // Against `std::unordered_map`, through the small tables, the growth and the tombstones.
+    std::mt19937_64 rng(42);
+    for (uint64 const range : {8, 100, 10000}) {
+        FlatHashMap<uint64, uint64> map;
+        std::unordered_map<uint64, uint64> expected;
+        for (int i = 0; i < 200000; ++i) {
+            auto const key = rng() % range;
+            switch (rng() % 4) {
+            case 0:
+            case 1:
+                EXPECT_EQ(map.emplace(key, i).second, expected.emplace(key, i).second);
+                break;
+            case 2:
+                ASSERT_EQ(map.erase(key), expected.erase(key));
+                break;
+            default: {
+                auto const it = map.find(key);
+                auto const found = expected.find(key);
+                ASSERT_EQ(it == map.end(), found == expected.end());
+                if (found != expected.end()) {
+                    ASSERT_EQ(it->second, found->second);
+                }
+            }
+            }
+            ASSERT_EQ(map.size(), expected.size());
+        }
+        EXPECT_EQ(
+            static_cast<std::size_t>(std::distance(map.begin(), map.end())), expected.size()
+        );
+        for (auto const &[key, value] : map)
+            ASSERT_EQ(expected.at(key), value);
+    }
+}
+
+TEST(FlatHashMapTests, Collisions) {
+    // Full groups, s.t. the erased slots become tombstones, which are reused and rehashed away.
+    FlatHashMap<uint64, uint64, CollidingHash> map;
+    for (uint64 i = 0; i < 1000; ++i)
+        map.emplace(i, i);
+    for (uint64 i = 0; i < 1000; i += 2)
+        EXPECT_EQ(map.erase(i), 1);
+    for (uint64 i = 0; i < 1000; ++i)
+        EXPECT_EQ(map.contains(i), i % 2 == 1);
+
+    auto const capacity = map.capacity();
+    for (int round = 0; round < 10; ++round) {
+        for (uint64 i = 0; i < 1000; i += 2)
+            map.emplace(i, i);
+        for (uint64 i = 0; i < 1000; i += 2)
+            map.erase(i);
+    }
+    EXPECT_EQ(map.size(), 500);
+    EXPECT_EQ(map.capacity(), capacity);
+    for (uint64 i = 1; i < 1000; i += 2)
+        EXPECT_EQ(map.at(i), i);
+}
+
+TEST(FlatHashMapTests, Values) {
+    FlatHashMap<std::string, std::unique_ptr<std::string>> map;
+    for (int i = 0; i < 100; ++i)
+        map.try_emplace(std::to_string(i), std::make_unique<std::string>(std::to_string(i * 2)));
+    map.reserve(1000);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(*map.at(std::to_string(i)), std::to_string(i * 2));
+
+    auto moved = std::move(map);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(moved.size(), 100);
+    map = std::move(moved);
+    EXPECT_EQ(*map["42"], "84");
+
+    FlatHashMap<uint64, Aligned> aligned;
+    for (uint64 i = 0; i < 100; ++i)
+        aligned[i] = {i};
+    for (auto const &[key, value] : aligned) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&value) % alignof(Aligned), 0);
+        EXPECT_EQ(value.value, key);
+    }
+}
+
+TEST(FlatHashMapTests, Aliased) {
+    // Inserted from the elements of the table itself, including when it is full and grows. The
+    // strings are long, s.t. reading them from the freed slots is reading freed memory.
+    auto const key = [](int i) { return std::string(32, 'k') + std::to_string(i); };
+    FlatHashMap<std::string, std::string> map;
+    map[key(0)] = key(1);
+    int growths = 0;
+    for (int i = 1; i < 1000; ++i) {
+        auto const capacity = map.capacity();
+        auto const &next = map.at(key(i - 1));
+        if (i % 2 == 0) {
+            map[next] = key(i + 1);
+        } else {
+            EXPECT_TRUE(map.try_emplace(next, next).second);
+            map.at(key(i)) = key(i + 1);
+        }
+        growths += map.capacity() != capacity;
+    }
+    EXPECT_GT(growths, 5);
+    EXPECT_EQ(map.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(map.at(key(i)), key(i + 1));
+}
+
+TEST(FlatHashMapTests, Copy) {
+    FlatHashMap<uint64, std::string> map;
+    for (uint64 i = 0; i < 100; ++i)
+        map.emplace(i, std::to_string(i));
+    map.erase(7);
+
+    auto copy = map;
+    EXPECT_EQ(copy, map);
+    copy[7] = "7";
+    EXPECT_NE(copy, map);
+    copy.erase(7);
+    copy[8] = "eight";
+    EXPECT_NE(copy, map);
+    EXPECT_EQ(map.at(8), "8");
+
+    copy = map;
+    EXPECT_EQ(copy, map);
+    FlatHashMap<uint64, std::string> empty;
+    copy = empty;
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.find(1), copy.end());
+}
+
+TEST(FlatHashMapTests, Set) {
+    int values[64];
+    FlatHashSet<int const *> set;
+    for (auto const &value : values)
+        EXPECT_TRUE(set.insert(&value).second);
+    EXPECT_FALSE(set.insert(&values[3]).second);
+    EXPECT_EQ(set.size(), 64);
+    EXPECT_EQ(set.erase(&values[3]), 1);
+    EXPECT_FALSE(set.contains(&values[3]));
+    EXPECT_TRUE(set.contains(&values[4]));
+
+    FlatHashSet<std::string> strings{"a", "b", "c"};
+    std::unordered_set<std::string> expected;
+    for (auto const &value : strings)
+        expected.insert(value);
+    EXPECT_EQ(expected, (std::unordered_set<std::string>{"a", "b", "c"}));
+    EXPECT_TRUE(strings.emplace("d").second);
+    EXPECT_EQ(strings.count("d"), 1);
+    strings.erase(strings.find("a"));
+    EXPECT_EQ(strings.size(), 3);
+}
+
+TEST(FlatHashMapTests, Hash) {
+    // The sequential keys spread over the control bits and the groups.
+    Hash<uint64> const hash;
+    std::vector<int> h2(128), groups(64);
+    for (uint64 i = 0; i < 1 << 16; ++i) {
+        ++h2[hash(i) & 0x7f];
+        ++groups[(hash(i) >> 7) % 64];
+    }
+    auto const [minH2, maxH2] = std::minmax_element(h2.begin(), h2.end());
+    EXPECT_GT(*minH2, 512 / 2);
+    EXPECT_LT(*maxH2, 512 * 2);
+    auto const [minGroup, maxGroup] = std::minmax_element(groups.begin(), groups.end());
+    EXPECT_GT(*minGroup, 1024 / 2);
+    EXPECT_LT(*maxGroup, 1024 * 2);
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <spdlog/sinks/base_sink.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <limits>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kira/Logger.h"
+#include "kira/detail/AsyncSink.h"
+
+using namespace kira;
+
+namespace {
+/// The sink which records the payloads, and blocks in writing while the gate is closed.
+class GatedSink final : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    void Open() {
+        {
+            std::lock_guard guard(gateMutex);
+            open = true;
+        }
+        cv.notify_all();
+    }
+
+    /// Wait until `count` records are being written or written.
+    void WaitEntered(std::size_t count) {
+        std::unique_lock lock(gateMutex);
+        cv.wait(lock, [&] { return entered >= count; });
+    }
+
+    [[nodiscard]] std::vector<std::string> Payloads() {
+        std::lock_guard guard(gateMutex);
+        return payloads;
+    }
+
+protected:
+    void sink_it_(spdlog::details::log_msg const &msg) override {
+        std::unique_lock lock(gateMutex);
+        ++entered;
+        cv.notify_all();
+        cv.wait(lock, [&] { return open; });
+        payloads.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+
+    void flush_() override {}
+
+private:
+    std::mutex gateMutex;
+    std::condition_variable cv;
+    bool open{false};
+    std::size_t entered{0};
+    std::vector<std::string> payloads;
+};
+
+void Log(detail::AsyncSink &sink, std::string const &payload) {
+    sink.log(spdlog::details::log_msg{"testAsync", spdlog::level::info, payload});
+}
+} // namespace
+
+class LoggerAsyncTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::shutdown();
+        gated = std::make_shared<GatedSink>();
+    }
+
+    void TearDown() override { spdlog::shutdown(); }
+
+    /// Block the background thread on the record "0", and fill the queue of `sink` with "1" to "4".
+    void Fill(detail::AsyncSink &sink) {
+        ASSERT_EQ(sink.capacity(), 4);
+        Log(sink, "0");
+        gated->WaitEntered(1);
+        for (auto const *payload : {"1", "2", "3", "4"})
+            Log(sink, payload);
+    }
+
+    std::shared_ptr<GatedSink> gated;
+};
+
+TEST_F(LoggerAsyncTests, DropNewest) {
+    spdlog::sink_ptr const sinks[] = {gated};
+    detail::AsyncSink sink{sinks, 3, LogOverflowPolicy::DropNewest};
+    Fill(sink);
+
+    Log(sink, "5");
+    Log(sink, "6");
+    EXPECT_EQ(sink.dropped(), 2);
+
+    gated->Open();
+    sink.flush();
+    EXPECT_EQ(gated->Payloads(), (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+}
+
+TEST_F(LoggerAsyncTests, DropOldest) {
+    spdlog::sink_ptr const sinks[] = {gated};
+    detail::AsyncSink sink{sinks, 4, LogOverflowPolicy::DropOldest};
+    Fill(sink);
+
+    Log(sink, "5");
+    Log(sink, "6");
+    EXPECT_EQ(sink.dropped(), 2);
+
+    gated->Open();
+    sink.flush();
+    EXPECT_EQ(gated->Payloads(), (std::vector<std::string>{"0", "3", "4", "5", "6"}));
+}
+
+TEST_F(LoggerAsyncTests, Block) {
+    spdlog::sink_ptr const sinks[] = {gated};
+    detail::AsyncSink sink{sinks, 4, LogOverflowPolicy::Block};
+    Fill(sink);
+
+    std::atomic<bool> logged{false};
+    std::thread producer([&] {
+        Log(sink, "5");
+        logged.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(logged.load());
+
+    gated->Open();
+    producer.join();
+    sink.flush();
+    EXPECT_EQ(sink.dropped(), 0);
+    EXPECT_EQ(gated->Payloads(), (std::vector<std::string>{"0", "1", "2", "3", "4", "5"}));
+}
+
+TEST_F(LoggerAsyncTests, LongMessages) {
+    // Longer than their share of the byte ring, which wraps around, or than all of it.
+    spdlog::sink_ptr const sinks[] = {gated};
+    gated->Open();
+    detail::AsyncSink sink{sinks, 4, LogOverflowPolicy::Block};
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100; ++i) {
+        expected.emplace_back(100 + i * 37 % 1000, static_cast<char>('a' + i % 26));
+        Log(sink, expected.back());
+    }
+    Log(sink, std::string(10000, 'z'));
+    sink.flush();
+    EXPECT_EQ(sink.dropped(), 0);
+
+    auto payloads = gated->Payloads();
+    ASSERT_EQ(payloads.size(), 101);
+    EXPECT_LT(payloads.back().size(), 10000);
+    EXPECT_EQ(payloads.back(), std::string(payloads.back().size(), 'z'));
+    payloads.pop_back();
+    EXPECT_EQ(payloads, expected);
+}
+
+TEST_F(LoggerAsyncTests, DeferredRecord) {
+    auto const format = [](auto const &...args) {
+        auto const record = detail::MakeLogRecord(
+            "testAsync", "{} {:d} {:x} {:.3f} {} {} {}", spdlog::level::info, args...
+        );
+        spdlog::memory_buf_t buffer;
+        detail::FormatLogRecord(record, buffer);
+        return fmt::to_string(buffer);
+    };
+
+    // Formatted as they would have been, e.g., `float` is not widened to `double`.
+    EXPECT_EQ(
+        format(true, 'c', -255, 3.14159, 0.1F, uint8{7}, std::numeric_limits<uint64>::max()),
+        fmt::format(
+            "{} {:d} {:x} {:.3f} {} {} {}", true, 'c', -255, 3.14159, 0.1F, uint8{7},
+            std::numeric_limits<uint64>::max()
+        )
+    );
+
+    // Reported rather than thrown on the background thread.
+    EXPECT_NE(format(1, 2).find("kira:"), std::string::npos);
+
+    static_assert(detail::is_deferrable_log_call<int, double const &, char, bool>);
+    static_assert(not detail::is_deferrable_log_call<std::string>);
+    static_assert(not detail::is_deferrable_log_call<char const *>);
+    static_assert(detail::FormatWithSourceLoc("{}").literal);
+    char buffer[] = "{}";
+    EXPECT_FALSE(detail::FormatWithSourceLoc(buffer).literal);
+    EXPECT_FALSE(detail::FormatWithSourceLoc(std::string_view{"{}"}).literal);
+    char const filled[] = {buffer[0], buffer[1], '\0'};
+    EXPECT_FALSE(detail::FormatWithSourceLoc(fmt::runtime(filled)).literal);
+    EXPECT_EQ(detail::FormatWithSourceLoc(fmt::runtime(filled)).fmt, "{}");
+}
+
+TEST_F(LoggerAsyncTests, BinaryFile) {
+    auto const path = std::filesystem::temp_directory_path() / "LoggerAsyncTests.krrlog";
+    LoggerCustomizationPoint<"testBinary", spdlog::level::info> logInfo;
+    LoggerCustomizationPoint<"testBinary", spdlog::level::warn> logWarn;
+    {
+        auto const logger =
+            LoggerBuilder{"testBinary"}.to_console(false).deferred().to_binary_file(path).init();
+        logInfo("frame {} took {:.2f} ms", 42, 16.625);
+        logWarn("not deferred: {}", std::string{"formatted"});
+        logInfo("no argument");
+        LogFlush<"testBinary">();
+    }
+    spdlog::shutdown();
+
+    auto file = detail::BinaryLogFile::Open(path);
+    spdlog::memory_buf_t buffer;
+    std::vector<std::pair<spdlog::level::level_enum, std::string>> records;
+    while (auto const msg = file.Read(buffer)) {
+        EXPECT_EQ(msg->logger_name, "testBinary");
+        EXPECT_NE(msg->source.line, 0);
+        records.emplace_back(msg->level, std::string{msg->payload.data(), msg->payload.size()});
+    }
+    EXPECT_EQ(
+        records,
+        (std::vector<std::pair<spdlog::level::level_enum, std::string>>{
+            {spdlog::level::info, "frame 42 took 16.62 ms"},
+            {spdlog::level::warn, "not deferred: formatted"},
+            {spdlog::level::info, "no argument"},
+        })
+    );
+    std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+TEST_F(LoggerAsyncTests, Deferred) {
+    LoggerBuilder{}.to_console(true).filter_level(spdlog::level::info).deferred().init();
+
+    ::testing::internal::CaptureStdout();
+    LogInfo("deferred {} {:.2f} {}", 42, 3.14159, 'c');
+    LogInfo("eager {}", std::string{"string"});
+    LogDebug("filtered {}", 42);
+
+    // Only the literals are referred to by the deferred records, the buffers are formatted now.
+    char buffer[] = "buffered {}";
+    LogInfo(buffer, 7);
+    std::fill_n(buffer, sizeof(buffer) - 1, 'x');
+    LogFlush();
+    auto const output = ::testing::internal::GetCapturedStdout();
+
+    auto const deferred = output.find("deferred 42 3.14 c");
+    EXPECT_NE(deferred, std::string::npos);
+    EXPECT_LT(deferred, output.find("eager string"));
+    EXPECT_EQ(output.find("filtered"), std::string::npos);
+    EXPECT_NE(output.find("buffered 7"), std::string::npos);
+}
+
+TEST_F(LoggerAsyncTests, LogFlushDrains) {
+    constexpr int numThreads = 8;
+    constexpr int iterPerThread = 256;
+
+    // Smaller than the records, s.t. the producers wait for the background thread.
+    LoggerBuilder{}.to_console(true).filter_level(spdlog::level::info).async(64).init();
+
+    ::testing::internal::CaptureStdout();
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back([i] {
+            for (int j = 0; j < iterPerThread; ++j)
+                LogInfo("Thread {} iteration {}", i, j);
+        });
+    for (auto &thread : threads)
+        thread.join();
+    LogFlush();
+    auto const output = ::testing::internal::GetCapturedStdout();
+
+    std::vector<std::vector<int>> threadIterations(numThreads);
+    std::regex logPattern(R"(Thread (\d+) iteration (\d+))");
+    for (std::sregex_iterator it(output.begin(), output.end(), logPattern), end; it != end; ++it)
+        threadIterations[std::stoi((*it)[1])].push_back(std::stoi((*it)[2]));
+
+    for (int i = 0; i < numThreads; ++i) {
+        EXPECT_EQ(threadIterations[i].size(), iterPerThread);
+        EXPECT_TRUE(std::is_sorted(threadIterations[i].begin(), threadIterations[i].end()));
+    }
+}
+#endif
@@ -100,6 +100,26 @@ TEST_F(LoggerTests, ShutdownFromSpdlog) {
     EXPECT_EQ(logger3, logger4);
 }
 
+TEST_F(LoggerTests, CachedLogger) {
+    LogInfo("resolved");
+    auto *logger = detail::loggerSlot<defaultLoggerName>.logger.load();
+    EXPECT_EQ(logger, GetLogger(defaultLoggerName.value));
+
+    // Destroyed by the registry, which resets the slot.
+    spdlog::shutdown();
+    EXPECT_EQ(detail::loggerSlot<defaultLoggerName>.logger.load(), nullptr);
+
+    // Replaced by another logger of the same name, while the previous one is still alive.
+    auto const previous = LoggerBuilder{}.to_console(true).init();
+    LogInfo("resolved again");
+    EXPECT_EQ(detail::loggerSlot<defaultLoggerName>.logger.load(), previous.get());
+    spdlog::drop(defaultLoggerName.value);
+    auto const current = LoggerBuilder{}.to_console(false).init();
+    EXPECT_EQ(detail::loggerSlot<defaultLoggerName>.logger.load(), nullptr);
+    LogInfo("resolved once more");
+    EXPECT_EQ(detail::loggerSlot<defaultLoggerName>.logger.load(), current.get());
+}
+
 TEST_F(LoggerTests, DuplicateLogger) {
     LoggerBuilder{"testDuplicated"}.to_console(true).init();
     EXPECT_THROW(LoggerBuilder{"testDuplicated"}.to_console(true).init(), std::runtime_error);
@@ -137,6 +157,27 @@ TEST_F(LoggerTests, LogToConsole) {
     EXPECT_TRUE(output.find("test message") != std::string::npos);
 }
 
+TEST_F(LoggerTests, LogBelowCompileLevel) {
+    LoggerBuilder{"testCompileLevel"}.to_console(true).filter_level(spdlog::level::trace).init();
+    constexpr auto floor = spdlog::level::info;
+    LoggerCustomizationPoint<"testCompileLevel", spdlog::level::debug, floor> logDebug;
+    LoggerCustomizationPoint<"testCompileLevel", spdlog::level::info, floor> logInfo;
+    static_assert(not logDebug.enabled and logInfo.enabled);
+    static_assert(LogTrace.enabled == (KIRA_LOG_COMPILE_LEVEL == SPDLOG_LEVEL_TRACE));
+
+    int evaluated = 0;
+    ::testing::internal::CaptureStdout();
+    logDebug("removed {}", 42);
+    if constexpr (logDebug.enabled)
+        logDebug("removed {}", ++evaluated);
+    logInfo("kept {}", 42);
+    LogFlush<"testCompileLevel">();
+    auto const &output = ::testing::internal::GetCapturedStdout();
+    EXPECT_TRUE(output.find("removed") == std::string::npos);
+    EXPECT_TRUE(output.find("kept 42") != std::string::npos);
+    EXPECT_EQ(evaluated, 0);
+}
+
 TEST_F(LoggerTests, LogWithFormat) {
     ::testing::internal::CaptureStdout();
     LogInfo("test message {}", 42);
@@ -69,6 +69,40 @@ TEST_F(LoggerThreadSafeTests, GetLoggerThreadSafety) {
     EXPECT_EQ(logger1, logger2);
 }
 
+TEST_F(LoggerThreadSafeTests, CachedLoggerThreadSafety) {
+    constexpr int numThreads = 32;
+    constexpr int iterPerThread = 1024;
+
+    std::atomic<int> threadsReady(0);
+    std::atomic<bool> startFlag(false);
+    std::vector<std::thread> threads;
+
+    // The first calls race to resolve the logger, while the filtered ones do not lock.
+    auto threadFunction = [&](int threadId) {
+        threadsReady++;
+        while (!startFlag.load())
+            std::this_thread::yield();
+
+        for (int i = 0; i < iterPerThread; ++i)
+            LogTrace("Thread {} iteration {}", threadId, i);
+    };
+
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back(threadFunction, i);
+
+    while (threadsReady.load() < numThreads)
+        std::this_thread::yield();
+
+    startFlag.store(true);
+
+    for (auto &thread : threads)
+        thread.join();
+
+    auto *logger = detail::loggerSlot<defaultLoggerName>.logger.load();
+    EXPECT_EQ(logger, GetLogger(defaultLoggerName.value));
+}
+
 #ifndef _WIN32
 TEST_F(LoggerThreadSafeTests, LoggingFunctionsThreadSafety) {
     // Thanks again to Claude for this test.
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "kira/MemoryTracker.h"
+#include "kira/SmallVector.h"
+
+using namespace kira;
+
+namespace {
+MemoryCategoryStats FindCategory(std::string_view name) {
+    for (auto const &stats : GetMemoryStats())
+        if (stats.name == name)
+            return stats;
+    return {};
+}
+} // namespace
+
+class MemoryTrackerTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if constexpr (not memoryTrackerEnabled)
+            GTEST_SKIP() << "The allocations are not tracked, see `KRR_ENABLE_MEMORY_TRACKER`";
+    }
+};
+
+TEST_F(MemoryTrackerTests, Category) {
+    MemoryCategory const category{"Category"};
+    EXPECT_EQ(MemoryCategory{"Category"}.GetId(), category.GetId());
+    EXPECT_EQ(GetMemoryStats().front().name, "other");
+
+    std::vector<int> values;
+    {
+        MemoryScope scope{category};
+        values.resize(1024);
+    }
+    // Grown out of the scope, and thus attributed to "other".
+    values.resize(4096);
+
+    auto stats = FindCategory("Category");
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.liveBytes, 0);
+    EXPECT_EQ(stats.peakBytes, 1024 * sizeof(int));
+    EXPECT_EQ(stats.allocatedBytes, 1024 * sizeof(int));
+
+    values = {};
+    EXPECT_EQ(FindCategory("Category").deallocations, 1);
+}
+
+TEST_F(MemoryTrackerTests, Threads) {
+    constexpr int numThreads = 4;
+    constexpr int allocPerThread = 1000;
+
+    MemoryCategory const category{"Threads"};
+    std::vector<std::unique_ptr<int>> values(numThreads * allocPerThread);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back([&, i] {
+            MemoryScope scope{category};
+            for (int j = 0; j < allocPerThread; ++j)
+                values[i * allocPerThread + j] = std::make_unique<int>(j);
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    auto stats = FindCategory("Threads");
+    EXPECT_EQ(stats.allocations, numThreads * allocPerThread);
+    EXPECT_EQ(stats.liveBytes, numThreads * allocPerThread * sizeof(int));
+
+    // Freed by another thread, and yet attributed to the category allocating.
+    values.clear();
+    stats = FindCategory("Threads");
+    EXPECT_EQ(stats.deallocations, numThreads * allocPerThread);
+    EXPECT_EQ(stats.liveBytes, 0);
+    EXPECT_EQ(stats.peakBytes, numThreads * allocPerThread * sizeof(int));
+}
+
+TEST_F(MemoryTrackerTests, SmallVector) {
+    KIRA_MEMORY_SCOPE("SmallVector");
+    {
+        SmallVector<int, 4> values{1, 2, 3, 4};
+        EXPECT_EQ(FindCategory("SmallVector").allocations, 0);
+
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i);
+        auto const stats = FindCategory("SmallVector");
+        EXPECT_GT(stats.allocations, 0);
+        EXPECT_EQ(stats.liveBytes, values.capacity() * sizeof(int));
+    }
+    EXPECT_EQ(FindCategory("SmallVector").liveBytes, 0);
+}
+
+TEST_F(MemoryTrackerTests, Frames) {
+    MemoryCategory const category{"Frames"};
+    MarkMemoryFrame();
+    for (int frame = 1; frame <= 3; ++frame) {
+        MemoryScope scope{category};
+        std::vector<std::unique_ptr<double>> values;
+        values.reserve(frame);
+        for (int i = 0; i < frame; ++i)
+            values.push_back(std::make_unique<double>(i));
+        values.clear();
+        MarkMemoryFrame();
+
+        auto const stats = FindCategory("Frames");
+        EXPECT_EQ(stats.frameAllocations, frame + 1);
+        EXPECT_EQ(stats.frameAllocatedBytes, frame * (sizeof(void *) + sizeof(double)));
+        EXPECT_EQ(stats.framePeakBytes, frame * (sizeof(void *) + sizeof(double)));
+    }
+}
+
+TEST_F(MemoryTrackerTests, Aligned) {
+    struct alignas(64) Aligned {
+        float values[16];
+    };
+
+    KIRA_MEMORY_SCOPE("Aligned");
+    auto values = std::make_unique<Aligned[]>(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.get()) % 64, 0);
+    EXPECT_EQ(FindCategory("Aligned").liveBytes, 3 * sizeof(Aligned));
+    values.reset();
+    EXPECT_EQ(FindCategory("Aligned").liveBytes, 0);
+}
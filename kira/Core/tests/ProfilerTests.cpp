@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "kira/Profiler.h"
+
+using namespace kira;
+
+namespace {
+void Spin(std::chrono::microseconds duration) {
+    auto const end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+        ;
+}
+
+ProfileZoneSummary FindZone(std::vector<ProfileZoneSummary> const &zones, std::string_view name) {
+    for (auto const &zone : zones)
+        if (zone.name == name)
+            return zone;
+    return {};
+}
+} // namespace
+
+class ProfilerTests : public ::testing::Test {
+protected:
+    void SetUp() override { ClearProfile(); }
+    void TearDown() override { ClearProfile(); }
+};
+
+TEST_F(ProfilerTests, Nesting) {
+    for (int i = 0; i < 4; ++i) {
+        ProfileScope outer{"outer"};
+        Spin(std::chrono::microseconds(500));
+        {
+            ProfileScope inner{"inner"};
+            Spin(std::chrono::microseconds(1000));
+        }
+    }
+
+    auto const zones = GetProfileSummary();
+    auto const outer = FindZone(zones, "outer"), inner = FindZone(zones, "inner");
+    EXPECT_EQ(outer.count, 4);
+    EXPECT_EQ(inner.count, 4);
+    EXPECT_EQ(zones.front().name, "outer");
+
+    // The inner zones are subtracted from the self time of the outer ones.
+    EXPECT_NEAR(outer.selfMs, outer.totalMs - inner.totalMs, 1e-3);
+    EXPECT_GE(inner.minMs, 0.9);
+    EXPECT_GE(outer.totalMs, 5.9);
+    EXPECT_DOUBLE_EQ(inner.selfMs, inner.totalMs);
+}
+
+TEST_F(ProfilerTests, Threads) {
+    constexpr int numThreads = 4;
+    constexpr int iterPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back([] {
+            for (int j = 0; j < iterPerThread; ++j)
+                ProfileScope scope{"thread"};
+        });
+
+    // Read while the threads record.
+    auto const partial = FindZone(GetProfileSummary(), "thread");
+    EXPECT_LE(partial.count, numThreads * iterPerThread);
+
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(FindZone(GetProfileSummary(), "thread").count, numThreads * iterPerThread);
+    EXPECT_EQ(GetProfileDropped(), 0);
+}
+
+TEST_F(ProfilerTests, ChromeTrace) {
+    {
+        ProfileScope outer{"trace \"outer\""};
+        ProfileScope inner{"trace inner"};
+    }
+
+    auto const path = std::filesystem::temp_directory_path() / "ProfilerTests.json";
+    WriteChromeTrace(path);
+    std::stringstream stream;
+    stream << std::ifstream(path).rdbuf();
+    auto const trace = stream.str();
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(trace.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    EXPECT_TRUE(trace.ends_with("]}\n"));
+    EXPECT_NE(trace.find(R"("name":"trace \"outer\"","cat":"kira","ph":"X")"), std::string::npos);
+    EXPECT_NE(trace.find(R"("name":"trace inner")"), std::string::npos);
+
+    EXPECT_THROW(WriteChromeTrace(path / "missing" / "trace.json"), std::runtime_error);
+}
+
+TEST_F(ProfilerTests, Counters) {
+    // Unavailable in most of the containers and the virtual machines, where the zones are recorded
+    // without them.
+    bool const enabled = EnableProfileCounters();
+    {
+        ProfileScope scope{"counted"};
+        Spin(std::chrono::microseconds(200));
+    }
+    EnableProfileCounters(false);
+    { ProfileScope scope{"not counted"}; }
+
+    auto const zones = GetProfileSummary();
+    auto const counted = FindZone(zones, "counted");
+    EXPECT_EQ(counted.count, 1);
+    EXPECT_EQ(FindZone(zones, "not counted").counterMask, 0);
+    if (enabled) {
+        ASSERT_TRUE(counted.HasCounter(ProfileCounter::Instructions));
+        EXPECT_GT(counted.GetCounter(ProfileCounter::Instructions), 0);
+    } else {
+        EXPECT_EQ(counted.counterMask, 0);
+        EXPECT_TRUE(std::isnan(counted.GetIpc()));
+    }
+}
+
+TEST_F(ProfilerTests, CounterRatios) {
+    ProfileZoneSummary zone;
+    zone.counterMask = 1 << static_cast<uint8>(ProfileCounter::Cycles) |
+                       1 << static_cast<uint8>(ProfileCounter::Instructions) |
+                       1 << static_cast<uint8>(ProfileCounter::BranchMisses);
+    zone.counters = {1000, 2000, 0, 0, 10};
+    EXPECT_DOUBLE_EQ(zone.GetIpc(), 2.0);
+    EXPECT_DOUBLE_EQ(zone.GetMpki(ProfileCounter::BranchMisses), 5.0);
+    EXPECT_TRUE(std::isnan(zone.GetMpki(ProfileCounter::LLCMisses)));
+}
+
+TEST_F(ProfilerTests, Macro) {
+    { KIRA_PROFILE_SCOPE("macro"); }
+    EXPECT_EQ(FindZone(GetProfileSummary(), "macro").count, profilerEnabled ? 1 : 0);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+#include "kira/SmallVector.h"
+
+using namespace kira;
+
+namespace {
+/// The resource counting what it allocates, and checking the sizes it is given back.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocated = 0;
+    std::size_t live = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocated += bytes;
+        live += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        EXPECT_GE(live, bytes);
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(memory_resource const &other) const noexcept override {
+        return this == &other;
+    }
+};
+} // namespace
+
+static_assert(
+    sizeof(SmallVector<void *, 0, std::allocator<void *>>) == sizeof(SmallVector<void *, 0>),
+    "std::allocator takes no space"
+);
+static_assert(
+    sizeof(pmr::SmallVector<void *, 0>) == sizeof(SmallVector<void *, 0>) + sizeof(void *),
+    "the polymorphic allocator takes a pointer"
+);
+
+TEST(SmallVectorTests, Inline) {
+    CountingResource resource;
+    pmr::SmallVector<int, 4> values(&resource);
+    for (int i = 0; i < 4; ++i)
+        values.push_back(i);
+    EXPECT_EQ(resource.allocated, 0);
+
+    values.push_back(4);
+    EXPECT_GT(resource.allocated, 0);
+    EXPECT_GE(values.capacity(), 5);
+    values.append(100, 7);
+    EXPECT_EQ(values.size(), 105);
+    EXPECT_EQ(values[3], 3);
+    EXPECT_EQ(values.back(), 7);
+    EXPECT_EQ(values.get_allocator().resource(), &resource);
+}
+
+TEST(SmallVectorTests, Arena) {
+    // Freed at once with the arena, while the deallocations are no-ops.
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        pmr::SmallVector<pmr::SmallVector<std::string, 0>, 0> frame(&arena);
+        for (int i = 0; i < 16; ++i) {
+            // Allocated right after the buffer of `frame`, where its first element may be.
+            auto &strings = frame.emplace_back(&arena);
+            for (int j = 0; j < 8; ++j)
+                strings.push_back(std::to_string(i * 8 + j));
+        }
+        EXPECT_EQ(frame.size(), 16);
+        EXPECT_EQ(frame[15][7], "127");
+        for (auto const &strings : frame)
+            EXPECT_EQ(strings.get_allocator().resource(), &arena);
+        EXPECT_GT(upstream.live, 0);
+    }
+    EXPECT_EQ(upstream.live, 0);
+}
+
+TEST(SmallVectorTests, Move) {
+    CountingResource lhsResource, rhsResource;
+
+    // The buffer is taken over from the vectors of the same resource.
+    pmr::SmallVector<std::string, 2> lhs(&lhsResource);
+    lhs.assign(10, "lhs");
+    auto const *data = lhs.data();
+    pmr::SmallVector<std::string, 2> moved(std::move(lhs));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_EQ(moved.get_allocator().resource(), &lhsResource);
+
+    // The elements are moved into the vectors of another resource.
+    pmr::SmallVector<std::string, 2> rhs(&rhsResource);
+    rhs = std::move(moved);
+    EXPECT_NE(rhs.data(), data);
+    EXPECT_EQ(rhs.size(), 10);
+    EXPECT_EQ(rhs.get_allocator().resource(), &rhsResource);
+    EXPECT_EQ(rhsResource.live, rhs.capacity() * sizeof(std::string));
+
+    pmr::SmallVector<int, 0> ints(&lhsResource), others(&rhsResource);
+    ints.assign(20, 1);
+    others.assign(30, 2);
+    ints.swap(others);
+    EXPECT_EQ(ints.size(), 30);
+    EXPECT_EQ(others.size(), 20);
+    EXPECT_EQ(ints.get_allocator().resource(), &lhsResource);
+    others = std::move(ints);
+    EXPECT_EQ(others.size(), 30);
+    EXPECT_EQ(others.get_allocator().resource(), &rhsResource);
+
+    // The copies take the default resource, as std::pmr::vector.
+    pmr::SmallVector<int, 0> copy(others);
+    EXPECT_EQ(copy, others);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(SmallVectorTests, Released) {
+    CountingResource resource;
+    {
+        pmr::SmallVector<std::string, 1> strings(&resource);
+        for (int i = 0; i < 100; ++i)
+            strings.emplace_back(std::to_string(i));
+        pmr::SmallVector<double, 1> doubles({1.0, 2.0, 3.0}, &resource);
+        doubles.resize(1000);
+        EXPECT_GT(resource.live, 0);
+    }
+    EXPECT_EQ(resource.live, 0);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "kira/ThreadPool.h"
+#include "kira/detail/WorkStealingDeque.h"
+
+using namespace kira;
+
+namespace {
+uint64 Fibonacci(uint64 n, ThreadPool &pool) {
+    if (n < 2)
+        return n;
+    uint64 lhs = 0;
+    TaskGroup group(pool);
+    group.Run([&] { lhs = Fibonacci(n - 1, pool); });
+    auto const rhs = Fibonacci(n - 2, pool);
+    group.Wait();
+    return lhs + rhs;
+}
+} // namespace
+
+TEST(ThreadPoolTests, Deque) {
+    constexpr int numThieves = 3;
+    constexpr int numValues = 100000;
+
+    // Pushed past the initial capacity, while stolen, s.t. the ring grows under the thieves.
+    std::vector<int> values(numValues);
+    std::vector<std::atomic<int>> taken(numValues);
+    detail::WorkStealingDeque<int> deque(4);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < numThieves; ++i)
+        thieves.emplace_back([&] {
+            while (not done.load() or not deque.IsEmpty())
+                if (auto *value = deque.Steal())
+                    taken[value - values.data()].fetch_add(1);
+        });
+
+    for (int i = 0; i < numValues; ++i) {
+        deque.Push(&values[i]);
+        if (i % 3 == 0)
+            if (auto *value = deque.Pop())
+                taken[value - values.data()].fetch_add(1);
+    }
+    while (auto *value = deque.Pop())
+        taken[value - values.data()].fetch_add(1);
+    done.store(true);
+    for (auto &thief : thieves)
+        thief.join();
+
+    for (auto const &count : taken)
+        ASSERT_EQ(count.load(), 1);
+}
+
+TEST(ThreadPoolTests, ParallelFor) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.GetConcurrency(), 4);
+    EXPECT_FALSE(pool.GetWorkerIndex());
+
+    std::vector<std::atomic<int>> counts(10007);
+    std::atomic<std::size_t> maxRange{0};
+    ParallelFor(
+        0, counts.size(),
+        [&](std::size_t begin, std::size_t end) {
+            auto current = maxRange.load();
+            while (end - begin > current and
+                   not maxRange.compare_exchange_weak(current, end - begin))
+                ;
+            for (auto i = begin; i < end; ++i)
+                counts[i].fetch_add(1);
+        },
+        100, pool
+    );
+    for (auto const &count : counts)
+        ASSERT_EQ(count.load(), 1);
+    EXPECT_LE(maxRange.load(), 100);
+
+    // Nested into the tasks of the workers.
+    std::vector<std::atomic<int>> nested(64 * 64);
+    ParallelFor(
+        0, 64,
+        [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i)
+                ParallelFor(
+                    0, 64,
+                    [&](std::size_t first, std::size_t last) {
+                        for (auto j = first; j < last; ++j)
+                            nested[i * 64 + j].fetch_add(1);
+                    },
+                    1, pool
+                );
+        },
+        1, pool
+    );
+    for (auto const &count : nested)
+        ASSERT_EQ(count.load(), 1);
+
+    ParallelFor(5, 5, [](std::size_t, std::size_t) { FAIL(); }, 0, pool);
+}
+
+TEST(ThreadPoolTests, ParallelReduce) {
+    std::vector<double> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = 1.0 / static_cast<double>(i + 1);
+
+    auto const sum = [&](ThreadPool &pool) {
+        return ParallelReduce(
+            0, values.size(), 0.0,
+            [&](std::size_t begin, std::size_t end) {
+                return std::accumulate(values.begin() + begin, values.begin() + end, 0.0);
+            },
+            [](double lhs, double rhs) { return lhs + rhs; }, 1000, pool
+        );
+    };
+
+    // The ranges are combined in the same order, regardless of the threads.
+    ThreadPool single(1), multiple(4);
+    auto const expected = sum(single);
+    EXPECT_NEAR(expected, std::accumulate(values.begin(), values.end(), 0.0), 1e-9);
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(sum(multiple), expected);
+
+    EXPECT_EQ(
+        ParallelReduce(3, 3, -1, [](std::size_t, std::size_t) { return 0; }, std::plus<>{}), -1
+    );
+}
+
+TEST(ThreadPoolTests, TaskGroup) {
+    ThreadPool pool(4);
+    EXPECT_EQ(Fibonacci(20, pool), 6765);
+
+    // Run from the threads which are not workers, at the same time.
+    std::vector<std::thread> threads;
+    std::vector<uint64> results(4);
+    for (std::size_t i = 0; i < results.size(); ++i)
+        threads.emplace_back([&, i] { results[i] = Fibonacci(15 + i, pool); });
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(results, (std::vector<uint64>{610, 987, 1597, 2584}));
+
+    // The caller is not a worker, and the workers are the other 3 threads.
+    std::atomic<bool> indexed{true};
+    TaskGroup group(pool);
+    for (int i = 0; i < 100; ++i)
+        group.Run([&] {
+            if (auto const index = pool.GetWorkerIndex(); index and *index >= 3)
+                indexed.store(false);
+        });
+    group.Wait();
+    EXPECT_TRUE(indexed.load());
+}
+
+TEST(ThreadPoolTests, Destroyed) {
+    // Without workers, the tasks stay queued until the pool is destroyed, which runs them.
+    std::atomic<int> ran{0};
+    auto pool = std::make_unique<ThreadPool>(1);
+    TaskGroup group(*pool);
+    for (int i = 0; i < 100; ++i)
+        group.Run([&] { ran.fetch_add(1); });
+    EXPECT_EQ(ran.load(), 0);
+    pool.reset();
+    EXPECT_EQ(ran.load(), 100);
+}
+
+TEST(ThreadPoolTests, Exceptions) {
+    ThreadPool pool(4);
+    std::atomic<int> ran{0};
+    TaskGroup group(pool);
+    for (int i = 0; i < 1000; ++i)
+        group.Run([&, i] {
+            ran.fetch_add(1);
+            if (i == 10)
+                throw std::runtime_error("task");
+        });
+    EXPECT_THROW(group.Wait(), std::runtime_error);
+    EXPECT_TRUE(group.IsCancelled());
+    EXPECT_LE(ran.load(), 1000);
+
+    EXPECT_THROW(
+        ParallelFor(
+            0, 100,
+            [](std::size_t begin, std::size_t) {
+                if (begin == 50)
+                    throw std::runtime_error("range");
+            },
+            1, pool
+        ),
+        std::runtime_error
+    );
+}
+
+TEST(ThreadPoolTests, Affinity) {
+    // Pinned where the cores are known, and not pinned elsewhere.
+    for (auto const affinity : {ThreadAffinity::Compact, ThreadAffinity::Scatter}) {
+        ThreadPool pool(3, affinity);
+        std::atomic<int> count{0};
+        ParallelFor(
+            0, 1000,
+            [&](std::size_t begin, std::size_t end) {
+                count.fetch_add(static_cast<int>(end - begin));
+            },
+            1, pool
+        );
+        EXPECT_EQ(count.load(), 1000);
+    }
+}
+
+TEST(ThreadPoolTests, Shared) {
+    auto &pool = ThreadPool::GetInstance();
+    EXPECT_EQ(&pool, &ThreadPool::GetInstance());
+    EXPECT_GE(pool.GetConcurrency(), 1);
+
+    std::atomic<std::size_t> count{0};
+    ParallelFor(0, 12345, [&](std::size_t begin, std::size_t end) {
+        count.fetch_add(end - begin);
+    });
+    EXPECT_EQ(count.load(), 12345);
+}
@@ -0,0 +1,35 @@
+#include <spdlog/pattern_formatter.h>
+
+#include <cstdio>
+#include <exception>
+
+#include "kira/detail/LogRecord.h"
+
+//! NOTE(krr): Decode a binary log file written by a logger built with `to_binary_file()`, and print
+//! the messages with the pattern of the loggers, as they would have been printed to the console:
+//!
+//!     kira.Core.LogDecode render.krrlog > render.log
+//!
+//! The file must be decoded on the same architecture as it was written.
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fmt::print(stderr, "Usage: {} <binary log file>\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        auto file = kira::detail::BinaryLogFile::Open(argv[1]);
+        spdlog::pattern_formatter formatter{std::string{kira::detail::loggerPattern}};
+        spdlog::memory_buf_t buffer, line;
+        while (auto const msg = file.Read(buffer)) {
+            line.clear();
+            formatter.format(msg.value(), line);
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        }
+    } catch (std::exception const &e) {
+        fmt::print(stderr, "kira: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
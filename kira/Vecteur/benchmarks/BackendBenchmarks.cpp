@@ -0,0 +1,198 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Every operation is measured on the dynamic vecteurs of every backend, against Eigen
+//! and the plain loops, from a few elements up to 10M. The names are `BM_<op><<backend>>/<size>`,
+//! which `compare_backends.py` reads from the JSON output to compare the backends against
+//! `Generic`:
+//!
+//!     kira.Vecteur.BackendBenchmarks --benchmark_out=backends.json --benchmark_out_format=json
+//!     python3 compare_backends.py backends.json
+//!
+//! or the `kira.Vecteur.BackendCheck` target, which does both.
+
+namespace {
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+/// The plain loops, which the compiler vectorizes on its own.
+struct Loop {
+    using Vec = std::vector<float>;
+
+    static Vec Make(std::size_t size, float v) { return Vec(size, v); }
+
+    static void Chain(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            out[i] = std::sqrt(a[i] * b[i] + c[i]) * 0.5F - a[i];
+    }
+
+    static void Fma(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            out[i] = a[i] * b[i] + c[i];
+    }
+
+    static float Dot(Vec const &a, Vec const &b) {
+        float result = 0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            result += a[i] * b[i];
+        return result;
+    }
+
+    static float HSum(Vec const &a, Vec const &b) {
+        float result = 0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            result += a[i] + b[i];
+        return result;
+    }
+};
+
+struct Eigen3 {
+    using Vec = Eigen::VectorXf;
+
+    static Vec Make(std::size_t size, float v) {
+        return Vec::Constant(static_cast<Eigen::Index>(size), v);
+    }
+
+    static void Chain(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = ((a.array() * b.array() + c.array()).sqrt() * 0.5F - a.array()).matrix();
+    }
+
+    static void Fma(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = (a.array() * b.array() + c.array()).matrix();
+    }
+
+    static float Dot(Vec const &a, Vec const &b) { return a.dot(b); }
+
+    static float HSum(Vec const &a, Vec const &b) { return (a + b).sum(); }
+};
+
+/// The expressions, which are the same for all the backends of Vecteur.
+template <typename Vec_> struct Vecteurs {
+    using Vec = Vec_;
+
+    static Vec Make(std::size_t size, float v) { return Vec(size, v); }
+
+    static void Chain(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = (a * b + c).sqrt() * 0.5F - a;
+    }
+
+    static void Fma(Vec const &a, Vec const &b, Vec const &c, Vec &out) { out = a * b + c; }
+
+    static float Dot(Vec const &a, Vec const &b) { return a.dot(b); }
+
+    static float HSum(Vec const &a, Vec const &b) { return (a + b).hsum(); }
+};
+
+/// The eager backend, which routes the large vecteurs to the dispatched kernels.
+struct Generic : Vecteurs<VecXf> {};
+
+struct Lazy : Vecteurs<LazyX<float>> {};
+
+struct LazyParallel : Vecteurs<LazyX<float>> {
+    static void Chain(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = ((a * b + c).sqrt() * 0.5F - a).eval(par);
+    }
+
+    static void Fma(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = (a * b + c).eval(par);
+    }
+
+    static float Dot(Vec const &a, Vec const &b) { return a.dot(b, par); }
+
+    static float HSum(Vec const &a, Vec const &b) { return (a + b).hsum(par); }
+};
+
+/// Recorded and compiled at every iteration, which is part of the cost.
+struct Trace : Vecteurs<TraceXf> {
+    static Vec Make(std::size_t size, float v) { return Vec(LazyX<float>(size, v)); }
+
+    static void Chain(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = (a * b + c).sqrt() * 0.5F - a;
+        out.eval();
+    }
+
+    static void Fma(Vec const &a, Vec const &b, Vec const &c, Vec &out) {
+        out = a * b + c;
+        out.eval();
+    }
+};
+
+template <typename Backend> void BM_Chain(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = Backend::Make(size, 1.5F), b = Backend::Make(size, 0.5F),
+               c = Backend::Make(size, 2.0F);
+    auto out = Backend::Make(size, 0.0F);
+
+    for (auto _ : state) {
+        Backend::Chain(a, b, c, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Backend> void BM_Fma(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = Backend::Make(size, 1.5F), b = Backend::Make(size, 0.5F),
+               c = Backend::Make(size, 2.0F);
+    auto out = Backend::Make(size, 0.0F);
+
+    for (auto _ : state) {
+        Backend::Fma(a, b, c, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Backend> void BM_Dot(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = Backend::Make(size, 1.5F), b = Backend::Make(size, 0.5F);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Backend::Dot(a, b));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Backend> void BM_HSum(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = Backend::Make(size, 1.5F), b = Backend::Make(size, 0.5F);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Backend::HSum(a, b));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Sizes(benchmark::internal::Benchmark *benchmark) {
+    for (std::int64_t size : {4, 64, 4096, 1 << 16, 1 << 20, 10'000'000})
+        benchmark->Arg(size);
+    // The parallel evaluation is measured by the wall clock.
+    benchmark->UseRealTime();
+}
+} // namespace
+
+#define KIRA_BACKEND_BENCHMARK(name)                                                               \
+    BENCHMARK_TEMPLATE(name, Loop)->Apply(Sizes);                                                  \
+    BENCHMARK_TEMPLATE(name, Eigen3)->Apply(Sizes);                                                \
+    BENCHMARK_TEMPLATE(name, Generic)->Apply(Sizes);                                               \
+    BENCHMARK_TEMPLATE(name, Lazy)->Apply(Sizes);                                                  \
+    BENCHMARK_TEMPLATE(name, LazyParallel)->Apply(Sizes);                                          \
+    BENCHMARK_TEMPLATE(name, Trace)->Apply(Sizes);
+
+KIRA_BACKEND_BENCHMARK(BM_Chain)
+KIRA_BACKEND_BENCHMARK(BM_Fma)
+KIRA_BACKEND_BENCHMARK(BM_Dot)
+KIRA_BACKEND_BENCHMARK(BM_HSum)
+#undef KIRA_BACKEND_BENCHMARK
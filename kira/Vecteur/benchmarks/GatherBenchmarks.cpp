@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/Gather.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare the area-weighted vertex normals of a grid mesh computed by a scalar loop
+//! over the faces against the gather/scatter expressions over `Vec3fSoA`, and the scatter-add with
+//! and without the conflict-free promise.
+
+namespace {
+struct GridMesh {
+    Eigen::MatrixX3f vertices;
+    std::vector<int32_t> i0, i1, i2;
+};
+
+/// A grid of `n * n` vertices with a random height, two triangles per cell.
+GridMesh MakeGrid(int n) {
+    GridMesh mesh;
+    mesh.vertices.resize(static_cast<Eigen::Index>(n) * n, 3);
+    std::mt19937 gen(n);
+    std::uniform_real_distribution<float> valDis(-0.5F, 0.5F);
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+            mesh.vertices.row(y * n + x) = Eigen::RowVector3f(x, y, valDis(gen));
+
+    for (int y = 0; y + 1 < n; ++y) {
+        for (int x = 0; x + 1 < n; ++x) {
+            auto const v = y * n + x;
+            mesh.i0.insert(mesh.i0.end(), {v, v + 1});
+            mesh.i1.insert(mesh.i1.end(), {v + 1, v + n + 1});
+            mesh.i2.insert(mesh.i2.end(), {v + n + 1, v + n});
+        }
+    }
+    return mesh;
+}
+
+void BM_NormalsScalar(benchmark::State &state) {
+    auto const mesh = MakeGrid(static_cast<int>(state.range(0)));
+    Eigen::MatrixX3f normals(mesh.vertices.rows(), 3);
+
+    for (auto _ : state) {
+        normals.setZero();
+        for (std::size_t f = 0; f < mesh.i0.size(); ++f) {
+            Eigen::Vector3f const a = mesh.vertices.row(mesh.i0[f]),
+                                  b = mesh.vertices.row(mesh.i1[f]),
+                                  c = mesh.vertices.row(mesh.i2[f]);
+            Eigen::RowVector3f const normal = (b - a).cross(c - a).transpose();
+            normals.row(mesh.i0[f]) += normal;
+            normals.row(mesh.i1[f]) += normal;
+            normals.row(mesh.i2[f]) += normal;
+        }
+        normals.rowwise().normalize();
+        benchmark::DoNotOptimize(normals.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(mesh.i0.size()));
+}
+
+void BM_NormalsGather(benchmark::State &state) {
+    auto const mesh = MakeGrid(static_cast<int>(state.range(0)));
+    Vec3fSoA const vertices(mesh.vertices);
+    Vec3fSoA faceNormals(mesh.i0.size()), normals(vertices.size());
+
+    for (auto _ : state) {
+        auto const p0 = gather(vertices, mesh.i0), p1 = gather(vertices, mesh.i1),
+                   p2 = gather(vertices, mesh.i2);
+        faceNormals.noalias() = (p1 - p0).cross(p2 - p0);
+        normals = Vec3fSoA(vertices.size(), 0.0F);
+        scatter(normals, mesh.i0) += faceNormals;
+        scatter(normals, mesh.i1) += faceNormals;
+        scatter(normals, mesh.i2) += faceNormals;
+        normals = normals.normalize();
+        benchmark::DoNotOptimize(normals.lane(0).data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(mesh.i0.size()));
+}
+
+template <ScatterMode mode> void BM_ScatterAdd(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    std::vector<int32_t> indices(size);
+    for (std::size_t i = 0; i < size; ++i)
+        indices[i] = static_cast<int32_t>(i);
+    std::shuffle(indices.begin(), indices.end(), std::mt19937(size));
+
+    Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy> const values(size, 1.0F);
+    Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy> target(size, 0.0F);
+    for (auto _ : state) {
+        if constexpr (mode == ScatterMode::ConflictFree)
+            scatter(target, indices).conflict_free() += values;
+        else
+            scatter(target, indices) += values;
+        benchmark::DoNotOptimize(target.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_NormalsScalar)->Arg(16)->Arg(128)->Arg(512);
+BENCHMARK(BM_NormalsGather)->Arg(16)->Arg(128)->Arg(512);
+BENCHMARK(BM_ScatterAdd<ScatterMode::Conflicting>)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_ScatterAdd<ScatterMode::ConflictFree>)->Arg(4096)->Arg(65536);
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <vector>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/SoA.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare the small matrices against Eigen's fixed-size ones, i.e., a chain of 4x4
+//! products, a 4x4 matrix applied to a batch of points, and the 3x3 inverse.
+
+namespace {
+constexpr std::size_t nmatrices{256};
+
+template <typename Matrix> std::vector<Matrix> RandMatrices() {
+    std::vector<Matrix> result(nmatrices);
+    for (auto &m : result) {
+        Eigen::Matrix4f const random = Eigen::Matrix4f::Random() + 4 * Eigen::Matrix4f::Identity();
+        for (std::size_t j = 0; j < static_cast<std::size_t>(m.cols()); ++j)
+            for (std::size_t i = 0; i < static_cast<std::size_t>(m.rows()); ++i)
+                m(i, j) = random(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j));
+    }
+    return result;
+}
+
+void BM_Mat4ProductEigen(benchmark::State &state) {
+    auto const matrices = RandMatrices<Eigen::Matrix4f>();
+    for (auto _ : state) {
+        Eigen::Matrix4f result = Eigen::Matrix4f::Identity();
+        for (auto const &m : matrices)
+            result = result * m;
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations() * nmatrices);
+}
+
+void BM_Mat4ProductVecteur(benchmark::State &state) {
+    auto const matrices = RandMatrices<Mat4f>();
+    for (auto _ : state) {
+        auto result = Mat4f::identity();
+        for (auto const &m : matrices)
+            result = result * m;
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations() * nmatrices);
+}
+
+void BM_Mat3InverseEigen(benchmark::State &state) {
+    auto const matrices = RandMatrices<Eigen::Matrix3f>();
+    std::vector<Eigen::Matrix3f> inverses(nmatrices);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < nmatrices; ++i)
+            inverses[i] = matrices[i].inverse();
+        benchmark::DoNotOptimize(inverses.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * nmatrices);
+}
+
+void BM_Mat3InverseVecteur(benchmark::State &state) {
+    auto const matrices = RandMatrices<Mat3f>();
+    std::vector<Mat3f> inverses(nmatrices);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < nmatrices; ++i)
+            inverses[i] = matrices[i].inverse();
+        benchmark::DoNotOptimize(inverses.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * nmatrices);
+}
+
+void BM_TransformPointsEigen(benchmark::State &state) {
+    auto const size = static_cast<Eigen::Index>(state.range(0));
+    Eigen::Affine3f const transform(RandMatrices<Eigen::Matrix4f>().front());
+    Eigen::Matrix3Xf const points = Eigen::Matrix3Xf::Random(3, size);
+    Eigen::Matrix3Xf result(3, size);
+    for (auto _ : state) {
+        result.noalias() = transform * points;
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TransformPointsVecteur(benchmark::State &state) {
+    auto const size = static_cast<Eigen::Index>(state.range(0));
+    auto const transform = RandMatrices<Mat4f>().front();
+    Vec3fSoA const points(Eigen::MatrixX3f::Random(size, 3));
+    Vec3fSoA result(points.size());
+    for (auto _ : state) {
+        result.noalias() = transform_points(transform, points);
+        benchmark::DoNotOptimize(result.lane(0).data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_Mat4ProductEigen);
+BENCHMARK(BM_Mat4ProductVecteur);
+BENCHMARK(BM_Mat3InverseEigen);
+BENCHMARK(BM_Mat3InverseVecteur);
+BENCHMARK(BM_TransformPointsEigen)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_TransformPointsVecteur)->Arg(64)->Arg(4096)->Arg(65536);
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare a bandwidth-bound update of the vecteurs stored in `float` against the same
+//! update stored in the narrow scalars, which is computed in `float` all the same.
+
+namespace {
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+template <typename Scalar> void BM_Update(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    LazyX<Scalar> positions(size, 1.0F);
+    LazyX<Scalar> const velocities(size, 0.5F);
+
+    for (auto _ : state) {
+        positions = positions + velocities * 0.01F;
+        benchmark::DoNotOptimize(positions.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 3 * sizeof(Scalar));
+}
+} // namespace
+
+BENCHMARK(BM_Update<float>)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_Update<float16>)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_Update<bfloat16>)->Arg(1 << 16)->Arg(1 << 22);
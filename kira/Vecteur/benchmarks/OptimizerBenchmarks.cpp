@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Every rewrite rule of `VecteurOptimizer` is measured against the same expression
+//! built without the optimizer, i.e., by constructing the nodes directly.
+
+namespace {
+using LazyVecXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+namespace detail = vecteur::detail;
+
+template <typename Op, typename LHS, typename RHS>
+using Binary = vecteur::CwiseBinaryOp<Op, LHS, RHS>;
+using Mul = detail::BinaryOpMul<float, float>;
+
+LazyVecXf RandVecteur(std::size_t size) {
+    std::mt19937 gen(size);
+    std::uniform_real_distribution<float> valDis(1.0F, 2.0F);
+
+    LazyVecXf result(size);
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = valDis(gen);
+    return result;
+}
+
+/// Evaluate `expr` into `result` at every iteration.
+template <typename Expr>
+void Evaluate(benchmark::State &state, LazyVecXf &result, Expr const &expr) {
+    for (auto _ : state) {
+        result = expr;
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(expr.size()));
+}
+
+// a * b + c
+void BM_MulAdd(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Sum = Binary<detail::BinaryOpAdd<float, float>, Product, LazyVecXf>;
+    using Optimizer = vecteur::VecteurOptimizer<Sum, vecteur::VecteurFastMathPolicy>;
+    Evaluate(state, result, Optimizer{Sum(Product(a, b), c)}());
+}
+
+void BM_MulAddUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Sum = Binary<detail::BinaryOpAdd<float, float>, Product, LazyVecXf>;
+    Evaluate(state, result, Sum(Product(a, b), c));
+}
+
+// c - a * b
+void BM_NegMulAdd(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Difference = Binary<detail::BinaryOpSub<float, float>, LazyVecXf, Product>;
+    using Optimizer = vecteur::VecteurOptimizer<Difference, vecteur::VecteurFastMathPolicy>;
+    Evaluate(state, result, Optimizer{Difference(c, Product(a, b))}());
+}
+
+void BM_NegMulAddUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Difference = Binary<detail::BinaryOpSub<float, float>, LazyVecXf, Product>;
+    Evaluate(state, result, Difference(c, Product(a, b)));
+}
+
+// a * b + c * d
+void BM_MulAddChain(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size);
+    auto d = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Sum = Binary<detail::BinaryOpAdd<float, float>, Product, Product>;
+    using Optimizer = vecteur::VecteurOptimizer<Sum, vecteur::VecteurFastMathPolicy>;
+    Evaluate(state, result, Optimizer{Sum(Product(a, b), Product(c, d))}());
+}
+
+void BM_MulAddChainUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size);
+    auto d = RandVecteur(size), result = a;
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    using Sum = Binary<detail::BinaryOpAdd<float, float>, Product, Product>;
+    Evaluate(state, result, Sum(Product(a, b), Product(c, d)));
+}
+
+// (x * s0) * s1
+void BM_ScaleTwice(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto x = RandVecteur(size), result = x;
+    using Scaled = Binary<Mul, LazyVecXf, float>;
+    using ScaledTwice = Binary<Mul, Scaled, float>;
+    using Optimizer = vecteur::VecteurOptimizer<ScaledTwice, vecteur::VecteurFastMathPolicy>;
+    Evaluate(state, result, Optimizer{ScaledTwice(Scaled(x, 3.0F), 0.5F)}());
+}
+
+void BM_ScaleTwiceUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto x = RandVecteur(size), result = x;
+    using Scaled = Binary<Mul, LazyVecXf, float>;
+    Evaluate(state, result, Binary<Mul, Scaled, float>(Scaled(x, 3.0F), 0.5F));
+}
+
+// x / s
+void BM_DivideByScalar(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto x = RandVecteur(size), result = x;
+    using Divided = Binary<detail::BinaryOpDiv<float, float>, LazyVecXf, float>;
+    using Optimizer = vecteur::VecteurOptimizer<Divided, vecteur::VecteurFastMathPolicy>;
+    Evaluate(state, result, Optimizer{Divided(x, 3.0F)}());
+}
+
+void BM_DivideByScalarUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto x = RandVecteur(size), result = x;
+    Evaluate(state, result, Binary<detail::BinaryOpDiv<float, float>, LazyVecXf, float>(x, 3.0F));
+}
+
+// hsum(a * b)
+void BM_Dot(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size);
+    for (auto _ : state)
+        benchmark::DoNotOptimize((a * b).hsum());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+void BM_DotUnoptimized(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto a = RandVecteur(size), b = RandVecteur(size);
+    using Product = Binary<Mul, LazyVecXf, LazyVecXf>;
+    for (auto _ : state) {
+        auto const product = Product(a, b);
+        benchmark::DoNotOptimize(
+            static_cast<detail::VecteurReductionMixin<Product> const &>(product).hsum_()
+        );
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+} // namespace
+
+#define KIRA_OPTIMIZER_BENCHMARK(name)                                                             \
+    BENCHMARK(BM_##name)->Arg(1 << 12)->Arg(1 << 16);                                              \
+    BENCHMARK(BM_##name##Unoptimized)->Arg(1 << 12)->Arg(1 << 16);
+
+KIRA_OPTIMIZER_BENCHMARK(MulAdd)
+KIRA_OPTIMIZER_BENCHMARK(NegMulAdd)
+KIRA_OPTIMIZER_BENCHMARK(MulAddChain)
+KIRA_OPTIMIZER_BENCHMARK(ScaleTwice)
+KIRA_OPTIMIZER_BENCHMARK(DivideByScalar)
+KIRA_OPTIMIZER_BENCHMARK(Dot)
+#undef KIRA_OPTIMIZER_BENCHMARK
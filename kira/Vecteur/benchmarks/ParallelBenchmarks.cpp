@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare the serial and the parallel evaluation of the large dynamic vecteurs, which
+//! are bandwidth-bound, thus scale with the memory channels rather than with the cores.
+
+namespace {
+using LazyXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+
+constexpr std::size_t nelems = 10'000'000;
+
+template <bool parallel> void BM_Triad(benchmark::State &state) {
+    LazyXf const a(nelems, 1.5F), b(nelems, 0.5F);
+
+    for (auto _ : state) {
+        LazyXf result;
+        if constexpr (parallel)
+            result = (a * 2.0F + b).eval(par);
+        else
+            result = (a * 2.0F + b).eval();
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * 3 * nelems * sizeof(float));
+}
+
+template <bool parallel> void BM_Dot(benchmark::State &state) {
+    LazyXf const a(nelems, 1.5F), b(nelems, 0.5F);
+
+    for (auto _ : state) {
+        if constexpr (parallel)
+            benchmark::DoNotOptimize(a.dot(b, par));
+        else
+            benchmark::DoNotOptimize(a.dot(b));
+    }
+
+    state.SetBytesProcessed(state.iterations() * 2 * nelems * sizeof(float));
+}
+} // namespace
+
+BENCHMARK(BM_Triad<false>)->UseRealTime();
+BENCHMARK(BM_Triad<true>)->UseRealTime();
+BENCHMARK(BM_Dot<false>)->UseRealTime();
+BENCHMARK(BM_Dot<true>)->UseRealTime();
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): The reductions of the dispatched kernels are measured against a single serial
+//! accumulator, which is what `VecteurReductionMixin` used to do.
+
+namespace {
+template <typename Vecteur> Vecteur RandVecteur(std::size_t size) {
+    std::mt19937 gen(size);
+    std::uniform_real_distribution<float> valDis(1.0F, 2.0F);
+
+    Vecteur result(size);
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = valDis(gen);
+    return result;
+}
+
+template <typename Vecteur> void BM_HSum(benchmark::State &state) {
+    auto const v = RandVecteur<Vecteur>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(v.hsum());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vecteur> void BM_HSumCompensated(benchmark::State &state) {
+    auto const v = RandVecteur<Vecteur>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(v.hsum_compensated());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vecteur> void BM_HSumSerial(benchmark::State &state) {
+    auto const v = RandVecteur<Vecteur>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        typename Vecteur::Scalar result{};
+        for (std::size_t i = 0; i < v.size(); ++i)
+            result += v[i];
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vecteur> void BM_Dot(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = RandVecteur<Vecteur>(size), b = RandVecteur<Vecteur>(size);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.dot(b));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vecteur> void BM_DotCompensated(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = RandVecteur<Vecteur>(size), b = RandVecteur<Vecteur>(size);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.dot_compensated(b));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vecteur> void BM_DotSerial(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = RandVecteur<Vecteur>(size), b = RandVecteur<Vecteur>(size);
+    for (auto _ : state) {
+        typename Vecteur::Scalar result{};
+        for (std::size_t i = 0; i < size; ++i)
+            result += a[i] * b[i];
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+#define KIRA_REDUCTION_BENCHMARK(name)                                                             \
+    BENCHMARK(BM_##name<VecXf>)->Arg(1 << 12)->Arg(1 << 16);                                       \
+    BENCHMARK(BM_##name<VecXd>)->Arg(1 << 12)->Arg(1 << 16);
+
+KIRA_REDUCTION_BENCHMARK(HSum)
+KIRA_REDUCTION_BENCHMARK(HSumCompensated)
+KIRA_REDUCTION_BENCHMARK(HSumSerial)
+KIRA_REDUCTION_BENCHMARK(Dot)
+KIRA_REDUCTION_BENCHMARK(DotCompensated)
+KIRA_REDUCTION_BENCHMARK(DotSerial)
+#undef KIRA_REDUCTION_BENCHMARK
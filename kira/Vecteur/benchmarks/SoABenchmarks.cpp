@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <vector>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/SoA.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare the cross product and the normalization of N points stored as an array of
+//! `Eigen::Vector3f` (AoS) against `Vec3fSoA`, where every lane is a single packet loop.
+
+namespace {
+Eigen::MatrixX3f RandPoints(std::size_t size) {
+    return Eigen::MatrixX3f::Random(static_cast<Eigen::Index>(size), 3);
+}
+
+std::vector<Eigen::Vector3f> ToAoS(Eigen::MatrixX3f const &points) {
+    std::vector<Eigen::Vector3f> result(points.rows());
+    for (Eigen::Index i = 0; i < points.rows(); ++i)
+        result[i] = points.row(i);
+    return result;
+}
+
+void BM_CrossAoS(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = ToAoS(RandPoints(size)), b = ToAoS(RandPoints(size));
+    std::vector<Eigen::Vector3f> c(size);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < size; ++i)
+            c[i] = a[i].cross(b[i]);
+        benchmark::DoNotOptimize(c.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CrossSoA(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    Vec3fSoA const a(RandPoints(size)), b(RandPoints(size));
+    Vec3fSoA c(size);
+
+    for (auto _ : state) {
+        c.noalias() = a.cross(b);
+        benchmark::DoNotOptimize(c.lane(0).data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NormalizeAoS(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = ToAoS(RandPoints(size));
+    std::vector<Eigen::Vector3f> c(size);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < size; ++i)
+            c[i] = a[i].normalized();
+        benchmark::DoNotOptimize(c.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NormalizeSoA(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    Vec3fSoA const a(RandPoints(size));
+    Vec3fSoA c(size);
+
+    for (auto _ : state) {
+        c.noalias() = a.normalize();
+        benchmark::DoNotOptimize(c.lane(0).data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_CrossAoS)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_CrossSoA)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_NormalizeAoS)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_NormalizeSoA)->Arg(64)->Arg(4096)->Arg(65536);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): The heap allocations of the dynamic vecteurs are counted by the storages that are not
+//! inline, i.e., the ones that spilled past `KIRA_VECTEUR_INLINE_CAPACITY`, which is reported as
+//! the "allocs" counter per iteration. The ones bumped from a `VecteurArena` are not counted.
+
+namespace {
+VecXf RandVecteur(std::size_t size) {
+    std::mt19937 gen(size);
+    std::uniform_real_distribution<float> valDis(1.0F, 2.0F);
+
+    VecXf result(size);
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = valDis(gen);
+    return result;
+}
+
+// (a + b) * c - a, with the temporaries spelled out to count them.
+void BM_Temporaries(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size);
+
+    int64_t allocations = 0;
+    for (auto _ : state) {
+        VecXf const sum = a + b;
+        VecXf const product = sum * c;
+        VecXf const result = product - a;
+        benchmark::DoNotOptimize(result.data());
+        allocations += int64_t{not sum.is_inline()} + int64_t{not product.is_inline()} +
+                       int64_t{not result.is_inline()};
+    }
+
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// BM_Temporaries, where the temporaries are bumped from the arena that is reset every frame.
+void BM_ArenaTemporaries(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const a = RandVecteur(size), b = RandVecteur(size), c = RandVecteur(size);
+    auto &arena = vecteur::VecteurArena::local();
+
+    int64_t allocations = 0;
+    for (auto _ : state) {
+        {
+            vecteur::VecteurArenaScope const scope;
+            VecXf const sum = a + b;
+            VecXf const product = sum * c;
+            VecXf const result = product - a;
+            benchmark::DoNotOptimize(result.data());
+            for (auto const *v : {&sum, &product, &result})
+                allocations += int64_t{not v->is_inline() and not arena.owns(v->data())};
+        }
+
+        arena.reset();
+    }
+
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// Copy a storage with the given inline capacity, where 0 always allocates on the heap.
+template <std::size_t InlineCapacity> void BM_StorageCopy(benchmark::State &state) {
+    using Storage =
+        vecteur::VecteurStorage<float, std::dynamic_extent, alignof(float), InlineCapacity>;
+    Storage const storage(static_cast<std::size_t>(state.range(0)));
+
+    int64_t allocations = 0;
+    for (auto _ : state) {
+        Storage const copy(storage);
+        benchmark::DoNotOptimize(copy.data());
+        allocations += int64_t{not copy.is_inline()};
+    }
+
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+BENCHMARK(BM_Temporaries)->Arg(3)->Arg(8)->Arg(16)->Arg(17)->Arg(64)->Arg(1024);
+BENCHMARK(BM_ArenaTemporaries)->Arg(17)->Arg(64)->Arg(1024);
+BENCHMARK(BM_StorageCopy<0>)->Arg(3)->Arg(8)->Arg(16);
+BENCHMARK(BM_StorageCopy<KIRA_VECTEUR_INLINE_CAPACITY>)->Arg(3)->Arg(8)->Arg(16);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare a chain of element-wise operations evaluated eagerly by the kernels (a
+//! temporary array per operation) against the lazy backend (a fused packet loop) and the trace
+//! backend (a fused loop over L1-resident chunks, recorded and compiled at every iteration).
+
+namespace {
+template <typename T> auto Chain(T const &a, T const &b) {
+    auto const c = a * b + 1.0F;
+    return (c * c + a).sqrt() - c / 2.0F + b.exp();
+}
+
+void BM_ChainEager(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    VecXf const a(size, 1.5F), b(size, 0.5F);
+
+    for (auto _ : state) {
+        VecXf const result = Chain(a, b);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ChainLazy(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy> const a(size, 1.5F), b(size, 0.5F);
+
+    for (auto _ : state) {
+        Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy> const result = Chain(a, b);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ChainTrace(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    TraceXf const a(Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>(size, 1.5F)),
+        b(Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>(size, 0.5F));
+
+    for (auto _ : state) {
+        TraceXf const result = Chain(a, b);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_ChainEager)->Arg(4096)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_ChainLazy)->Arg(4096)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_ChainTrace)->Arg(4096)->Arg(1 << 16)->Arg(1 << 22);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+//! NOTE(krr): Compare the transcendental functions of the kernels and the lazy packets against a
+//! loop over `std::`, which the compiler does not vectorize without `-ffast-math`.
+
+namespace {
+using VecXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Generic>;
+using LazyXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+
+template <typename T> T Angles(std::size_t size) {
+    T result(size);
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = static_cast<float>(i) * 1e-3F - 2.0F;
+    return result;
+}
+
+void BM_SinCosStd(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const x = Angles<std::vector<float>>(size);
+    std::vector<float> result(size);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = std::sin(x[i]) * std::cos(x[i]);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SinCosKernels(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const x = Angles<VecXf>(size);
+
+    for (auto _ : state) {
+        VecXf const result = x.sin() * x.cos();
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SinCosLazy(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const x = Angles<LazyXf>(size);
+    LazyXf result(size);
+
+    for (auto _ : state) {
+        result = x.sin() * x.cos();
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ExpStd(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const x = Angles<std::vector<float>>(size);
+    std::vector<float> result(size);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = std::exp(x[i]);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ExpKernels(benchmark::State &state) {
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto const x = Angles<VecXf>(size);
+
+    for (auto _ : state) {
+        VecXf const result = x.exp();
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_SinCosStd)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_SinCosKernels)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_SinCosLazy)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_ExpStd)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_ExpKernels)->Arg(1024)->Arg(65536);
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Compare the backends measured by `BackendBenchmarks.cpp` against the generic one.
+
+Reads the JSON output of Google Benchmark (`--benchmark_out_format=json`), prints the time of every
+backend relative to the reference backend for each operation and size, and exits with 1 when a
+checked backend is slower than the reference past the threshold. With `--baseline`, the threshold
+is instead relative to the ratios of a previous run, s.t. only the regressions fail.
+"""
+
+import argparse
+import json
+import re
+import sys
+from collections import defaultdict
+
+NAME = re.compile(r"^BM_(?P<op>\w+)<(?P<backend>\w+)>/(?P<size>\d+)")
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path):
+    """Map `(op, size, backend)` to the real time in nanoseconds, the median if repeated."""
+    with open(path, encoding="utf-8") as file:
+        runs = json.load(file)["benchmarks"]
+
+    repeated = any(run.get("run_type") == "aggregate" for run in runs)
+    samples = defaultdict(list)
+    for run in runs:
+        if run.get("error_occurred"):
+            continue
+        if repeated and run.get("aggregate_name") != "median":
+            continue
+        match = NAME.match(run.get("run_name", run["name"]))
+        if not match:
+            continue
+        key = (match["op"], int(match["size"]), match["backend"])
+        samples[key].append(run["real_time"] * UNITS[run["time_unit"]])
+
+    return {key: sum(times) / len(times) for key, times in samples.items()}
+
+
+def relative_times(times, reference):
+    """Map `op/size/backend` to the time relative to the reference backend."""
+    ratios = {}
+    for (op, size, backend), time in sorted(times.items()):
+        base = times.get((op, size, reference))
+        if base:
+            ratios[f"{op}/{size}/{backend}"] = time / base
+    return ratios
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("results", help="the JSON output of the benchmarks")
+    parser.add_argument("--reference", default="Generic", help="the backend compared against")
+    parser.add_argument(
+        "--check",
+        nargs="*",
+        default=["Lazy", "LazyParallel"],
+        help="the backends that fail the check, the others are only reported",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=1.25,
+        help="the maximum time relative to the reference without a baseline",
+    )
+    parser.add_argument("--baseline", help="the ratios of a previous run, see --out")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.15,
+        help="the maximum increase of a ratio relative to the baseline",
+    )
+    parser.add_argument("--out", help="write the ratios as JSON, e.g., for a later --baseline")
+    args = parser.parse_args()
+
+    ratios = relative_times(load_times(args.results), args.reference)
+    if not ratios:
+        sys.exit(f"No benchmark of {args.results} has a {args.reference} counterpart.")
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as file:
+            baseline = json.load(file)
+
+    failures = []
+    print(f"{'benchmark':<32} {'ratio':>8} {'limit':>8}")
+    for key, ratio in ratios.items():
+        limit = None
+        if key.rsplit("/", 1)[1] in args.check:
+            if key in baseline:
+                limit = baseline[key] * (1.0 + args.tolerance)
+            elif not args.baseline:
+                limit = args.threshold
+        failed = limit is not None and ratio > limit
+        if failed:
+            failures.append(key)
+        limit_text = f"{limit:8.3f}" if limit is not None else f"{'-':>8}"
+        print(f"{key:<32} {ratio:8.3f} {limit_text}{'  FAILED' if failed else ''}")
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as file:
+            json.dump(ratios, file, indent=2)
+
+    if failures:
+        print(f"{len(failures)} benchmark(s) slower than {args.reference} past the limit.")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,14 +5,23 @@
 #include "kira/Vecteur/Generic.h"
 #include "kira/Vecteur/Highway.h"
 #include "kira/Vecteur/Lazy.h"
+#include "kira/Vecteur/Matrix.h"
+#include "kira/Vecteur/Narrow.h"
+#include "kira/Vecteur/Parallel.h"
 #include "kira/Vecteur/Router.h"
+#include "kira/Vecteur/Trace.h"
 #include "kira/Vecteur/Traits.h"
 
 namespace kira {
+using vecteur::HighwayTargetName;
 using vecteur::is_leaf_vecteur;
 using vecteur::is_vecteur;
+using vecteur::is_vecteur_matrix;
+using vecteur::par;
+using vecteur::ParallelPolicy;
 using vecteur::Vecteur;
 using vecteur::VecteurBackend;
+using vecteur::VecteurMatrix;
 
 // Unless otherwise specified, use the generic backend for now.
 // "Application speedups through core library changes"
@@ -36,4 +45,12 @@ using Vec1d = Vecteur<double, 1, defaultBackend>;
 using Vec2d = Vecteur<double, 2, defaultBackend>;
 using Vec3d = Vecteur<double, 3, defaultBackend>;
 using Vec4d = Vecteur<double, 4, defaultBackend>;
+
+using Mat2f = VecteurMatrix<float, 2, 2>;
+using Mat3f = VecteurMatrix<float, 3, 3>;
+using Mat4f = VecteurMatrix<float, 4, 4>;
+
+using Mat2d = VecteurMatrix<double, 2, 2>;
+using Mat3d = VecteurMatrix<double, 3, 3>;
+using Mat4d = VecteurMatrix<double, 4, 4>;
 } // namespace kira
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "kira/SmallVector.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): The dynamic storage allocates through an allocator policy, i.e., a type with
+//!
+//!     static void *allocate(std::size_t bytes, std::size_t alignment);
+//!     static void deallocate(void *ptr);
+//!
+//! where `allocate` returns `nullptr` on failure. The default policy, \c VecteurDefaultAllocator,
+//! allocates on the heap unless a \c VecteurArenaScope is active on the current thread, in which
+//! case the allocations are bumped from the thread's \c VecteurArena, and freeing them is a no-op
+//! until the arena is reset:
+//!
+//!     for (auto const &frame : frames) {
+//!         VecteurArenaScope const scope;
+//!         ... // transient dynamic vecteurs
+//!     }
+//!     VecteurArena::local().reset();
+//!
+//! Each allocation of the default policy is tagged by a header in front of it, which tells the
+//! heap allocation to free, or the block of the arena it is counted in. The arena lets go of the
+//! blocks still holding allocations on `reset()` and `release()`, instead of reusing or freeing
+//! them, and such a block is freed by its last allocation. Thus the vecteurs allocated in a scope
+//! may outlive the scope, the arena and its thread, and may be destroyed by any thread.
+
+/// Allocate on the heap.
+struct VecteurHeapAllocator {
+    //! NOTE(krr): we do not use the aligned new/delete here because of
+    //! 1. A MSVC compiler issue.
+    //! 2. A valgrind error reported if we use the aligned new/delete.
+
+    static void *allocate(std::size_t bytes, std::size_t alignment) {
+#ifdef _WIN32
+        return _aligned_malloc(bytes, alignment);
+#else
+        // `aligned_alloc` requires the size to be a multiple of the alignment.
+        return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    static void deallocate(void *ptr) {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+};
+
+/// A monotonic arena, where an allocation is a pointer bump and freeing is a no-op until
+/// \c reset().
+///
+/// \note The arena is not thread-safe, use one per thread, e.g., \c VecteurArena::local().
+class VecteurArena {
+public:
+    /// The alignment of the blocks, which covers the widest SIMD registers.
+    static constexpr std::size_t BlockAlignment = 64;
+
+    /// \param blockSize The size in bytes of the blocks requested from the heap. Larger
+    /// allocations get a dedicated block.
+    explicit VecteurArena(std::size_t blockSize = std::size_t{1} << 20) : blockSize{blockSize} {}
+    ~VecteurArena() { release(); }
+
+    VecteurArena(VecteurArena const &) = delete;
+    VecteurArena &operator=(VecteurArena const &) = delete;
+
+    /// The arena of the current thread, which is used by \c VecteurArenaScope.
+    [[nodiscard]] static VecteurArena &local();
+
+    /// Allocate `bytes` aligned to `alignment`, which must be a power of two no larger than
+    /// \c BlockAlignment. Returns `nullptr` if the heap is exhausted.
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment) {
+        auto const offset = (cursor + alignment - 1) & ~(alignment - 1);
+        if (current < blocks.size() and offset + bytes <= blocks[current].size) {
+            cursor = offset + bytes;
+            return blocks[current].data + offset;
+        }
+
+        return allocateSlow(bytes);
+    }
+
+    /// The number of the counted allocations of a block, see \c allocateCounted().
+    using BlockCount = std::atomic<std::size_t>;
+
+    /// Allocate as \c allocate(), and count the allocation in its block, which is kept until the
+    /// allocation is given back by \c freeCounted(), even past \c reset(), \c release() and the
+    /// arena itself.
+    ///
+    /// \param[out] count The count of the block, to be given to \c freeCounted().
+    [[nodiscard]] void *
+    allocateCounted(std::size_t bytes, std::size_t alignment, BlockCount *&count) {
+        auto *ptr = allocate(bytes, alignment);
+        if (ptr) {
+            count = blocks[current].count;
+            count->fetch_add(1, std::memory_order_relaxed);
+        }
+        return ptr;
+    }
+
+    /// Give back an allocation of \c allocateCounted(), from any thread.
+    static void freeCounted(BlockCount *count) noexcept;
+
+    /// Rewind to the beginning, while keeping the blocks for the later allocations, except for
+    /// those holding counted allocations.
+    ///
+    /// \note All the memory allocated from the arena is invalidated, except the counted one.
+    void reset();
+
+    /// Return all the blocks to the heap, or to the counted allocations they hold.
+    ///
+    /// \note All the memory allocated from the arena is invalidated, except the counted one.
+    void release();
+
+    /// Whether `ptr` points into one of the blocks of the arena.
+    [[nodiscard]] bool owns(void const *ptr) const {
+        for (auto const &block : blocks)
+            if (ptr >= block.data and ptr < block.data + block.size)
+                return true;
+        return false;
+    }
+
+    /// The number of bytes handed out since the last \c reset(), including the padding.
+    [[nodiscard]] std::size_t used() const;
+
+    /// The number of bytes of all the blocks.
+    [[nodiscard]] std::size_t capacity() const;
+
+private:
+    /// The `size` bytes of `data`, preceded by the count at the beginning of the heap allocation.
+    struct Block {
+        std::byte *data;
+        std::size_t size;
+        BlockCount *count;
+    };
+
+    /// Move to the next block that fits `bytes`, allocating one if there is none.
+    void *allocateSlow(std::size_t bytes);
+
+    /// Let go of `block`, which is freed now unless it holds counted allocations.
+    static void drop(Block const &block) noexcept;
+
+    SmallVector<Block> blocks;
+    std::size_t blockSize;
+    std::size_t current{0}; ///< The block being bumped.
+    std::size_t cursor{0};  ///< The offset of the first free byte of the current block.
+};
+
+/// Route the dynamic vecteur allocations of the current thread to \c VecteurArena::local() during
+/// the lifetime of the scope. The scopes can be nested.
+class VecteurArenaScope {
+public:
+    VecteurArenaScope() { ++depth; }
+    ~VecteurArenaScope() { --depth; }
+
+    VecteurArenaScope(VecteurArenaScope const &) = delete;
+    VecteurArenaScope &operator=(VecteurArenaScope const &) = delete;
+
+    /// Whether a scope is active on the current thread.
+    [[nodiscard]] static bool active() { return depth > 0; }
+
+private:
+    static inline thread_local int depth = 0;
+};
+
+/// Allocate from \c VecteurArena::local() inside a \c VecteurArenaScope, or on the heap otherwise.
+struct VecteurDefaultAllocator {
+    static void *allocate(std::size_t bytes, std::size_t alignment) {
+        alignment = std::max(alignment, alignof(Header));
+        auto const offset = (sizeof(Header) + alignment - 1) & ~(alignment - 1);
+        if (VecteurArenaScope::active()) {
+            VecteurArena::BlockCount *count = nullptr;
+            auto *base = static_cast<std::byte *>(
+                VecteurArena::local().allocateCounted(offset + bytes, alignment, count)
+            );
+            return base ? tag(base + offset, {count, nullptr}) : nullptr;
+        }
+        auto *base =
+            static_cast<std::byte *>(VecteurHeapAllocator::allocate(offset + bytes, alignment));
+        return base ? tag(base + offset, {nullptr, base}) : nullptr;
+    }
+
+    static void deallocate(void *ptr) {
+        if (!ptr)
+            return;
+        auto const &header = *(static_cast<Header const *>(ptr) - 1);
+        if (header.count)
+            VecteurArena::freeCounted(header.count);
+        else
+            VecteurHeapAllocator::deallocate(header.base);
+    }
+
+private:
+    /// In front of each allocation: the count of its arena block, or else its heap allocation.
+    struct Header {
+        VecteurArena::BlockCount *count;
+        void *base;
+    };
+
+    static void *tag(std::byte *ptr, Header const &header) {
+        new (ptr - sizeof(Header)) Header(header);
+        return ptr;
+    }
+};
+} // namespace kira::vecteur
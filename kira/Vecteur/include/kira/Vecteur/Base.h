@@ -7,10 +7,14 @@
 #include "kira/Types.h"
 
 namespace kira::vecteur {
+// Only the lazy backend evaluates in parallel, thus the pool is included there, see `Parallel.h`.
+struct ParallelPolicy;
+
 /// The backend to use for the vector.
 enum class VecteurBackend {
     Generic, //< The generic backend (with constexpr&CUDA support and SIMD-accelerated).
     Lazy,    //< The lazy-evaluated backend.
+    Trace,   //< The trace-recording backend, fused into a single loop at evaluation.
     LLVM,    //< The LLVM codegen backend.
 };
 
@@ -58,12 +62,14 @@ public:
     static constexpr bool IsVecteur = true;
     static constexpr bool IsGeneric = backend == VecteurBackend::Generic;
     static constexpr bool IsLazy = backend == VecteurBackend::Lazy;
+    static constexpr bool IsTrace = backend == VecteurBackend::Trace;
     static constexpr bool IsConstexpr = IsGeneric;
     static constexpr bool IsDynamic = Size == std::dynamic_extent;
 
     static constexpr bool is_vecteur() { return IsVecteur; }
     static constexpr bool is_generic() { return IsGeneric; }
     static constexpr bool is_lazy() { return IsLazy; }
+    static constexpr bool is_trace() { return IsTrace; }
     static constexpr bool is_constexpr() { return IsConstexpr; }
     static constexpr bool is_dynamic() { return IsDynamic; }
 
@@ -106,11 +112,16 @@ public:
 
     /// Evaluate the vector.
     ///
-    /// \note This function will only do computation when the vector is lazy or jit.
+    /// \note This function will only do computation when the vector is lazy or traced.
     /// \note A const reference wikll be returned when the vector is generic to safe copy, so be
     /// cautious of the potential dangling reference.
     [[nodiscard]] constexpr auto eval() const { return KIRA_CONSTEXPR_DISPATCH0(eval_); }
 
+    /// Evaluate the vector, where the large ones are split across the threads.
+    ///
+    /// \see ParallelPolicy
+    [[nodiscard]] auto eval(ParallelPolicy const &policy) const { return derived().eval_(policy); }
+
     /// Get the first element of the vector.
     [[nodiscard]] constexpr decltype(auto) x() const
         requires(Size >= 1)
@@ -215,6 +226,21 @@ public:
         return KIRA_CONSTEXPR_DISPATCH1(dot_, rhs);
     }
 
+    /// Dot product of two vectors, where the large ones are reduced across the threads.
+    ///
+    /// \see ParallelPolicy
+    [[nodiscard]] auto dot(auto const &rhs, ParallelPolicy const &policy) const {
+        return derived().dot_(rhs, policy);
+    }
+
+    /// Dot product of two vectors, where the rounding errors of the summation are compensated.
+    ///
+    /// \note The products themselves are still rounded.
+    /// \see detail::Summation::Compensated
+    [[nodiscard]] constexpr auto dot_compensated(auto const &rhs) const {
+        return KIRA_CONSTEXPR_DISPATCH1(dot_compensated_, rhs);
+    }
+
     /// Check if two vectors are equal.
     ///
     /// \note This function is only available when the size of the vectors is the same.
@@ -239,6 +265,18 @@ public:
     [[nodiscard]] constexpr auto norm() const { return KIRA_CONSTEXPR_DISPATCH0(norm_); }
     /// Sum of all elements in the vector.
     [[nodiscard]] constexpr auto hsum() const { return KIRA_CONSTEXPR_DISPATCH0(hsum_); }
+    /// Sum of all elements in the vector, where the large ones are reduced across the threads.
+    ///
+    /// \see ParallelPolicy
+    [[nodiscard]] auto hsum(ParallelPolicy const &policy) const {
+        return derived().hsum_(policy);
+    }
+    /// Sum of all elements in the vector, where the rounding errors are compensated.
+    ///
+    /// \see detail::Summation::Compensated
+    [[nodiscard]] constexpr auto hsum_compensated() const {
+        return KIRA_CONSTEXPR_DISPATCH0(hsum_compensated_);
+    }
     /// Product of all elements in the vector.
     [[nodiscard]] constexpr auto hprod() const { return KIRA_CONSTEXPR_DISPATCH0(hprod_); }
     /// Calculate the maximum element in the vector.
@@ -254,6 +292,9 @@ public:
     // -----------------------------------------------------------------------------------------------------------------
     /// \{
 
+    //! NOTE(krr): The SIMD paths approximate the transcendental functions (`exp`, `log`, `sin`,
+    //! ...) within the error documented in `detail/Kernels.h`, instead of calling `std::`.
+
     /// Absolute value of all elements in the vector.
     [[nodiscard]] constexpr auto abs() const { return KIRA_CONSTEXPR_DISPATCH0(abs_); }
     /// Ceiling of all elements in the vector.
@@ -274,6 +315,30 @@ public:
     [[nodiscard]] constexpr auto neg() const { return KIRA_CONSTEXPR_DISPATCH0(neg_); }
     /// Square all elements in the vector.
     [[nodiscard]] constexpr auto sqr() const { return KIRA_CONSTEXPR_DISPATCH0(sqr_); }
+    /// Sine of all elements in the vector.
+    [[nodiscard]] constexpr auto sin() const { return KIRA_CONSTEXPR_DISPATCH0(sin_); }
+    /// Cosine of all elements in the vector.
+    [[nodiscard]] constexpr auto cos() const { return KIRA_CONSTEXPR_DISPATCH0(cos_); }
+    /// Arc sine of all elements in the vector.
+    [[nodiscard]] constexpr auto asin() const { return KIRA_CONSTEXPR_DISPATCH0(asin_); }
+    /// Arc cosine of all elements in the vector.
+    [[nodiscard]] constexpr auto acos() const { return KIRA_CONSTEXPR_DISPATCH0(acos_); }
+    /// Arc tangent of all elements in the vector.
+    [[nodiscard]] constexpr auto atan() const { return KIRA_CONSTEXPR_DISPATCH0(atan_); }
+
+    /// Element-wise arc tangent of `*this / rhs`, using the signs to determine the quadrant.
+    ///
+    /// \param rhs can be a scalar or a vector.
+    [[nodiscard]] constexpr auto atan2(auto const &rhs) const {
+        return KIRA_CONSTEXPR_DISPATCH1(atan2_, rhs);
+    }
+
+    /// Element-wise power, i.e., `*this` raised to `rhs`.
+    ///
+    /// \param rhs can be a scalar or a vector.
+    [[nodiscard]] constexpr auto pow(auto const &rhs) const {
+        return KIRA_CONSTEXPR_DISPATCH1(pow_, rhs);
+    }
 
     /// \}
     // -----------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "Lazy.h"
+#include "SoA.h"
+#include "Traits.h"
+#include "detail/Packet.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): The indexed views read and write a vecteur through an index buffer, e.g., the corners
+//! of the faces of a mesh, s.t. the per-face and per-vertex passes are written as the vecteur
+//! expressions instead of the scalar loops:
+//!
+//!     // `i0`, `i1`, `i2` are the first, second and third corners of the faces.
+//!     auto const p0 = gather(vertices, i0), p1 = gather(vertices, i1), p2 = gather(vertices, i2);
+//!     Vec3fSoA const n = (p1 - p0).cross(p2 - p0);      // area-weighted face normals
+//!     Vec3fSoA normals(vertices.size(), 0.0F);
+//!     scatter(normals, i0) += n;                           // accumulate to the vertices
+//!
+//! `gather(source, indices)` is a lazy expression of `indices.size()` elements, whose packets are
+//! loaded by `GatherIndex`. It references both the source and the indices, thus must not outlive
+//! them.
+//!
+//! `scatter(target, indices) += expr` adds `expr[i]` to `target[indices[i]]`. The indices might
+//! repeat (a vertex is shared by several faces), thus the lanes of a packet are added one by one by
+//! default. `conflict_free()` promises that no index repeats, e.g., the faces of a color of a
+//! pre-colored mesh, which is then added a packet at a time by `GatherIndex` and `ScatterIndex`.
+
+/// A contiguous buffer of integer indices, which outlives the expression, i.e., not a temporary
+/// container.
+template <typename Indices>
+concept is_index_range =
+    std::ranges::contiguous_range<Indices> and std::ranges::sized_range<Indices> and
+    std::ranges::borrowed_range<Indices> and
+    std::is_integral_v<std::ranges::range_value_t<Indices>>;
+
+/// A leaf vecteur, whose elements are contiguous and stored as is, i.e., not narrow.
+template <typename Source>
+concept is_gather_source = is_leaf_vecteur<Source> and requires(Source const &source) {
+    { source.data() } -> std::same_as<typename Source::Scalar const *>;
+};
+
+namespace detail {
+template <is_index_range Indices> constexpr auto index_span(Indices &&indices) {
+    using Index = std::ranges::range_value_t<Indices>;
+    return std::span<Index const>(std::ranges::data(indices), std::ranges::size(indices));
+}
+} // namespace detail
+
+/// `source[indices[i]]`, see \c gather.
+template <typename Source, typename Index>
+struct GatherOp : VecteurImpl<
+                      typename Source::Scalar, std::dynamic_extent, VecteurBackend::Lazy, false,
+                      GatherOp<Source, Index>>,
+                  VecteurLazyBase<GatherOp<Source, Index>>,
+                  detail::no_assignment_operator {
+private:
+    Source const &source;
+    std::span<Index const> indices;
+
+public:
+    using ConstexprImpl = GatherOp;
+    static constexpr int height = 1;
+    static constexpr bool packetable = detail::is_gather_index<typename Source::Scalar, Index>();
+
+    constexpr GatherOp(Source const &source, std::span<Index const> indices)
+        : source(source), indices(indices) {}
+
+public:
+    [[nodiscard]] constexpr auto entry(auto i) const {
+        return source.entry(static_cast<std::size_t>(indices[i]));
+    }
+
+    /// Gather the packet starting at the element `i`. The lanes past the remainder gather the
+    /// element 0 of the source, which exists since there is a remainder to gather.
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const
+        requires(packetable)
+    {
+        return detail::hn::GatherIndex(
+            tag, source.data(), detail::packet_indices(tag, indices.data() + i, lanes)
+        );
+    }
+
+    [[nodiscard]] constexpr auto size() const { return indices.size(); }
+};
+
+/// Gather `source[indices[i]]` into a lazy expression of `indices.size()` elements.
+///
+/// \note The indices must be in `[0, source.size())`, which is only checked by the element-wise
+/// evaluation in the debug builds. The unsigned indices must also be less than `2^31`.
+template <is_gather_source Source, is_index_range Indices>
+[[nodiscard]] constexpr auto gather(Source const &source KIRA_LIFETIME_BOUND, Indices &&indices) {
+    return GatherOp(source, detail::index_span(indices));
+}
+
+/// How the lanes of a packet are added by \c VecteurScatter.
+enum class ScatterMode : uint8_t {
+    /// The indices might repeat, thus the lanes are added one by one.
+    Conflicting,
+    /// No index repeats, thus a packet is gathered, added and scattered at once.
+    ConflictFree,
+};
+
+/// The sink of `scatter(target, indices) += expr`, see \c scatter.
+template <typename Target, typename Index> class VecteurScatter {
+    using Scalar = typename Target::Scalar;
+
+    Target &target;
+    std::span<Index const> indices;
+    ScatterMode mode;
+
+public:
+    VecteurScatter(Target &target, std::span<Index const> indices, ScatterMode mode)
+        : target(target), indices(indices), mode(mode) {}
+
+    /// Promise that no index repeats.
+    [[nodiscard]] VecteurScatter conflict_free() const {
+        return {target, indices, ScatterMode::ConflictFree};
+    }
+
+    /// `target[indices[i]] += rhs[i]` for `i` in `[0, indices.size())`.
+    ///
+    /// \note `rhs` must not read `target`, since the packets are evaluated while it is written.
+    template <is_vecteur RHS> void operator+=(RHS const &rhs) {
+        KIRA_ASSERT(
+            rhs.size() == indices.size(), "Size mismatch: {} != {}", rhs.size(), indices.size()
+        );
+
+        std::size_t i = 0;
+        Scalar *data = target.data();
+        if constexpr (packetable<RHS>()) {
+            auto const tag = detail::PacketTag<Scalar>();
+            auto const lanes = detail::hn::Lanes(tag);
+            auto const full = detail::FullPacket{};
+            HWY_ALIGN Scalar values[HWY_MAX_BYTES / sizeof(Scalar)];
+            if (mode == ScatterMode::ConflictFree) {
+                for (; i + lanes <= indices.size(); i += lanes) {
+                    auto const idx = detail::packet_indices(tag, indices.data() + i, full);
+                    auto const old = detail::hn::GatherIndex(tag, data, idx);
+                    detail::hn::ScatterIndex(
+                        detail::hn::Add(old, rhs.packet(tag, i, full)), tag, data, idx
+                    );
+                }
+            } else {
+                for (; i + lanes <= indices.size(); i += lanes) {
+                    detail::hn::Store(rhs.packet(tag, i, full), tag, values);
+                    for (std::size_t lane = 0; lane < lanes; ++lane)
+                        data[indices[i + lane]] += values[lane];
+                }
+            }
+
+            // The remainder is evaluated as a masked packet as well, and added one by one.
+            if (auto const remaining = indices.size() - i; remaining > 0) {
+                detail::hn::Store(rhs.packet(tag, i, remaining), tag, values);
+                for (std::size_t lane = 0; lane < remaining; ++lane)
+                    data[indices[i + lane]] += values[lane];
+            }
+            return;
+        }
+
+        for (; i < indices.size(); ++i)
+            data[indices[i]] += rhs.entry(i);
+    }
+
+private:
+    template <typename RHS> static consteval bool packetable() {
+        if constexpr (requires { RHS::packetable; })
+            return RHS::packetable and std::is_same_v<typename RHS::Scalar, Scalar> and
+                   detail::is_gather_index<Scalar, Index>();
+        else
+            return false;
+    }
+};
+
+/// Add to `target` through `indices`, i.e., `scatter(target, indices) += expr`.
+///
+/// \note The indices must be in `[0, target.size())`, see \c gather.
+template <is_gather_source Target, is_index_range Indices>
+[[nodiscard]] auto scatter(Target &target KIRA_LIFETIME_BOUND, Indices &&indices) {
+    return VecteurScatter(target, detail::index_span(indices), ScatterMode::Conflicting);
+}
+
+/// \name SoA views
+/// \{
+
+/// Gather the points `source.point(indices[i])`, a gather per lane.
+template <typename Scalar, std::size_t Dim, is_index_range Indices>
+[[nodiscard]] constexpr auto gather(
+    VecteurSoA<Scalar, Dim> const &source KIRA_LIFETIME_BOUND, Indices &&indices
+) {
+    auto const span = detail::index_span(indices);
+    return detail::make_soa<Dim>([&](std::size_t d) {
+        return GatherOp(source.lane(d), span);
+    });
+}
+
+/// The sink of `scatter(soa, indices) += expr`, a scatter per lane.
+template <typename Scalar, std::size_t Dim, typename Index> class VecteurSoAScatter {
+    VecteurSoA<Scalar, Dim> &target;
+    std::span<Index const> indices;
+    ScatterMode mode;
+
+public:
+    VecteurSoAScatter(
+        VecteurSoA<Scalar, Dim> &target, std::span<Index const> indices, ScatterMode mode
+    )
+        : target(target), indices(indices), mode(mode) {}
+
+    /// Promise that no index repeats.
+    [[nodiscard]] VecteurSoAScatter conflict_free() const {
+        return {target, indices, ScatterMode::ConflictFree};
+    }
+
+    /// `target.point(indices[i]) += rhs.point(i)`, where `rhs` must not read `target`.
+    template <is_vecteur_soa RHS> void operator+=(RHS const &rhs) {
+        static_assert(RHS::Dim == Dim, "The dimensions of the operands must be the same.");
+        for (std::size_t d = 0; d < Dim; ++d)
+            VecteurScatter(target.lane(d), indices, mode) += rhs.lane(d);
+    }
+};
+
+/// Add the points to `target` through `indices`, see \c scatter.
+template <typename Scalar, std::size_t Dim, is_index_range Indices>
+[[nodiscard]] auto scatter(VecteurSoA<Scalar, Dim> &target KIRA_LIFETIME_BOUND, Indices &&indices) {
+    return VecteurSoAScatter(target, detail::index_span(indices), ScatterMode::Conflicting);
+}
+/// \}
+} // namespace kira::vecteur
+
+namespace kira {
+using vecteur::gather;
+using vecteur::GatherOp;
+using vecteur::scatter;
+using vecteur::ScatterMode;
+} // namespace kira
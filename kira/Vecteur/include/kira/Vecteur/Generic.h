@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <type_traits>
 
 #include "kira/Assertions.h"
@@ -211,15 +212,54 @@ public:
     KIRA_FORALL_ARITHMETIC0(neg_, detail::neg)     /// @8
     KIRA_FORALL_ARITHMETIC0(sqr_, detail::sqr)     /// @9
 
+    KIRA_FORALL_ARITHMETIC0(sin_, std::sin)   /// @10
+    KIRA_FORALL_ARITHMETIC0(cos_, std::cos)   /// @11
+    KIRA_FORALL_ARITHMETIC0(asin_, std::asin) /// @12
+    KIRA_FORALL_ARITHMETIC0(acos_, std::acos) /// @13
+    KIRA_FORALL_ARITHMETIC0(atan_, std::atan) /// @14
+
     // krr: similar functions can be added here.
-#undef KIRA_FORALL_ARITHMETIC
+#undef KIRA_FORALL_ARITHMETIC0
+
+#define KIRA_FORALL_ARITHMETIC1(name, op)                                                          \
+    template <is_vecteur RHS>                                                                      \
+    constexpr auto name(RHS const &rhs) const                                                      \
+        requires(is_static_operable<VecteurImpl, RHS>)                                             \
+    {                                                                                              \
+        CheckDynamicOperable(this->derived(), rhs);                                                \
+        typename PromotedType<Vecteur<Scalar, Size, Base::get_backend()>, RHS>::result result;     \
+        if constexpr (decltype(result)::is_dynamic())                                              \
+            result.realloc(this->size());                                                          \
+        for (std::size_t i = 0; i < this->size(); ++i)                                             \
+            result.entry(i) = op(entry(i), rhs.entry(i));                                          \
+        return result;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    template <typename RHS>                                                                        \
+    constexpr auto name(RHS const &rhs) const                                                      \
+        requires(std::is_arithmetic_v<RHS>)                                                        \
+    {                                                                                              \
+        typename PromotedType<Vecteur<Scalar, Size, Base::get_backend()>, RHS>::result result;     \
+        if constexpr (decltype(result)::is_dynamic())                                              \
+            result.realloc(this->size());                                                          \
+        for (std::size_t i = 0; i < this->size(); ++i)                                             \
+            result.entry(i) = op(entry(i), rhs);                                                   \
+        return result;                                                                             \
+    }
+
+    KIRA_FORALL_ARITHMETIC1(atan2_, std::atan2) /// @15
+    KIRA_FORALL_ARITHMETIC1(pow_, std::pow)     /// @16
+#undef KIRA_FORALL_ARITHMETIC1
     /// \}
     // -----------------------------------------------------------------------------------------------------------------
 };
 
 template <typename Scalar, std::size_t Size, VecteurBackend backend>
 struct Vecteur : VecteurImpl<Scalar, Size, backend, false, Vecteur<Scalar, Size, backend>> {
-    static_assert(std::is_arithmetic_v<Scalar>, "Scalar must be an arithmetic type (for now).");
+    static_assert(
+        std::is_arithmetic_v<Scalar> or is_narrow_scalar<Scalar>,
+        "Scalar must be an arithmetic or a narrow floating-point type (for now)."
+    );
     static_assert(Size > 0, "Size must be greater than 0.");
 
     using Base = VecteurImpl<Scalar, Size, backend, false, Vecteur<Scalar, Size, backend>>;
@@ -1,15 +1,14 @@
 #pragma once
 
-#include <hwy/highway.h>
+#include <cstdint>
 
 #include "kira/Compiler.h"
 
 #include "Base.h"
 #include "Traits.h"
+#include "detail/Kernels.h"
 
 namespace kira::vecteur {
-namespace hn = hwy::HWY_NAMESPACE;
-
 #if defined(__CUDA_ARCH__)
 /// A Fake a non-constexpr base when all implementations are not presented.
 template <typename Scalar, std::size_t Size, typename Derived>
@@ -22,12 +21,26 @@ struct VecteurImpl<Scalar, Size, VecteurBackend::Generic, false, Derived>
     using Base::operator=;
 };
 #else
+/// The Highway target selected at runtime for the SIMD kernels, e.g. `HWY_AVX2`.
+///
+/// \note The target is the best one in `HWY_TARGETS` supported by the host CPU. It is chosen at
+/// the first call of any kernel and stays the same afterwards.
+[[nodiscard]] int64_t HighwayTarget();
+
+/// The name of \c HighwayTarget(), e.g. "AVX2" or "AVX3". Useful for the logs.
+[[nodiscard]] char const *HighwayTargetName();
+
 template <typename Scalar, std::size_t Size, typename Derived>
 struct VecteurImpl<Scalar, Size, VecteurBackend::Generic, false, Derived>
     : VecteurImpl<Scalar, Size, VecteurBackend::Generic, true, Derived> {
 private:
     using Base = VecteurImpl<Scalar, Size, VecteurBackend::Generic, true, Derived>;
 
+    //! NOTE(krr): The kernels are an indirect call away, while small static loops are fully
+    //! unrolled and vectorized by the compiler. Only route the larger ones to the kernels.
+    static constexpr bool UseKernels =
+        detail::is_kernel_scalar<Scalar> and (Size == std::dynamic_extent or Size >= 16);
+
 public:
     using Ref = std::add_lvalue_reference_t<Scalar>;
     using ConstRef = std::add_lvalue_reference_t<Scalar const>;
@@ -39,69 +52,208 @@ public:
     using Base::operator=;
 
 public:
-    // Use the base class's implementation.
-    using Base::add_;
-    using Base::rsqrt_;
-    using Base::sqrt_;
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Binary arithmetic interface
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
 
-private:
-    KIRA_FORCEINLINE auto strip_mining(auto const &loopBody) const {
-        std::size_t i = 0;
-
-        if constexpr (Derived::is_dynamic() or Derived::Size >= 4) {
-            auto const tag = hn::ScalableTag<Scalar>();
-            auto const lanes = hn::Lanes(tag);
-            for (; i + lanes < this->size(); i += lanes)
-                loopBody(tag, i);
-        }
+    //! NOTE(krr): The operators below hide the ones of the base class and forward to them if the
+    //! operands cannot be routed to the kernels. Only the operands of the same scalar type are
+    //! routed, i.e., a scalar operand is converted only if the promoted type is still `Scalar`,
+    //! the rest are promoted element-wise by the generic implementation.
+
+    template <typename Other> static constexpr bool IsKernelOperand = [] {
+        if constexpr (is_vecteur<Other>)
+            return UseKernels and std::is_same_v<typename Other::Scalar, Scalar>;
+        else
+            return UseKernels and std::is_same_v<std::common_type_t<Scalar, Other>, Scalar>;
+    }();
 
-        for (; i < this->size(); ++i)
-            loopBody(hn::CappedTag<Scalar, 1>(), i);
+#define KIRA_HIGHWAY_BINARY_VV(name, op, constraint)                                               \
+    template <is_vecteur RHS>                                                                      \
+    auto name(RHS const &rhs) const                                                                \
+        requires(constraint)                                                                       \
+    {                                                                                              \
+        if constexpr (IsKernelOperand<RHS>) {                                                      \
+            CheckDynamicOperable(this->derived(), rhs);                                            \
+            typename PromotedType<Vecteur<Scalar, Size, Base::get_backend()>, RHS>::result result; \
+            if constexpr (decltype(result)::is_dynamic())                                          \
+                result.realloc(this->size());                                                      \
+            detail::BinaryKernel(op, this->data(), rhs.data(), result.data(), this->size());       \
+            return result;                                                                         \
+        } else {                                                                                   \
+            return Base::name(rhs);                                                                \
+        }                                                                                          \
     }
 
+#define KIRA_HIGHWAY_BINARY_VS(name, op)                                                           \
+    template <typename RHS>                                                                        \
+        requires(std::is_arithmetic_v<RHS>)                                                        \
+    auto name(RHS const &rhs) const {                                                              \
+        if constexpr (IsKernelOperand<RHS>) {                                                      \
+            auto result = Derived();                                                               \
+            if constexpr (Derived::is_dynamic())                                                   \
+                result.realloc(this->size());                                                      \
+            detail::BinaryKernel(op, this->data(), Scalar(rhs), result.data(), this->size());      \
+            return result;                                                                         \
+        } else {                                                                                   \
+            return Base::name(rhs);                                                                \
+        }                                                                                          \
+    }
+
+#define KIRA_HIGHWAY_BINARY_SV(name, op)                                                           \
+    template <typename LHS>                                                                        \
+        requires(std::is_arithmetic_v<LHS>)                                                        \
+    auto name(LHS const &lhs) const {                                                              \
+        if constexpr (IsKernelOperand<LHS>) {                                                      \
+            auto result = Derived();                                                               \
+            if constexpr (Derived::is_dynamic())                                                   \
+                result.realloc(this->size());                                                      \
+            detail::BinaryKernel(op, Scalar(lhs), this->data(), result.data(), this->size());      \
+            return result;                                                                         \
+        } else {                                                                                   \
+            return Base::name(lhs);                                                                \
+        }                                                                                          \
+    }
+
+#define KIRA_HIGHWAY_ARITHMETIC_OPERATOR(name, op)                                                 \
+    KIRA_HIGHWAY_BINARY_VV(name, op, true)                                                         \
+    KIRA_HIGHWAY_BINARY_VS(name, op)                                                               \
+    KIRA_HIGHWAY_BINARY_SV(r##name, op)
+
+    KIRA_HIGHWAY_ARITHMETIC_OPERATOR(add_, detail::BinaryKernelOp::Add)
+    KIRA_HIGHWAY_ARITHMETIC_OPERATOR(sub_, detail::BinaryKernelOp::Sub)
+    KIRA_HIGHWAY_ARITHMETIC_OPERATOR(mul_, detail::BinaryKernelOp::Mul)
+    KIRA_HIGHWAY_ARITHMETIC_OPERATOR(div_, detail::BinaryKernelOp::Div)
+#undef KIRA_HIGHWAY_ARITHMETIC_OPERATOR
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
 public:
-    /// Additionally implement the operation for the generic backend.
-    ///
-    /// Q: as for add, does this implementation gives better performance than the generic one?
-    /// A: not necessarily. The generic implementation is already well-optimized through modern
-    /// compilers.
-    auto add_(Derived const &rhs) const {
-        CheckDynamicOperable(this->derived(), rhs);
-
-        auto result = Derived();
-        if constexpr (Derived::is_dynamic())
-            result.realloc(this->size());
-        this->strip_mining([&](auto tag, std::size_t i) {
-            auto const v1 = hn::LoadU(tag, this->data() + i);
-            auto const v2 = hn::LoadU(tag, rhs.data() + i);
-            hn::StoreU(hn::Add(v1, v2), tag, result.data() + i);
-        });
-        return result;
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Binary comparable proxy
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+    KIRA_HIGHWAY_BINARY_VV(
+        max_, detail::BinaryKernelOp::Max, (is_static_operable<VecteurImpl, RHS>)
+    )
+    KIRA_HIGHWAY_BINARY_VS(max_, detail::BinaryKernelOp::Max)
+    KIRA_HIGHWAY_BINARY_VV(
+        min_, detail::BinaryKernelOp::Min, (is_static_operable<VecteurImpl, RHS>)
+    )
+    KIRA_HIGHWAY_BINARY_VS(min_, detail::BinaryKernelOp::Min)
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Reduction arithmetic proxy
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+#define KIRA_HIGHWAY_REDUCE_VV(name, op, summation)                                                \
+    template <is_vecteur RHS>                                                                      \
+    auto name(RHS const &rhs) const                                                                \
+        requires(is_static_operable<VecteurImpl, RHS>)                                             \
+    {                                                                                              \
+        if constexpr (IsKernelOperand<RHS>) {                                                      \
+            CheckDynamicOperable(this->derived(), rhs);                                            \
+            return detail::ReduceKernel(op, summation, this->data(), rhs.data(), this->size());    \
+        } else {                                                                                   \
+            return Base::name(rhs);                                                                \
+        }                                                                                          \
     }
 
-    /// Vectorized square root.
-    auto sqrt_() const {
-        auto result = Derived();
-        if constexpr (Derived::is_dynamic())
-            result.realloc(this->size());
-        this->strip_mining([&](auto tag, std::size_t i) {
-            auto const v = hn::LoadU(tag, this->data() + i);
-            hn::StoreU(hn::Sqrt(v), tag, result.data() + i);
-        });
-        return result;
+#define KIRA_HIGHWAY_REDUCE_V(name, op, summation)                                                 \
+    auto name() const {                                                                            \
+        if constexpr (UseKernels)                                                                  \
+            return detail::ReduceKernel(op, summation, this->data(), nullptr, this->size());       \
+        else                                                                                       \
+            return Base::name();                                                                   \
     }
 
-    /// Vectorized reciprocal square root.
-    auto rsqrt_() const {
-        auto result = Derived();
-        if constexpr (Derived::is_dynamic())
-            result.realloc(this->size());
-        this->strip_mining([&](auto tag, std::size_t i) {
-            auto const v = hn::LoadU(tag, this->data() + i);
-            hn::StoreU(hn::ApproximateReciprocalSqrt(v), tag, result.data() + i);
-        });
-        return result;
+    KIRA_HIGHWAY_REDUCE_VV(dot_, detail::ReduceKernelOp::Dot, detail::Summation::Accumulators)
+    KIRA_HIGHWAY_REDUCE_VV(
+        dot_compensated_, detail::ReduceKernelOp::Dot, detail::Summation::Compensated
+    )
+    KIRA_HIGHWAY_REDUCE_V(hsum_, detail::ReduceKernelOp::Sum, detail::Summation::Accumulators)
+    KIRA_HIGHWAY_REDUCE_V(
+        hsum_compensated_, detail::ReduceKernelOp::Sum, detail::Summation::Compensated
+    )
+#undef KIRA_HIGHWAY_REDUCE_VV
+#undef KIRA_HIGHWAY_REDUCE_V
+
+    template <is_vecteur RHS>
+    auto near_(RHS const &rhs, auto const &epsilon) const
+        requires(is_static_operable<VecteurImpl, RHS>)
+    {
+        if constexpr (IsKernelOperand<RHS>) {
+            CheckDynamicOperable(this->derived(), rhs);
+            auto const sqrDist = detail::ReduceKernel(
+                detail::ReduceKernelOp::SqrDist, detail::Summation::Accumulators, this->data(),
+                rhs.data(), this->size()
+            );
+            return sqrDist <= epsilon * epsilon;
+        } else {
+            return Base::near_(rhs, epsilon);
+        }
     }
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Forall arithmetic proxy
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+#define KIRA_HIGHWAY_UNARY(name, op, enabled)                                                      \
+    auto name() const {                                                                            \
+        if constexpr (UseKernels and (enabled)) {                                                  \
+            auto result = Derived();                                                               \
+            if constexpr (Derived::is_dynamic())                                                   \
+                result.realloc(this->size());                                                      \
+            detail::UnaryKernel(op, this->data(), result.data(), this->size());                    \
+            return result;                                                                         \
+        } else {                                                                                   \
+            return Base::name();                                                                   \
+        }                                                                                          \
+    }
+
+    KIRA_HIGHWAY_UNARY(abs_, detail::UnaryKernelOp::Abs, true)
+    KIRA_HIGHWAY_UNARY(neg_, detail::UnaryKernelOp::Neg, true)
+    KIRA_HIGHWAY_UNARY(sqr_, detail::UnaryKernelOp::Sqr, true)
+    KIRA_HIGHWAY_UNARY(sqrt_, detail::UnaryKernelOp::Sqrt, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(rsqrt_, detail::UnaryKernelOp::RSqrt, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(floor_, detail::UnaryKernelOp::Floor, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(ceil_, detail::UnaryKernelOp::Ceil, std::is_floating_point_v<Scalar>)
+
+    //! NOTE(krr): The transcendental functions of the kernels are approximations, see
+    //! `detail::TranscendentalUlp` for their accuracy.
+    KIRA_HIGHWAY_UNARY(exp_, detail::UnaryKernelOp::Exp, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(log_, detail::UnaryKernelOp::Log, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(sin_, detail::UnaryKernelOp::Sin, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(cos_, detail::UnaryKernelOp::Cos, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(asin_, detail::UnaryKernelOp::Asin, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(acos_, detail::UnaryKernelOp::Acos, std::is_floating_point_v<Scalar>)
+    KIRA_HIGHWAY_UNARY(atan_, detail::UnaryKernelOp::Atan, std::is_floating_point_v<Scalar>)
+#undef KIRA_HIGHWAY_UNARY
+
+    KIRA_HIGHWAY_BINARY_VV(
+        atan2_, detail::BinaryKernelOp::Atan2, (is_static_operable<VecteurImpl, RHS>)
+    )
+    KIRA_HIGHWAY_BINARY_VS(atan2_, detail::BinaryKernelOp::Atan2)
+    KIRA_HIGHWAY_BINARY_VV(
+        pow_, detail::BinaryKernelOp::Pow, (is_static_operable<VecteurImpl, RHS>)
+    )
+    KIRA_HIGHWAY_BINARY_VS(pow_, detail::BinaryKernelOp::Pow)
+#undef KIRA_HIGHWAY_BINARY_VV
+#undef KIRA_HIGHWAY_BINARY_VS
+#undef KIRA_HIGHWAY_BINARY_SV
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
 };
 #endif
 } // namespace kira::vecteur
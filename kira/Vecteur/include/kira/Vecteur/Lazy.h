@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Optimizer.h"
+#include "Parallel.h"
 #include "Storage.h"
 #include "Traits.h"
 #include "detail/Lazy.h"
@@ -25,6 +26,78 @@ struct VecteurImpl<Scalar, Size, VecteurBackend::Lazy, false, Derived>
 template <typename T> struct UnitaryOp;
 template <typename BinaryOp, typename LHS, typename RHS> struct CwiseBinaryOp;
 template <typename UnaryOp, typename T> struct CwiseUnaryOp0;
+template <typename TernaryOp, typename T0, typename T1, typename T2> struct CwiseTernaryOp;
+
+namespace detail {
+/// Evaluate the elements `[begin, end)` of the expression into `out`.
+///
+/// The packetable expressions are evaluated a packet at a time, s.t. the whole tree is fused into
+/// a single vectorized loop, and the remainder is evaluated as a masked packet, see
+/// \c detail::FullPacket.
+template <is_vecteur Node>
+constexpr void
+eval_range(Node const &node, typename Node::Scalar *out, std::size_t begin, std::size_t end) {
+    std::size_t i = begin;
+    if constexpr (Node::packetable) {
+        if (not std::is_constant_evaluated()) {
+            auto const tag = PacketTag<typename Node::Scalar>();
+            auto const lanes = hn::Lanes(tag);
+            for (; i + lanes <= end; i += lanes)
+                store_packet(node.packet(tag, i, FullPacket{}), tag, out + i, FullPacket{});
+            if (i < end)
+                store_packet(node.packet(tag, i, end - i), tag, out + i, end - i);
+            return;
+        }
+    }
+
+    for (; i < end; ++i)
+        out[i] = node.entry(i);
+}
+
+/// Evaluate the expression into `out`, which holds `node.size()` elements.
+template <is_vecteur Node> constexpr void eval_into(Node const &node, typename Node::Scalar *out) {
+    eval_range(node, out, 0, node.size());
+}
+
+/// \copydoc eval_into, where the blocks are evaluated on the pool past the threshold.
+template <is_vecteur Node>
+void eval_into(Node const &node, typename Node::Scalar *out, ParallelPolicy const &policy) {
+    if (node.size() < policy.threshold)
+        return eval_into(node, out);
+    parallel_blocks<typename Node::Scalar>(node.size(), [&](std::size_t begin, std::size_t end) {
+        eval_range(node, out, begin, end);
+    });
+}
+
+/// Whether the dot products of `Scalar`s fuse the products into the sums, which follows the [fma]
+/// rules of the optimizer, see `VecteurOptimizerPolicy::fuseMulAdd`. The packets are then only
+/// used where they are fused as well, s.t. the result does not depend on the position or target.
+template <typename Scalar>
+inline constexpr bool is_dot_fused =
+    VecteurOptimizerPolicy::fuseMulAdd and std::is_floating_point_v<Scalar>;
+
+/// Whether the dot product of `LHS` and `RHS` is reduced a packet at a time.
+template <typename LHS, typename RHS>
+inline constexpr bool is_dot_packetable =
+    LHS::packetable and packetable_or_scalar<RHS, typename LHS::Scalar>() and
+    (not is_dot_fused<typename LHS::Scalar> or is_packet_mul_add_fused);
+
+/// `acc + a * b` of the dot products, see \c is_dot_fused.
+template <typename Scalar> constexpr Scalar dot_mul_add(Scalar a, Scalar b, Scalar acc) {
+    if constexpr (is_dot_fused<Scalar>)
+        return fused_mul_add(a, b, acc);
+    else
+        return acc + a * b;
+}
+
+/// \copydoc dot_mul_add for the packets.
+template <class V> KIRA_FORCEINLINE V packet_dot_mul_add(V a, V b, V acc) {
+    if constexpr (is_dot_fused<hn::TFromV<V>>)
+        return hn::MulAdd(a, b, acc);
+    else
+        return hn::Add(acc, hn::Mul(a, b));
+}
+} // namespace detail
 
 template <typename Derived> struct VecteurLazyBase : detail::VecteurReductionMixin<Derived> {
 private:
@@ -34,9 +107,12 @@ private:
     //! NOTE(krr): Early evaluation is implemented here. It determines the depth of the expression
     //! tree, evaluate the expression s.t. the tree will not be too large(which significantly blocks
     //! optimization).
+    //!
+    //! The packetable trees are fused into a single vectorized loop by `eval_()` without relying
+    //! on the compiler to see through them, thus they are allowed to grow much deeper.
     // NOLINTNEXTLINE
     template <typename T> constexpr decltype(auto) __collapse(T const &expr) const {
-        if constexpr (T::height >= 4)
+        if constexpr (T::height >= (T::packetable ? 16 : 4))
             // This deduces to a value *UnitaryOp* instead of a reference.
             return UnitaryOp{expr.eval()};
         else
@@ -79,20 +155,145 @@ private:
         return CwiseUnaryOp0<UnaryOp0<typename Derived::Scalar>, Derived>(derived_());
     }
 
+    /// Dot product of the elements `[begin, end)` one at a time, see \c detail::dot_mul_add.
+    template <is_vecteur RHS>
+    constexpr auto dot_elementwise_(RHS const &rhs, std::size_t begin, std::size_t end) const {
+        auto const &node = derived_();
+        using Result = decltype(node.entry(0_U) * rhs.entry(0_U));
+        return detail::reduce<Result>(end - begin, [&](Result acc, std::size_t i) {
+            return detail::dot_mul_add<Result>(node.entry(begin + i), rhs.entry(begin + i), acc);
+        });
+    }
+
 public:
     constexpr auto eval_() const {
         auto const &node = derived_();
 
         // Create a non-initialized leaf node.
-        // TODO: Strip-mine the loop using vectorized load.
         auto result = Vecteur<typename Derived::Scalar, Derived::Size, VecteurBackend::Lazy>();
         if constexpr (decltype(result)::is_dynamic())
             result.realloc(node.size());
-        for (size_t i = 0; i < node.size(); ++i)
-            result.entry(i) = node.entry(i);
+        detail::eval_into(node, result.data());
+        return result;
+    }
+
+    /// \copydoc eval_, where the blocks are evaluated on the pool, see \c ParallelPolicy.
+    auto eval_(ParallelPolicy const &policy) const {
+        auto const &node = derived_();
+
+        auto result = Vecteur<typename Derived::Scalar, Derived::Size, VecteurBackend::Lazy>();
+        if constexpr (decltype(result)::is_dynamic())
+            result.realloc(node.size());
+        detail::eval_into(node, result.data(), policy);
         return result;
     }
 
+    /// Sum the elements, where the patterns like `hsum(a * b)` are reduced by `dot()` directly.
+    ///
+    /// The packetable expressions are summed a packet at a time, see \c detail::reduce_packets.
+    constexpr auto hsum_() const {
+        using Scalar = typename Derived::Scalar;
+        if constexpr (VecteurReductionOptimizer<Derived>::rewritten) {
+            return VecteurReductionOptimizer<Derived>::hsum(derived_());
+        } else if constexpr (Derived::packetable) {
+            if (not std::is_constant_evaluated()) {
+                auto const &node = derived_();
+                return detail::reduce_packets<Scalar>(
+                    node.size(), [&](auto acc, auto tag, std::size_t i, auto lanes) {
+                        auto const v = node.packet(tag, i, lanes);
+                        return detail::hn::Add(acc, detail::zero_past(tag, v, lanes));
+                    }
+                );
+            }
+            return Scalar(detail::VecteurReductionMixin<Derived>::hsum_());
+        } else {
+            return detail::VecteurReductionMixin<Derived>::hsum_();
+        }
+    }
+
+    /// Dot product, where the packetable expressions are reduced a packet at a time.
+    template <is_vecteur RHS>
+    constexpr auto dot_(RHS const &rhs) const
+        requires(is_static_operable<Derived, RHS>)
+    {
+        using Scalar = typename Derived::Scalar;
+        auto const &node = derived_();
+        CheckDynamicOperable(node, rhs);
+        if constexpr (detail::is_dot_packetable<Derived, RHS>) {
+            if (not std::is_constant_evaluated()) {
+                return detail::reduce_packets<Scalar>(
+                    node.size(), [&](auto acc, auto tag, std::size_t i, auto lanes) {
+                        auto const v1 = detail::zero_past(tag, node.packet(tag, i, lanes), lanes);
+                        auto const v2 = detail::zero_past(tag, rhs.packet(tag, i, lanes), lanes);
+                        return detail::packet_dot_mul_add(v1, v2, acc);
+                    }
+                );
+            }
+            return Scalar(dot_elementwise_(rhs, 0, node.size()));
+        } else {
+            return dot_elementwise_(rhs, 0, node.size());
+        }
+    }
+
+    /// \copydoc hsum_, where the partial sums of the blocks are computed on the pool.
+    ///
+    /// \see ParallelPolicy
+    auto hsum_(ParallelPolicy const &policy) const {
+        using Scalar = typename Derived::Scalar;
+        auto const &node = derived_();
+        if (node.size() < policy.threshold)
+            return Scalar(hsum_());
+
+        auto const reduce = [&](std::size_t begin, std::size_t end) {
+            if constexpr (Derived::packetable) {
+                return detail::reduce_packets<Scalar>(
+                    end - begin, [&](auto acc, auto tag, std::size_t i, auto lanes) {
+                        auto const v = node.packet(tag, begin + i, lanes);
+                        return detail::hn::Add(acc, detail::zero_past(tag, v, lanes));
+                    }
+                );
+            } else {
+                auto sum = Scalar(0);
+                for (std::size_t i = begin; i < end; ++i)
+                    sum += Scalar(node.entry(i));
+                return sum;
+            }
+        };
+        return detail::parallel_reduce<Scalar>(node.size(), reduce);
+    }
+
+    /// \copydoc dot_, where the partial sums of the blocks are computed on the pool.
+    ///
+    /// \see ParallelPolicy
+    template <is_vecteur RHS>
+    auto dot_(RHS const &rhs, ParallelPolicy const &policy) const
+        requires(is_static_operable<Derived, RHS>)
+    {
+        using Scalar = typename Derived::Scalar;
+        auto const &node = derived_();
+        CheckDynamicOperable(node, rhs);
+        if (node.size() < policy.threshold)
+            return Scalar(dot_(rhs));
+
+        auto const reduce = [&](std::size_t begin, std::size_t end) {
+            if constexpr (detail::is_dot_packetable<Derived, RHS>) {
+                return detail::reduce_packets<Scalar>(
+                    end - begin, [&](auto acc, auto tag, std::size_t i, auto lanes) {
+                        auto const v1 = node.packet(tag, begin + i, lanes);
+                        auto const v2 = rhs.packet(tag, begin + i, lanes);
+                        return detail::packet_dot_mul_add(
+                            detail::zero_past(tag, v1, lanes), detail::zero_past(tag, v2, lanes),
+                            acc
+                        );
+                    }
+                );
+            } else {
+                return Scalar(dot_elementwise_(rhs, begin, end));
+            }
+        };
+        return detail::parallel_reduce<Scalar>(node.size(), reduce);
+    }
+
 public:
 #define KIRA_LAZY_ARITHMETIC_OP(name, op)                                                          \
     template <is_vecteur RHS> constexpr auto name(RHS const &rhs) const {                          \
@@ -147,6 +348,34 @@ public:
         return __make_binary_op_vs<detail::BinaryOpMin>(rhs);
     }
 
+    template <is_vecteur RHS>
+    constexpr auto atan2_(RHS const &rhs) const
+        requires(is_static_operable<Derived, RHS>)
+    {
+        return __make_binary_op_vv<detail::BinaryOpAtan2>(rhs);
+    }
+
+    template <typename RHS>
+    constexpr auto atan2_(RHS const &rhs) const
+        requires(std::is_arithmetic_v<RHS>)
+    {
+        return __make_binary_op_vs<detail::BinaryOpAtan2>(rhs);
+    }
+
+    template <is_vecteur RHS>
+    constexpr auto pow_(RHS const &rhs) const
+        requires(is_static_operable<Derived, RHS>)
+    {
+        return __make_binary_op_vv<detail::BinaryOpPow>(rhs);
+    }
+
+    template <typename RHS>
+    constexpr auto pow_(RHS const &rhs) const
+        requires(std::is_arithmetic_v<RHS>)
+    {
+        return __make_binary_op_vs<detail::BinaryOpPow>(rhs);
+    }
+
 public:
     constexpr auto abs_() const { return __make_unary_op0<detail::UnaryOp0Abs>(); }
     constexpr auto ceil_() const { return __make_unary_op0<detail::UnaryOp0Ceil>(); }
@@ -158,6 +387,11 @@ public:
     constexpr auto rsqrt_() const { return __make_unary_op0<detail::UnaryOp0RSqrt>(); }
     constexpr auto neg_() const { return __make_unary_op0<detail::UnaryOp0Neg>(); }
     constexpr auto sqr_() const { return __make_unary_op0<detail::UnaryOp0Sqr>(); }
+    constexpr auto sin_() const { return __make_unary_op0<detail::UnaryOp0Sin>(); }
+    constexpr auto cos_() const { return __make_unary_op0<detail::UnaryOp0Cos>(); }
+    constexpr auto asin_() const { return __make_unary_op0<detail::UnaryOp0Asin>(); }
+    constexpr auto acos_() const { return __make_unary_op0<detail::UnaryOp0Acos>(); }
+    constexpr auto atan_() const { return __make_unary_op0<detail::UnaryOp0Atan>(); }
 };
 
 /// Return the constructor itself.
@@ -176,9 +410,13 @@ private:
 public:
     using ConstexprImpl = UnitaryOp;
     static constexpr int height = T::height;
+    static constexpr bool packetable = T::packetable;
 
     explicit UnitaryOp(T t) : t(std::move(t)) {}
     [[nodiscard]] constexpr auto entry(auto i) const { return t.entry(i); }
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const {
+        return t.packet(tag, i, lanes);
+    }
     [[nodiscard]] constexpr auto size() const { return t.size(); }
 };
 
@@ -193,9 +431,14 @@ private:
     typename VecteurLazyOperandType<RHS>::type rhs;
 
 public:
+    using Op = BinaryOp;
     using ConstexprImpl = CwiseBinaryOp;
     static constexpr int height =
         std::max(detail::height_or_1<LHS>(), detail::height_or_1<RHS>()) + 1;
+    static constexpr bool packetable =
+        BinaryOp::has_packet and
+        detail::packetable_or_scalar<LHS, typename PromotedType<LHS, RHS>::type>() and
+        detail::packetable_or_scalar<RHS, typename PromotedType<LHS, RHS>::type>();
     constexpr CwiseBinaryOp(const LHS &lhs, const RHS &rhs) : lhs(lhs), rhs(rhs) {
         if constexpr (is_vecteur<LHS> and is_vecteur<RHS>) {
             static_assert(is_static_operable<LHS, RHS>, "Incompatible sizes.");
@@ -208,6 +451,16 @@ public:
         return BinaryOp{}(detail::entry_or_scalar(lhs, i), detail::entry_or_scalar(rhs, i));
     }
 
+    /// Evaluate the packet starting at the element `i`, see \c detail::FullPacket for `lanes`.
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const
+        requires(packetable)
+    {
+        return BinaryOp::packet(
+            detail::packet_or_scalar(lhs, tag, i, lanes),
+            detail::packet_or_scalar(rhs, tag, i, lanes)
+        );
+    }
+
     [[nodiscard]] constexpr auto size() const {
         // Different sized vecteur are checked at construction time.
         return std::max<size_t>(detail::size_or_1(lhs), detail::size_or_1(rhs));
@@ -227,14 +480,80 @@ private:
     typename VecteurLazyOperandType<T>::type operand;
 
 public:
+    using Op = UnaryOp0;
     using ConstexprImpl = CwiseUnaryOp0;
     static constexpr int height = detail::height_or_1<T>() + 1;
+    static constexpr bool packetable = UnaryOp0::has_packet and T::packetable;
     constexpr CwiseUnaryOp0(T const &operand) : operand(operand) {}
 
 public:
     [[nodiscard]] constexpr auto entry(auto i) const { return UnaryOp0{}(operand.entry(i)); }
 
+    /// Evaluate the packet starting at the element `i`, see \c detail::FullPacket for `lanes`.
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const
+        requires(packetable)
+    {
+        return UnaryOp0::packet(operand.packet(tag, i, lanes));
+    }
+
     [[nodiscard]] constexpr auto size() const { return operand.size(); }
+
+    constexpr decltype(auto) operand_op() const { return operand; }
+};
+
+/// `TernaryOp(t0, t1, t2)`, which is only created by the `VecteurOptimizer`.
+template <typename TernaryOp, typename T0, typename T1, typename T2>
+struct CwiseTernaryOp
+    : VecteurImpl<
+          typename PromotedType<typename PromotedType<T0, T1>::result, T2>::type,
+          PromotedType<typename PromotedType<T0, T1>::result, T2>::size, VecteurBackend::Lazy,
+          false, CwiseTernaryOp<TernaryOp, T0, T1, T2>>,
+      VecteurLazyBase<CwiseTernaryOp<TernaryOp, T0, T1, T2>>,
+      detail::no_assignment_operator {
+private:
+    using Promoted = PromotedType<typename PromotedType<T0, T1>::result, T2>;
+
+    typename VecteurLazyOperandType<T0>::type t0;
+    typename VecteurLazyOperandType<T1>::type t1;
+    typename VecteurLazyOperandType<T2>::type t2;
+
+public:
+    using Op = TernaryOp;
+    using ConstexprImpl = CwiseTernaryOp;
+    static constexpr int height =
+        1 + std::max(
+                {detail::height_or_1<T0>(), detail::height_or_1<T1>(), detail::height_or_1<T2>()}
+            );
+    static constexpr bool packetable =
+        TernaryOp::has_packet and detail::packetable_or_scalar<T0, typename Promoted::type>() and
+        detail::packetable_or_scalar<T1, typename Promoted::type>() and
+        detail::packetable_or_scalar<T2, typename Promoted::type>();
+    constexpr CwiseTernaryOp(T0 const &t0, T1 const &t1, T2 const &t2) : t0(t0), t1(t1), t2(t2) {}
+
+public:
+    [[nodiscard]] constexpr auto entry(auto i) const {
+        return TernaryOp{}(
+            detail::entry_or_scalar(t0, i), detail::entry_or_scalar(t1, i),
+            detail::entry_or_scalar(t2, i)
+        );
+    }
+
+    /// Evaluate the packet starting at the element `i`, see \c detail::FullPacket for `lanes`.
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const
+        requires(packetable)
+    {
+        return TernaryOp::packet(
+            detail::packet_or_scalar(t0, tag, i, lanes),
+            detail::packet_or_scalar(t1, tag, i, lanes),
+            detail::packet_or_scalar(t2, tag, i, lanes)
+        );
+    }
+
+    [[nodiscard]] constexpr auto size() const {
+        return std::max<size_t>(
+            {detail::size_or_1(t0), detail::size_or_1(t1), detail::size_or_1(t2)}
+        );
+    }
 };
 
 #define KIRA_VECTEUR_LEAF_TYPE Vecteur<Scalar, Size, VecteurBackend::Lazy>
@@ -253,6 +572,7 @@ public:
     using ConstRef = std::add_lvalue_reference_t<Scalar const>;
     using ConstexprImpl = VecteurImpl;
     static constexpr int height = 1;
+    static constexpr bool packetable = detail::is_packet_scalar<Scalar>;
 
     using Storage::Storage;
     using Storage::operator=;
@@ -268,6 +588,12 @@ public:
         return *(this->data() + i);
     }
 
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const
+        requires(packetable)
+    {
+        return detail::load_packet(tag, this->data() + i, lanes);
+    }
+
 public:
     template <is_vecteur RHS>
     constexpr VecteurImpl(RHS const &rhs)
@@ -275,8 +601,7 @@ public:
     {
         if constexpr (Base::is_dynamic())
             this->realloc(rhs.size());
-        for (size_t i = 0; i < rhs.size(); ++i)
-            entry(i) = rhs.entry(i);
+        detail::eval_into(rhs, this->data());
     }
 
     template <is_vecteur RHS>
@@ -285,8 +610,7 @@ public:
     {
         if constexpr (Base::is_dynamic())
             this->realloc(rhs.size());
-        for (size_t i = 0; i < rhs.size(); ++i)
-            entry(i) = rhs.entry(i);
+        detail::eval_into(rhs, this->data());
         return *this;
     }
 };
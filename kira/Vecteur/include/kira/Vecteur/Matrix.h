@@ -0,0 +1,485 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "Base.h"
+#include "Generic.h"
+#include "Highway.h"
+#include "Traits.h"
+#include "detail/Packet.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): `VecteurMatrix<Scalar, Rows, Cols>` is a small column-major matrix of 2x2 to 4x4,
+//! which mirrors the vecteur route: `VecteurMatrixImpl<..., true>` is the generic constexpr
+//! implementation, while `VecteurMatrixImpl<..., false>` hides the products with the packets of the
+//! static target when possible (see detail/Packet.h). The public operators pick the former in the
+//! constant evaluation.
+//!
+//! The vectors multiplied by the matrices are the generic static vecteurs, e.g., `Vec4f`.
+
+template <typename Scalar, std::size_t Rows, std::size_t Cols> struct VecteurMatrix;
+
+template <typename Scalar, std::size_t Rows, std::size_t Cols, bool IsConstexpr>
+struct VecteurMatrixImpl;
+
+template <typename T>
+concept is_vecteur_matrix = requires { std::decay_t<T>::IsVecteurMatrix; };
+
+template <typename Scalar, std::size_t Rows, std::size_t Cols>
+struct VecteurMatrixImpl<Scalar, Rows, Cols, true> {
+    static_assert(std::is_arithmetic_v<Scalar>, "Scalar must be an arithmetic type (for now).");
+    static_assert(
+        Rows >= 2 and Rows <= 4 and Cols >= 2 and Cols <= 4, "Only 2x2 to 4x4 are supported."
+    );
+
+    using Matrix = VecteurMatrix<Scalar, Rows, Cols>;
+    using Column = Vecteur<Scalar, Rows, VecteurBackend::Generic>;
+    using Row = Vecteur<Scalar, Cols, VecteurBackend::Generic>;
+    using ConstexprImpl = VecteurMatrixImpl;
+
+    static constexpr bool IsVecteurMatrix = true;
+
+    /// The columns, i.e., `storage[j][i]` is the element at the row `i` and the column `j`.
+    Scalar storage[Cols][Rows];
+
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Element access interface
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+    [[nodiscard]] static constexpr std::size_t rows() { return Rows; }
+    [[nodiscard]] static constexpr std::size_t cols() { return Cols; }
+
+    [[nodiscard]] constexpr Scalar const &operator()(std::size_t i, std::size_t j) const {
+        return storage[j][i];
+    }
+
+    [[nodiscard]] constexpr Scalar &operator()(std::size_t i, std::size_t j) {
+        return storage[j][i];
+    }
+
+    [[nodiscard]] constexpr Column col(std::size_t j) const {
+        Column result{};
+        for (std::size_t i = 0; i < Rows; ++i)
+            result[i] = storage[j][i];
+        return result;
+    }
+
+    [[nodiscard]] constexpr Row row(std::size_t i) const {
+        Row result{};
+        for (std::size_t j = 0; j < Cols; ++j)
+            result[j] = storage[j][i];
+        return result;
+    }
+
+    [[nodiscard]] constexpr Scalar *data() KIRA_LIFETIME_BOUND { return storage[0]; }
+    [[nodiscard]] constexpr Scalar const *data() const KIRA_LIFETIME_BOUND { return storage[0]; }
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Arithmetic interface
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+#define KIRA_MATRIX_CWISE(name, op)                                                                \
+    [[nodiscard]] constexpr Matrix name(Matrix const &rhs) const {                                 \
+        Matrix result{};                                                                           \
+        for (std::size_t j = 0; j < Cols; ++j)                                                     \
+            for (std::size_t i = 0; i < Rows; ++i)                                                 \
+                result.storage[j][i] = storage[j][i] op rhs.storage[j][i];                         \
+        return result;                                                                             \
+    }                                                                                              \
+                                                                                                   \
+    [[nodiscard]] constexpr Matrix name(Scalar const &rhs) const {                                 \
+        Matrix result{};                                                                           \
+        for (std::size_t j = 0; j < Cols; ++j)                                                     \
+            for (std::size_t i = 0; i < Rows; ++i)                                                 \
+                result.storage[j][i] = storage[j][i] op rhs;                                       \
+        return result;                                                                             \
+    }
+
+    KIRA_MATRIX_CWISE(add_, +)
+    KIRA_MATRIX_CWISE(sub_, -)
+    KIRA_MATRIX_CWISE(scale_, *)
+#undef KIRA_MATRIX_CWISE
+
+    /// Matrix product.
+    template <std::size_t K>
+    [[nodiscard]] constexpr auto mul_(VecteurMatrix<Scalar, Cols, K> const &rhs) const {
+        VecteurMatrix<Scalar, Rows, K> result{};
+        for (std::size_t j = 0; j < K; ++j) {
+            for (std::size_t i = 0; i < Rows; ++i) {
+                Scalar acc = storage[0][i] * rhs(0, j);
+                for (std::size_t k = 1; k < Cols; ++k)
+                    acc = detail::mul_add(storage[k][i], rhs(k, j), acc);
+                result(i, j) = acc;
+            }
+        }
+
+        return result;
+    }
+
+    /// Matrix-vector product.
+    [[nodiscard]] constexpr Column mul_(Row const &rhs) const {
+        Column result{};
+        for (std::size_t i = 0; i < Rows; ++i) {
+            Scalar acc = storage[0][i] * rhs[0];
+            for (std::size_t k = 1; k < Cols; ++k)
+                acc = detail::mul_add(storage[k][i], rhs[k], acc);
+            result[i] = acc;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool eq_(Matrix const &rhs) const {
+        for (std::size_t j = 0; j < Cols; ++j)
+            for (std::size_t i = 0; i < Rows; ++i)
+                if (storage[j][i] != rhs.storage[j][i])
+                    return false;
+        return true;
+    }
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+};
+
+#if defined(__CUDA_ARCH__) or (HWY_TARGET == HWY_SCALAR)
+/// No packets of 128 bits, thus only the generic implementation.
+template <typename Scalar, std::size_t Rows, std::size_t Cols>
+struct VecteurMatrixImpl<Scalar, Rows, Cols, false> : VecteurMatrixImpl<Scalar, Rows, Cols, true> {
+};
+#else
+template <typename Scalar, std::size_t Rows, std::size_t Cols>
+struct VecteurMatrixImpl<Scalar, Rows, Cols, false> : VecteurMatrixImpl<Scalar, Rows, Cols, true> {
+private:
+    using Base = VecteurMatrixImpl<Scalar, Rows, Cols, true>;
+
+    //! NOTE(krr): A column of 3 or 4 floats fits a 128-bit packet, which every target but
+    //! `HWY_SCALAR` provides. The products are then a broadcast and a multiply-add per column of
+    //! the left-hand side, without any shuffle. The doubles and the 2-row matrices are left to the
+    //! compiler.
+    static constexpr bool UsePackets = std::is_same_v<Scalar, float> and (Rows == 3 or Rows == 4);
+
+    using PacketTag = detail::hn::FixedTag<float, 4>;
+
+    template <typename T> static KIRA_FORCEINLINE auto load_column(T const *column) {
+        if constexpr (Rows == 4)
+            return detail::hn::LoadU(PacketTag(), column);
+        else
+            return detail::hn::LoadN(PacketTag(), column, Rows);
+    }
+
+    template <typename V, typename T> static KIRA_FORCEINLINE void store_column(V v, T *column) {
+        if constexpr (Rows == 4)
+            detail::hn::StoreU(v, PacketTag(), column);
+        else
+            detail::hn::StoreN(v, PacketTag(), column, Rows);
+    }
+
+    /// `sum_k lhs.col(k) * rhs[k]`, where `rhs` holds `Cols` scalars.
+    KIRA_FORCEINLINE auto combine_columns(Scalar const *rhs) const {
+        auto const tag = PacketTag();
+        auto acc = detail::hn::Mul(load_column(this->storage[0]), detail::hn::Set(tag, rhs[0]));
+        for (std::size_t k = 1; k < Cols; ++k)
+            acc = detail::hn::MulAdd(
+                load_column(this->storage[k]), detail::hn::Set(tag, rhs[k]), acc
+            );
+        return acc;
+    }
+
+public:
+    template <std::size_t K>
+    [[nodiscard]] auto mul_(VecteurMatrix<Scalar, Cols, K> const &rhs) const {
+        if constexpr (UsePackets) {
+            VecteurMatrix<Scalar, Rows, K> result;
+            for (std::size_t j = 0; j < K; ++j)
+                store_column(combine_columns(rhs.storage[j]), result.storage[j]);
+            return result;
+        } else {
+            return Base::mul_(rhs);
+        }
+    }
+
+    [[nodiscard]] auto mul_(typename Base::Row const &rhs) const {
+        if constexpr (UsePackets) {
+            typename Base::Column result;
+            store_column(combine_columns(rhs.data()), result.data());
+            return result;
+        } else {
+            return Base::mul_(rhs);
+        }
+    }
+};
+#endif
+
+/// A small column-major matrix.
+template <typename Scalar, std::size_t Rows, std::size_t Cols>
+struct VecteurMatrix : VecteurMatrixImpl<Scalar, Rows, Cols, false> {
+private:
+    using Base = VecteurMatrixImpl<Scalar, Rows, Cols, false>;
+    using ConstexprImpl = VecteurMatrixImpl<Scalar, Rows, Cols, true>;
+
+public:
+    using Column = typename Base::Column;
+    using Row = typename Base::Row;
+    using Vector3 = Vecteur<Scalar, 3, VecteurBackend::Generic>;
+
+    /// Default constructor, whose elements are uninitialized.
+    VecteurMatrix() = default;
+
+    /// Construct from the columns.
+    template <typename... Cs>
+    constexpr VecteurMatrix(Cs const &...columns)
+        requires(sizeof...(Cs) == Cols and (std::is_same_v<Cs, Column> and ...))
+    {
+        std::size_t j = 0;
+        ((set_col(j++, columns)), ...);
+    }
+
+    /// The matrix with `v` on the diagonal and zero elsewhere.
+    [[nodiscard]] static constexpr VecteurMatrix diagonal(Scalar const &v) {
+        VecteurMatrix result{};
+        for (std::size_t j = 0; j < Cols; ++j)
+            for (std::size_t i = 0; i < Rows; ++i)
+                result(i, j) = (i == j) ? v : Scalar(0);
+        return result;
+    }
+
+    [[nodiscard]] static constexpr VecteurMatrix identity() { return diagonal(Scalar(1)); }
+    [[nodiscard]] static constexpr VecteurMatrix zero() { return diagonal(Scalar(0)); }
+
+    constexpr void set_col(std::size_t j, Column const &column) {
+        for (std::size_t i = 0; i < Rows; ++i)
+            (*this)(i, j) = column[i];
+    }
+
+    constexpr void set_row(std::size_t i, Row const &row) {
+        for (std::size_t j = 0; j < Cols; ++j)
+            (*this)(i, j) = row[j];
+    }
+
+public:
+    [[nodiscard]] constexpr VecteurMatrix<Scalar, Cols, Rows> transpose() const {
+        VecteurMatrix<Scalar, Cols, Rows> result{};
+        for (std::size_t j = 0; j < Cols; ++j)
+            for (std::size_t i = 0; i < Rows; ++i)
+                result(j, i) = (*this)(i, j);
+        return result;
+    }
+
+    [[nodiscard]] constexpr Scalar trace() const
+        requires(Rows == Cols)
+    {
+        Scalar result = 0;
+        for (std::size_t i = 0; i < Rows; ++i)
+            result += (*this)(i, i);
+        return result;
+    }
+
+    /// Sum of the squares of all the elements.
+    [[nodiscard]] constexpr Scalar norm2() const {
+        Scalar result = 0;
+        for (std::size_t j = 0; j < Cols; ++j)
+            for (std::size_t i = 0; i < Rows; ++i)
+                result = detail::mul_add((*this)(i, j), (*this)(i, j), result);
+        return result;
+    }
+
+    /// Frobenius norm.
+    [[nodiscard]] constexpr Scalar norm() const { return std::sqrt(norm2()); }
+
+    [[nodiscard]] constexpr Scalar determinant() const
+        requires(Rows == Cols)
+    {
+        auto const &m = *this;
+        if constexpr (Rows == 2) {
+            return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+        } else if constexpr (Rows == 3) {
+            return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+                   m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+                   m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+        } else {
+            auto const [s, c] = minors4();
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] +
+                   s[5] * c[0];
+        }
+    }
+
+    /// The inverse matrix, by the adjugate and the determinant.
+    ///
+    /// \note The matrix must not be singular, which is not checked.
+    [[nodiscard]] constexpr VecteurMatrix inverse() const
+        requires(Rows == Cols and std::is_floating_point_v<Scalar>)
+    {
+        auto const &m = *this;
+        VecteurMatrix r{};
+        if constexpr (Rows == 2) {
+            auto const inv = Scalar(1) / determinant();
+            r(0, 0) = m(1, 1) * inv;
+            r(0, 1) = -m(0, 1) * inv;
+            r(1, 0) = -m(1, 0) * inv;
+            r(1, 1) = m(0, 0) * inv;
+        } else if constexpr (Rows == 3) {
+            r(0, 0) = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+            r(0, 1) = m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2);
+            r(0, 2) = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+            r(1, 0) = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+            r(1, 1) = m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0);
+            r(1, 2) = m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2);
+            r(2, 0) = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+            r(2, 1) = m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1);
+            r(2, 2) = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+            auto const det = m(0, 0) * r(0, 0) + m(0, 1) * r(1, 0) + m(0, 2) * r(2, 0);
+            auto const inv = Scalar(1) / det;
+            r = r.scale_(inv);
+        } else {
+            auto const [s, c] = minors4();
+            auto const inv = Scalar(1) / (s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] -
+                                          s[4] * c[1] + s[5] * c[0]);
+            r(0, 0) = m(1, 1) * c[5] - m(1, 2) * c[4] + m(1, 3) * c[3];
+            r(0, 1) = -m(0, 1) * c[5] + m(0, 2) * c[4] - m(0, 3) * c[3];
+            r(0, 2) = m(3, 1) * s[5] - m(3, 2) * s[4] + m(3, 3) * s[3];
+            r(0, 3) = -m(2, 1) * s[5] + m(2, 2) * s[4] - m(2, 3) * s[3];
+            r(1, 0) = -m(1, 0) * c[5] + m(1, 2) * c[2] - m(1, 3) * c[1];
+            r(1, 1) = m(0, 0) * c[5] - m(0, 2) * c[2] + m(0, 3) * c[1];
+            r(1, 2) = -m(3, 0) * s[5] + m(3, 2) * s[2] - m(3, 3) * s[1];
+            r(1, 3) = m(2, 0) * s[5] - m(2, 2) * s[2] + m(2, 3) * s[1];
+            r(2, 0) = m(1, 0) * c[4] - m(1, 1) * c[2] + m(1, 3) * c[0];
+            r(2, 1) = -m(0, 0) * c[4] + m(0, 1) * c[2] - m(0, 3) * c[0];
+            r(2, 2) = m(3, 0) * s[4] - m(3, 1) * s[2] + m(3, 3) * s[0];
+            r(2, 3) = -m(2, 0) * s[4] + m(2, 1) * s[2] - m(2, 3) * s[0];
+            r(3, 0) = -m(1, 0) * c[3] + m(1, 1) * c[1] - m(1, 2) * c[0];
+            r(3, 1) = m(0, 0) * c[3] - m(0, 1) * c[1] + m(0, 2) * c[0];
+            r(3, 2) = -m(3, 0) * s[3] + m(3, 1) * s[1] - m(3, 2) * s[0];
+            r(3, 3) = m(2, 0) * s[3] - m(2, 1) * s[1] + m(2, 2) * s[0];
+            r = r.scale_(inv);
+        }
+
+        return r;
+    }
+
+    /// Transform the point `p`, i.e., `(*this * (p, 1)).xyz`, assuming an affine transformation.
+    [[nodiscard]] constexpr auto transform_point(Vector3 const &p) const
+        requires(Rows == 4 and Cols == 4)
+    {
+        return truncate(product(Row(p[0], p[1], p[2], Scalar(1))));
+    }
+
+    /// Transform the direction `v`, i.e., `(*this * (v, 0)).xyz`.
+    [[nodiscard]] constexpr auto transform_vector(Vector3 const &v) const
+        requires(Rows == 4 and Cols == 4)
+    {
+        return truncate(product(Row(v[0], v[1], v[2], Scalar(0))));
+    }
+
+public:
+#define KIRA_MATRIX_ROUTE(name, ...)                                                               \
+    if (std::is_constant_evaluated())                                                              \
+        return static_cast<ConstexprImpl const &>(*this).name(__VA_ARGS__);                        \
+    return Base::name(__VA_ARGS__)
+
+    template <std::size_t K>
+    [[nodiscard]] constexpr auto product(VecteurMatrix<Scalar, Cols, K> const &rhs) const {
+        KIRA_MATRIX_ROUTE(mul_, rhs);
+    }
+
+    [[nodiscard]] constexpr auto product(Row const &rhs) const { KIRA_MATRIX_ROUTE(mul_, rhs); }
+#undef KIRA_MATRIX_ROUTE
+
+    friend constexpr auto operator*(VecteurMatrix const &lhs, auto const &rhs)
+        requires(requires { lhs.product(rhs); })
+    {
+        return lhs.product(rhs);
+    }
+
+    friend constexpr auto operator*(VecteurMatrix const &lhs, Scalar const &rhs) {
+        return lhs.scale_(rhs);
+    }
+
+    friend constexpr auto operator*(Scalar const &lhs, VecteurMatrix const &rhs) {
+        return rhs.scale_(lhs);
+    }
+
+    friend constexpr auto operator/(VecteurMatrix const &lhs, Scalar const &rhs) {
+        return lhs.scale_(Scalar(1) / rhs);
+    }
+
+    friend constexpr auto operator+(VecteurMatrix const &lhs, VecteurMatrix const &rhs) {
+        return lhs.add_(rhs);
+    }
+
+    friend constexpr auto operator-(VecteurMatrix const &lhs, VecteurMatrix const &rhs) {
+        return lhs.sub_(rhs);
+    }
+
+    friend constexpr auto operator-(VecteurMatrix const &rhs) { return rhs.scale_(Scalar(-1)); }
+
+    friend constexpr bool operator==(VecteurMatrix const &lhs, VecteurMatrix const &rhs) {
+        return lhs.eq_(rhs);
+    }
+
+private:
+    static constexpr Vector3 truncate(Column const &v) { return Vector3(v[0], v[1], v[2]); }
+
+    /// The 2x2 minors of the upper (`s`) and the lower (`c`) two rows, shared by the determinant
+    /// and the inverse of 4x4.
+    [[nodiscard]] constexpr auto minors4() const {
+        auto const &m = *this;
+        struct {
+            Scalar s[6], c[6];
+        } r{};
+        r.s[0] = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+        r.s[1] = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+        r.s[2] = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+        r.s[3] = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+        r.s[4] = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+        r.s[5] = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+        r.c[0] = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+        r.c[1] = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+        r.c[2] = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+        r.c[3] = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+        r.c[4] = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+        r.c[5] = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+        return r;
+    }
+};
+
+/// The polar decomposition `a = rotation * stretch` of a 3x3 matrix.
+template <typename Scalar> struct VecteurPolar {
+    VecteurMatrix<Scalar, 3, 3> rotation; ///< Orthogonal, with the sign of `det(a)`.
+    VecteurMatrix<Scalar, 3, 3> stretch;  ///< Symmetric positive semi-definite.
+};
+
+/// Compute the polar decomposition of the non-singular `a` without an SVD, by the scaled Newton
+/// iteration `R = (g * R + (R^-T) / g) / 2` of Higham, which converges quadratically.
+///
+/// \param tolerance The relative change of `rotation` in Frobenius norm to stop at.
+template <typename Scalar>
+    requires(std::is_floating_point_v<Scalar>)
+[[nodiscard]] VecteurPolar<Scalar> polar_decomposition(
+    VecteurMatrix<Scalar, 3, 3> const &a,
+    Scalar tolerance = Scalar(16) * std::numeric_limits<Scalar>::epsilon(), int maxIterations = 32
+) {
+    auto rotation = a;
+    for (int k = 0; k < maxIterations; ++k) {
+        auto const inverseT = rotation.inverse().transpose();
+        auto const g = std::sqrt(std::sqrt(inverseT.norm2() / rotation.norm2()));
+        auto const next = (rotation * g + inverseT / g) * Scalar(0.5);
+        auto const change = (next - rotation).norm2();
+        rotation = next;
+        if (change <= tolerance * tolerance * rotation.norm2())
+            break;
+    }
+
+    auto const stretch = rotation.transpose() * a;
+    return {rotation, (stretch + stretch.transpose()) * Scalar(0.5)};
+}
+} // namespace kira::vecteur
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Base.h"
+#include "Lazy.h"
+#include "Storage.h"
+#include "Traits.h"
+#include "detail/Packet.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): Most of the per-vertex data (weights, normals, velocities for playback) does not
+//! need 32 bits, while the loops over them are bandwidth-bound. The lazy vecteurs of `float16` or
+//! `bfloat16` store the narrow scalars, but are `float` vecteurs in the expressions: the packets
+//! are widened after loading by `PromoteTo`, and rounded back by `DemoteTo` when an expression is
+//! assigned, s.t. the computation stays in `float`:
+//!
+//!     Vecteur<float16, std::dynamic_extent, VecteurBackend::Lazy> weights(size, 0.5F);
+//!     weights = weights * 2.0F + offsets;   // computed in `float`, stored in 16 bits
+//!     float const w = weights[3];            // widened
+//!
+//! `eval()` returns the widened `float` vecteur, while the copies stay narrow. The elements are
+//! only written through the assignment of an expression (or `set()`), since there is no `float`
+//! to refer to.
+
+using float16 = hwy::float16_t;
+using bfloat16 = hwy::bfloat16_t;
+
+namespace detail {
+/// Widen a narrow scalar to `float`, which is exact.
+inline float widen(float16 x) { return hwy::F32FromF16(x); }
+
+/// \copydoc widen(float16)
+inline float widen(bfloat16 x) { return hwy::F32FromBF16(x); }
+
+/// Round a `float` to the nearest narrow scalar.
+template <is_narrow_scalar Narrow> Narrow narrow(float x) {
+    if constexpr (std::is_same_v<Narrow, float16>)
+        return hwy::F16FromF32(x);
+    else
+        return hwy::BF16FromF32(x);
+}
+
+/// Evaluate the `float` expression into the narrow `out`, which holds `node.size()` elements.
+template <is_narrow_scalar Narrow, is_vecteur Node>
+void narrow_into(Node const &node, Narrow *out) {
+    static_assert(std::is_same_v<typename Node::Scalar, float>, "Only `float` is narrowed.");
+
+    std::size_t i = 0;
+    if constexpr (Node::packetable) {
+        auto const tag = PacketTag<float>();
+        auto const narrowTag = hn::Rebind<Narrow, decltype(tag)>();
+        auto const lanes = hn::Lanes(tag);
+        for (; i + lanes <= node.size(); i += lanes) {
+            auto const v = node.packet(tag, i, FullPacket{});
+            store_packet(hn::DemoteTo(narrowTag, v), narrowTag, out + i, FullPacket{});
+        }
+        if (auto const remaining = node.size() - i; remaining > 0) {
+            auto const v = node.packet(tag, i, remaining);
+            store_packet(hn::DemoteTo(narrowTag, v), narrowTag, out + i, remaining);
+        }
+        return;
+    }
+
+    for (; i < node.size(); ++i)
+        out[i] = narrow<Narrow>(static_cast<float>(node.entry(i)));
+}
+} // namespace detail
+
+#define KIRA_VECTEUR_LEAF_TYPE Vecteur<Narrow, Size, VecteurBackend::Lazy>
+template <is_narrow_scalar Narrow, std::size_t Size>
+struct VecteurImpl<Narrow, Size, VecteurBackend::Lazy, false, KIRA_VECTEUR_LEAF_TYPE>
+    : VecteurBase<float, Size, VecteurBackend::Lazy, KIRA_VECTEUR_LEAF_TYPE>,
+      VecteurLazyBase<KIRA_VECTEUR_LEAF_TYPE>,
+      VecteurStorage<Narrow, Size, alignof(Narrow)> {
+private:
+    using Base = VecteurBase<float, Size, VecteurBackend::Lazy, KIRA_VECTEUR_LEAF_TYPE>;
+    using Storage = VecteurStorage<Narrow, Size, alignof(Narrow)>;
+#undef KIRA_VECTEUR_LEAF_TYPE
+
+public:
+    using ConstexprImpl = VecteurImpl;
+    static constexpr int height = 1;
+    static constexpr bool packetable = true;
+
+    // The converting constructors of the storage are not inherited, since they would copy the
+    // narrow scalars without rounding.
+    VecteurImpl() = default;
+
+    /// Construct a vector of `size` elements, whose values are unspecified.
+    explicit VecteurImpl(std::size_t size)
+        requires(Base::is_dynamic())
+        : Storage(size) {}
+
+    /// Construct a vector of `size` elements set to `v`, which is rounded once.
+    explicit VecteurImpl(std::size_t size, float v)
+        requires(Base::is_dynamic())
+        : Storage(size, detail::narrow<Narrow>(v)) {}
+
+    [[nodiscard]] float entry(auto i) const {
+        KIRA_ASSERT(i < this->size(), "Index out of bounds: {} < {}", i, this->size());
+        return detail::widen(this->data()[i]);
+    }
+
+    /// Set the element `i` to `v`, which is rounded to the narrow scalar.
+    void set(std::size_t i, float v) {
+        KIRA_ASSERT(i < this->size(), "Index out of bounds: {} < {}", i, this->size());
+        this->data()[i] = detail::narrow<Narrow>(v);
+    }
+
+    [[nodiscard]] KIRA_FORCEINLINE auto packet(auto tag, auto i, auto lanes) const {
+        auto const narrowTag = detail::hn::Rebind<Narrow, decltype(tag)>();
+        return detail::hn::PromoteTo(tag, detail::load_packet(narrowTag, this->data() + i, lanes));
+    }
+
+public:
+    template <is_vecteur RHS>
+    VecteurImpl(RHS const &rhs)
+        requires(RHS::is_lazy() and std::is_same_v<typename RHS::Scalar, float>)
+    {
+        if constexpr (Base::is_dynamic())
+            this->realloc(rhs.size());
+        detail::narrow_into(rhs, this->data());
+    }
+
+    template <is_vecteur RHS>
+    decltype(auto) operator=(RHS const &rhs)
+        requires(RHS::is_lazy() and std::is_same_v<typename RHS::Scalar, float>)
+    {
+        // The packets of `rhs` may read `*this`, which is then overwritten a packet at a time after
+        // being read, as for the other lazy leaves.
+        if constexpr (Base::is_dynamic())
+            if (this->size() != rhs.size())
+                this->realloc(rhs.size());
+        detail::narrow_into(rhs, this->data());
+        return *this;
+    }
+};
+} // namespace kira::vecteur
+
+namespace kira {
+using vecteur::bfloat16;
+using vecteur::float16;
+} // namespace kira
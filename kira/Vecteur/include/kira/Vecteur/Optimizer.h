@@ -6,16 +6,56 @@
 #include "Traits.h"
 #include "detail/Lazy.h"
 
+#ifndef KIRA_VECTEUR_FAST_MATH
+/// Allow the `VecteurOptimizer` to apply the rewrites that change the rounding, i.e., the
+/// reassociation and the reciprocal, see `KRR_VECTEUR_FAST_MATH`.
+#define KIRA_VECTEUR_FAST_MATH 0
+#endif
+
+#ifndef KIRA_VECTEUR_FUSE_MUL_ADD
+/// Allow the `VecteurOptimizer` to fuse the multiply-add, which is implied by the fast-math, see
+/// `KRR_VECTEUR_FUSE_MUL_ADD`.
+#define KIRA_VECTEUR_FUSE_MUL_ADD KIRA_VECTEUR_FAST_MATH
+#endif
+
 namespace kira::vecteur {
 template <typename BinaryOp, typename LHS, typename RHS> struct CwiseBinaryOp;
 template <typename UnaryOp, typename T> struct CwiseUnaryOp0;
+template <typename TernaryOp, typename T0, typename T1, typename T2> struct CwiseTernaryOp;
 template <typename Derived> struct VecteurLazyBase;
 
 //! These transform the expression template into a more calculation-friendly form.
-//! This file serves as a PoC for the VecteurOptimizer, more optimizations will be added.
+//!
+//! The optimizer is applied once to every binary node at its creation, thus the rules only need to
+//! match the node and its direct operands, which are already optimized. The rules are:
+//! - `a * b + c`, `c + a * b` -> `fma(a, b, c)`, thus `a * b + c * d` -> `fma(a, b, c * d)` and
+//!   the longer chains are folded from the left [fma].
+//! - `a * b - c` -> `fms(a, b, c)` and `c - a * b` -> `fnma(a, b, c)` [fma].
+//! - `(x * s0) * s1`, `(s0 * x) * s1` -> `x * (s0 * s1)` for the scalars `s0`, `s1` [fast-math].
+//! - `x / s` -> `x * (1 / s)` for the floating-point scalar `s` [fast-math].
+//! - `hsum(a * b)`, `hsum(sqr(a))` -> `dot(a, b)`, `dot(a, a)` for the floating-point scalars,
+//!   see `VecteurReductionOptimizer` [fma].
+//!
+//! The [fast-math] and [fma] rules change the rounding of the results, thus are only applied when
+//! the policy allows. The [fma] rules are further limited to the products of the same scalar type
+//! as the sum, s.t. no operand is converted before the multiplication, e.g., `int * int + float`
+//! is left as it is.
+
+/// The optimizer policy with the fast-math and fma rules controlled by `KIRA_VECTEUR_FAST_MATH`
+/// and `KIRA_VECTEUR_FUSE_MUL_ADD`.
+struct VecteurOptimizerPolicy {
+    static constexpr bool fastMath = KIRA_VECTEUR_FAST_MATH;
+    static constexpr bool fuseMulAdd = KIRA_VECTEUR_FUSE_MUL_ADD;
+};
+
+/// The optimizer policy with the fast-math and fma rules enabled.
+struct VecteurFastMathPolicy {
+    static constexpr bool fastMath = true;
+    static constexpr bool fuseMulAdd = true;
+};
 
 /// T -> T
-template <typename T> struct VecteurOptimizer {
+template <typename T, typename Policy = VecteurOptimizerPolicy> struct VecteurOptimizer {
     static_assert(!is_leaf_vecteur<T>, "Should not optimize a leaf vecteur");
     using type = T;
 
@@ -26,54 +66,210 @@ public:
     constexpr auto operator()() const { return t; }
 };
 
-#if 1
-/// T0 * T1 + T2 -> FuseMultiplyAddOp
-/// - (T0 * T1) -> I0
-/// - (I0 + T2) -> FuseMultiplyAddOp
-template <typename T0, typename T1, typename T2>
-struct VecteurOptimizer<CwiseBinaryOp<
-    detail::BinaryOpAdd<float, float>,                        // op
-    CwiseBinaryOp<detail::BinaryOpMul<float, float>, T0, T1>, // (1)
-    T2                                                        // (2)
-    >> {
-private:
-    using I0 = CwiseBinaryOp<detail::BinaryOpMul<float, float>, T0, T1>;
-    using type = struct FuseMultiplyAddOp
-        : VecteurImpl<
-              float, PromotedType<I0, T2>::size, VecteurBackend::Lazy, false, FuseMultiplyAddOp>,
-          VecteurLazyBase<FuseMultiplyAddOp>, detail::no_assignment_operator {
-        typename VecteurLazyOperandType<T0>::type t0;
-        typename VecteurLazyOperandType<T1>::type t1;
-        typename VecteurLazyOperandType<T2>::type t2;
-
-    public:
-        using ConstexprImpl = FuseMultiplyAddOp;
-        static constexpr int height = 1 + std::max(
-                                              {detail::height_or_1<T0>(), detail::height_or_1<T1>(),
-                                               detail::height_or_1<T2>()}
-                                          );
-        constexpr FuseMultiplyAddOp(T0 const &t0, T1 const &t1, T2 const &t2)
-            : t0(t0), t1(t1), t2(t2) {}
-
-        KIRA_FORCEINLINE constexpr auto entry(auto i) const {
-            return std::fmaf(
-                detail::entry_or_scalar(t0, i), detail::entry_or_scalar(t1, i),
-                detail::entry_or_scalar(t2, i)
-            );
-        }
-
-        KIRA_FORCEINLINE constexpr auto size() const {
-            return std::max<size_t>(
-                {detail::size_or_1(t0), detail::size_or_1(t1), detail::size_or_1(t2)}
-            );
-        }
-    };
+namespace detail {
+/// The common part of the rewrite rules, which replace the expression by a `Result` node.
+template <typename Result> struct VecteurRewrite {
+    using type = Result;
 
 public:
     type const t;
-    explicit VecteurOptimizer(is_vecteur auto const &t)
-        : t(t.lhs_op().lhs_op(), t.lhs_op().rhs_op(), t.rhs_op()) {}
+
+    constexpr explicit VecteurRewrite(auto const &...operands) : t(operands...) {}
     constexpr auto operator()() const { return t; }
 };
-#endif
+
+template <typename LHSScalar, typename RHSScalar>
+using promoted_t = typename PromotedType<LHSScalar, RHSScalar>::type;
+
+/// Whether the product of `MulScalar`s can be fused into the sum of `SumScalar`s, i.e., the policy
+/// allows and the product is already of the type of the sum.
+template <typename Policy, typename MulScalar, typename SumScalar>
+concept fusable_mul_add = Policy::fuseMulAdd and std::is_same_v<MulScalar, SumScalar>;
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------
+/// \name Fused multiply-add
+// ---------------------------------------------------------------------------------------------------------------------
+/// \{
+
+/// a * b + c -> fma(a, b, c)
+template <typename S0, typename S1, typename S2, typename S3, typename T0, typename T1,
+          typename T2, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpAdd<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>, T2>,
+    Policy>
+    : detail::VecteurRewrite<
+          CwiseTernaryOp<detail::TernaryOpMulAdd<detail::promoted_t<S2, S3>>, T0, T1, T2>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().lhs_op(), t.lhs_op().rhs_op(), t.rhs_op()) {
+    }
+};
+
+/// c + a * b -> fma(a, b, c)
+template <typename S0, typename S1, typename S2, typename S3, typename T0, typename T1,
+          typename T2, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpAdd<S0, S1>, T2, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>>,
+    Policy>
+    : detail::VecteurRewrite<
+          CwiseTernaryOp<detail::TernaryOpMulAdd<detail::promoted_t<S2, S3>>, T0, T1, T2>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.rhs_op().lhs_op(), t.rhs_op().rhs_op(), t.lhs_op()) {
+    }
+};
+
+/// a * b + c * d -> fma(a, b, c * d)
+template <typename S0, typename S1, typename S2, typename S3, typename S4, typename S5,
+          typename T0, typename T1, typename T2, typename T3, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpAdd<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>,
+        CwiseBinaryOp<detail::BinaryOpMul<S4, S5>, T2, T3>>,
+    Policy>
+    : detail::VecteurRewrite<CwiseTernaryOp<
+          detail::TernaryOpMulAdd<detail::promoted_t<S2, S3>>, T0, T1,
+          CwiseBinaryOp<detail::BinaryOpMul<S4, S5>, T2, T3>>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().lhs_op(), t.lhs_op().rhs_op(), t.rhs_op()) {
+    }
+};
+
+/// a * b - c -> fms(a, b, c)
+template <typename S0, typename S1, typename S2, typename S3, typename T0, typename T1,
+          typename T2, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpSub<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>, T2>,
+    Policy>
+    : detail::VecteurRewrite<
+          CwiseTernaryOp<detail::TernaryOpMulSub<detail::promoted_t<S2, S3>>, T0, T1, T2>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().lhs_op(), t.lhs_op().rhs_op(), t.rhs_op()) {
+    }
+};
+
+/// c - a * b -> fnma(a, b, c)
+template <typename S0, typename S1, typename S2, typename S3, typename T0, typename T1,
+          typename T2, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpSub<S0, S1>, T2, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>>,
+    Policy>
+    : detail::VecteurRewrite<
+          CwiseTernaryOp<detail::TernaryOpNegMulAdd<detail::promoted_t<S2, S3>>, T0, T1, T2>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.rhs_op().lhs_op(), t.rhs_op().rhs_op(), t.lhs_op()) {
+    }
+};
+
+/// a * b - c * d -> fms(a, b, c * d)
+template <typename S0, typename S1, typename S2, typename S3, typename S4, typename S5,
+          typename T0, typename T1, typename T2, typename T3, typename Policy>
+    requires(
+        detail::fusable_mul_add<Policy, detail::promoted_t<S2, S3>, detail::promoted_t<S0, S1>>
+    )
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpSub<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T0, T1>,
+        CwiseBinaryOp<detail::BinaryOpMul<S4, S5>, T2, T3>>,
+    Policy>
+    : detail::VecteurRewrite<CwiseTernaryOp<
+          detail::TernaryOpMulSub<detail::promoted_t<S2, S3>>, T0, T1,
+          CwiseBinaryOp<detail::BinaryOpMul<S4, S5>, T2, T3>>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().lhs_op(), t.lhs_op().rhs_op(), t.rhs_op()) {
+    }
+};
+
+/// \}
+// ---------------------------------------------------------------------------------------------------------------------
+/// \name Fast-math
+// ---------------------------------------------------------------------------------------------------------------------
+/// \{
+
+/// (x * s0) * s1 -> x * (s0 * s1)
+template <typename S0, typename S1, typename S2, typename S3, typename T, typename Policy>
+    requires(Policy::fastMath and std::is_arithmetic_v<S1> and std::is_arithmetic_v<S3>)
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpMul<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, T, S3>, S1>,
+    Policy>
+    : detail::VecteurRewrite<CwiseBinaryOp<
+          detail::BinaryOpMul<S2, detail::promoted_t<S3, S1>>, T, detail::promoted_t<S3, S1>>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().lhs_op(), t.lhs_op().rhs_op() * t.rhs_op()) {
+    }
+};
+
+/// (s0 * x) * s1 -> x * (s0 * s1)
+template <typename S0, typename S1, typename S2, typename S3, typename T, typename Policy>
+    requires(Policy::fastMath and std::is_arithmetic_v<S1> and std::is_arithmetic_v<S2>)
+struct VecteurOptimizer<
+    CwiseBinaryOp<
+        detail::BinaryOpMul<S0, S1>, CwiseBinaryOp<detail::BinaryOpMul<S2, S3>, S2, T>, S1>,
+    Policy>
+    : detail::VecteurRewrite<CwiseBinaryOp<
+          detail::BinaryOpMul<S3, detail::promoted_t<S2, S1>>, T, detail::promoted_t<S2, S1>>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op().rhs_op(), t.lhs_op().lhs_op() * t.rhs_op()) {
+    }
+};
+
+/// x / s -> x * (1 / s)
+template <typename S0, typename S1, typename T, typename Policy>
+    requires(Policy::fastMath and std::is_floating_point_v<S1>)
+struct VecteurOptimizer<CwiseBinaryOp<detail::BinaryOpDiv<S0, S1>, T, S1>, Policy>
+    : detail::VecteurRewrite<CwiseBinaryOp<detail::BinaryOpMul<S0, S1>, T, S1>> {
+    explicit VecteurOptimizer(is_vecteur auto const &t)
+        : VecteurOptimizer::VecteurRewrite(t.lhs_op(), S1(1) / t.rhs_op()) {}
+};
+
+/// \}
+// ---------------------------------------------------------------------------------------------------------------------
+/// \name Reductions
+// ---------------------------------------------------------------------------------------------------------------------
+/// \{
+
+/// hsum(T) -> hsum(T)
+template <typename T, typename Policy = VecteurOptimizerPolicy> struct VecteurReductionOptimizer {
+    static constexpr bool rewritten = false;
+};
+
+/// hsum(a * b) -> dot(a, b), where the dot product fuses the products into the sums
+template <typename S0, typename S1, is_vecteur T0, is_vecteur T1, typename Policy>
+    requires(Policy::fuseMulAdd and std::is_floating_point_v<detail::promoted_t<S0, S1>>)
+struct VecteurReductionOptimizer<CwiseBinaryOp<detail::BinaryOpMul<S0, S1>, T0, T1>, Policy> {
+    static constexpr bool rewritten = true;
+    static constexpr auto hsum(is_vecteur auto const &t) { return t.lhs_op().dot_(t.rhs_op()); }
+};
+
+/// hsum(sqr(a)) -> dot(a, a), as above
+template <typename S, is_vecteur T, typename Policy>
+    requires(Policy::fuseMulAdd and std::is_floating_point_v<S>)
+struct VecteurReductionOptimizer<CwiseUnaryOp0<detail::UnaryOp0Sqr<S>, T>, Policy> {
+    static constexpr bool rewritten = true;
+    static constexpr auto hsum(is_vecteur auto const &t) {
+        return t.operand_op().dot_(t.operand_op());
+    }
+};
+
+/// \}
+// ---------------------------------------------------------------------------------------------------------------------
 } // namespace kira::vecteur
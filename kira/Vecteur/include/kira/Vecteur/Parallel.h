@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace kira::vecteur {
+//! NOTE(krr): The large dynamic vecteurs are bandwidth-bound, thus a single core cannot saturate
+//! the memory channels. `ParallelPolicy` splits the elements into the blocks of a fixed size, which
+//! are evaluated by the threads of a pool shared by the whole process:
+//!
+//!     auto const c = (a * b + 1.0F).eval(par);   // parallel past `par.threshold` elements
+//!     auto const d = a.dot(b, par);              // parallel partial sums
+//!
+//! The blocks do not depend on the number of threads, and the partial sums of the reductions are
+//! combined pairwise in the order of the blocks, s.t. the result is the same for every run on every
+//! machine of the same target. It differs from the serial reduction in the last bits, though, since
+//! the summation order is different past the threshold.
+//!
+//! The blocks are run by the thread pool of kira Core (see `kira::ThreadPool`), the caller being
+//! one of its threads. A parallel evaluation started from a block, or from another thread while the
+//! pool is busy, shares the workers with the running ones.
+
+/// The policy of the parallel evaluation, see \c par.
+struct ParallelPolicy {
+    /// The vecteurs smaller than this are evaluated serially, as without the policy.
+    std::size_t threshold{std::size_t{1} << 17};
+};
+
+/// The default parallel policy, e.g., `expr.eval(par)`.
+inline constexpr ParallelPolicy par{};
+
+/// The number of the threads of the pool, including the caller, see \c kira::ThreadPool.
+[[nodiscard]] std::size_t ParallelConcurrency();
+
+namespace detail {
+/// Number of the elements of a block of the parallel evaluation, i.e., 64 KiB of `Scalar`, which
+/// stays in the L2 cache.
+template <typename Scalar> inline constexpr std::size_t ParallelBlock = 65536 / sizeof(Scalar);
+
+/// Run `task(context, i)` for `i` in `[0, count)` on the pool, see \c ParallelFor.
+void ParallelForImpl(
+    std::size_t count, void (*task)(void const *, std::size_t), void const *context
+);
+
+/// Run `task(i)` for `i` in `[0, count)` on the pool, and wait for all of them.
+///
+/// \note The tasks must not throw.
+template <typename Task> void ParallelFor(std::size_t count, Task const &task) {
+    ParallelForImpl(
+        count,
+        [](void const *context, std::size_t i) { (*static_cast<Task const *>(context))(i); },
+        &task
+    );
+}
+
+/// Run `task(begin, end)` for the blocks of `[0, size)` on the pool.
+template <typename Scalar, typename Task> void parallel_blocks(std::size_t size, Task const &task) {
+    constexpr auto block = ParallelBlock<Scalar>;
+    ParallelFor((size + block - 1) / block, [&](std::size_t b) {
+        task(b * block, std::min(size, (b + 1) * block));
+    });
+}
+
+/// Reduce `[0, size)` by `reduce(begin, end)` of the blocks on the pool, whose partial results are
+/// summed pairwise in the order of the blocks.
+template <typename Scalar, typename Reduce>
+Scalar parallel_reduce(std::size_t size, Reduce const &reduce) {
+    constexpr auto block = ParallelBlock<Scalar>;
+    auto const count = (size + block - 1) / block;
+    if (count == 0)
+        return Scalar(0);
+
+    std::vector<Scalar> partials(count);
+    ParallelFor(count, [&](std::size_t b) {
+        partials[b] = reduce(b * block, std::min(size, (b + 1) * block));
+    });
+    for (std::size_t stride = 1; stride < count; stride *= 2)
+        for (std::size_t b = 0; b + stride < count; b += 2 * stride)
+            partials[b] += partials[b + stride];
+    return partials[0];
+}
+} // namespace detail
+} // namespace kira::vecteur
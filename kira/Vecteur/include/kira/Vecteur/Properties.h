@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "kira/Properties.h"
+
+#include "Base.h"
+#include "Narrow.h"
+#include "Traits.h"
+
+namespace kira {
+//! NOTE(krr): The leaf vecteurs are serialized as arrays of numbers. The narrow scalars are widened
+//! to `double` when written (which is exact), and rounded when read, s.t. a scene file does not
+//! depend on the storage of the vecteurs it is loaded into.
+
+template <typename Scalar, std::size_t Size, vecteur::VecteurBackend backend>
+    requires(backend != vecteur::VecteurBackend::Trace)
+struct PropertyProcessor<vecteur::Vecteur<Scalar, Size, backend>> : std::true_type {
+    using Type = vecteur::Vecteur<Scalar, Size, backend>;
+    using Element = std::conditional_t<std::is_integral_v<Scalar>, int64_t, double>;
+
+    static constexpr std::string_view name = "kira::Vecteur";
+
+    static auto to_toml(Type const &vec) {
+        toml::array arr;
+        for (std::size_t i = 0; i < vec.size(); ++i)
+            arr.push_back(static_cast<Element>(vec[i]));
+        return arr;
+    }
+
+    static auto from_toml(toml::node &node, auto...) {
+        toml::array *arr = node.as_array();
+        if (!arr)
+            throw Anyhow("Expected an array, but got a(an) {}", magic_enum::enum_name(node.type()));
+
+        Type vec;
+        if constexpr (Type::is_dynamic())
+            vec = Type(arr->size());
+        else if (arr->size() != Size)
+            throw Anyhow("Expected {} element(s), but got {}", Size, arr->size());
+
+        for (std::size_t i = 0; i < arr->size(); ++i) {
+            auto const &value = arr->at(i).template value<Element>();
+            if (!value)
+                throw Anyhow(
+                    "Expected a number, but got a(an) {} at [{}]",
+                    magic_enum::enum_name(arr->at(i).type()), i
+                );
+            if constexpr (vecteur::is_narrow_scalar<Scalar>)
+                vec.set(i, static_cast<float>(value.value()));
+            else
+                vec[i] = static_cast<Scalar>(value.value());
+        }
+
+        return vec;
+    }
+};
+} // namespace kira
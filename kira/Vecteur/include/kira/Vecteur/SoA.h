@@ -0,0 +1,322 @@
+#pragma once
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "kira/Anyhow.h"
+
+#include "Generic.h"
+#include "Lazy.h"
+#include "Matrix.h"
+#include "Router.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): `VecteurSoA<Scalar, Dim>` holds N points of dimension `Dim` as `Dim` contiguous lanes
+//! of N elements, i.e., a lazy dynamic vecteur per coordinate, s.t. the packets process N points
+//! per instruction instead of padding a single point to the packet width.
+//!
+//! The operations are lazy, and are mapped to a lazy expression per lane:
+//!
+//!     VecteurSoA<float, 3> a(n), b(n);
+//!     VecteurSoA<float, 3> c = a.cross(b) * 2.0F;   // 3 fused packet loops, one per lane
+//!     VecteurSoA<float, 3>::Lane const d = a.dot(b); // a lazy vecteur over the points
+//!
+//! The operands are either another SoA of the same dimension, a scalar, or a lazy vecteur holding a
+//! value per point (e.g., a weight), which is broadcast to all the lanes. As for the lazy backend,
+//! the expressions reference the SoA leaves, thus must not outlive them.
+//!
+//! The assignment evaluates all the lanes into a temporary first, since the lanes of a non
+//! element-wise expression (e.g., `a = a.cross(b)`) read the other lanes of the destination. As for
+//! Eigen, `c.noalias() = a.cross(b)` evaluates in place when `c` is not an operand.
+
+template <typename Lane, std::size_t Dim> struct VecteurSoAExpr;
+template <typename Scalar, std::size_t Dim> struct VecteurSoA;
+
+template <typename T>
+concept is_vecteur_soa = requires { std::decay_t<T>::IsVecteurSoA; };
+
+namespace detail {
+/// Build an SoA expression whose lane `d` is `f(d)`.
+template <std::size_t Dim, typename F> constexpr auto make_soa(F const &f) {
+    return [&]<std::size_t... d>(std::index_sequence<d...>) {
+        using Lane = std::decay_t<decltype(f(std::size_t{0}))>;
+        return VecteurSoAExpr<Lane, Dim>{std::array<Lane, Dim>{f(d)...}};
+    }(std::make_index_sequence<Dim>{});
+}
+
+/// The lane `d` of an SoA operand, or the operand itself, which is broadcast to all the lanes.
+template <typename T> constexpr decltype(auto) lane_or_broadcast(T const &obj, std::size_t d) {
+    if constexpr (is_vecteur_soa<T>)
+        return obj.lane(d);
+    else
+        return (obj);
+}
+} // namespace detail
+
+/// The operations shared by the SoA leaves and expressions.
+template <typename Derived, std::size_t Dim_> struct VecteurSoABase {
+private:
+    constexpr auto const &derived_() const { return *static_cast<Derived const *>(this); }
+
+public:
+    static constexpr bool IsVecteurSoA = true;
+    static constexpr std::size_t Dim = Dim_;
+
+    /// The number of points.
+    [[nodiscard]] constexpr auto size() const { return derived_().lane(0).size(); }
+
+    /// Evaluate all the lanes into a \c VecteurSoA.
+    [[nodiscard]] auto eval() const {
+        using Scalar = typename std::decay_t<decltype(derived_().lane(0))>::Scalar;
+        return VecteurSoA<Scalar, Dim>(derived_());
+    }
+
+    /// Dot product per point, i.e., a lazy vecteur of `size()` elements.
+    template <is_vecteur_soa RHS> [[nodiscard]] constexpr auto dot(RHS const &rhs) const {
+        static_assert(RHS::Dim == Dim, "The dimensions of the operands must be the same.");
+        return [&]<std::size_t... d>(std::index_sequence<d...>) {
+            return ((derived_().lane(d) * rhs.lane(d)) + ...);
+        }(std::make_index_sequence<Dim>{});
+    }
+
+    /// Cross product per point.
+    template <is_vecteur_soa RHS>
+    [[nodiscard]] constexpr auto cross(RHS const &rhs) const
+        requires(Dim == 3)
+    {
+        static_assert(RHS::Dim == Dim, "The dimensions of the operands must be the same.");
+        return detail::make_soa<Dim>([&](std::size_t d) {
+            auto const d1 = (d + 1) % 3, d2 = (d + 2) % 3;
+            return derived_().lane(d1) * rhs.lane(d2) - derived_().lane(d2) * rhs.lane(d1);
+        });
+    }
+
+    /// Squared norm per point.
+    [[nodiscard]] constexpr auto norm2() const { return dot(derived_()); }
+    /// Norm per point.
+    [[nodiscard]] constexpr auto norm() const { return norm2().sqrt(); }
+
+    /// Normalize every point.
+    ///
+    /// \note The norm is recomputed by every lane instead of being stored, s.t. the result stays a
+    /// lazy expression without a temporary.
+    [[nodiscard]] constexpr auto normalize() const {
+        auto const norm = this->norm();
+        return detail::make_soa<Dim>([&](std::size_t d) { return derived_().lane(d) / norm; });
+    }
+
+#define KIRA_SOA_UNARY_OP(name)                                                                    \
+    [[nodiscard]] constexpr auto name() const {                                                    \
+        return detail::make_soa<Dim>([&](std::size_t d) { return derived_().lane(d).name(); });    \
+    }
+
+    KIRA_SOA_UNARY_OP(abs)
+    KIRA_SOA_UNARY_OP(ceil)
+    KIRA_SOA_UNARY_OP(floor)
+    KIRA_SOA_UNARY_OP(sqrt)
+    KIRA_SOA_UNARY_OP(sqr)
+    KIRA_SOA_UNARY_OP(neg)
+#undef KIRA_SOA_UNARY_OP
+
+    /// Element-wise maximum, where `rhs` is broadcast unless it is an SoA.
+    [[nodiscard]] constexpr auto max(auto const &rhs) const {
+        return detail::make_soa<Dim>([&](std::size_t d) {
+            return derived_().lane(d).max(detail::lane_or_broadcast(rhs, d));
+        });
+    }
+
+    /// Element-wise minimum, where `rhs` is broadcast unless it is an SoA.
+    [[nodiscard]] constexpr auto min(auto const &rhs) const {
+        return detail::make_soa<Dim>([&](std::size_t d) {
+            return derived_().lane(d).min(detail::lane_or_broadcast(rhs, d));
+        });
+    }
+};
+
+/// The lanes of a lazy SoA expression, which are all of the same expression type.
+template <typename Lane, std::size_t Dim>
+struct VecteurSoAExpr : VecteurSoABase<VecteurSoAExpr<Lane, Dim>, Dim> {
+    std::array<Lane, Dim> lanes;
+
+    explicit constexpr VecteurSoAExpr(std::array<Lane, Dim> lanes) : lanes(std::move(lanes)) {}
+
+    [[nodiscard]] constexpr auto const &lane(std::size_t d) const { return lanes[d]; }
+};
+
+/// N points of dimension `Dim`, stored as `Dim` contiguous lanes.
+template <typename Scalar_, std::size_t Dim>
+struct VecteurSoA : VecteurSoABase<VecteurSoA<Scalar_, Dim>, Dim> {
+    using Scalar = Scalar_;
+    using Lane = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+    using Point = Vecteur<Scalar, Dim, VecteurBackend::Generic>;
+
+private:
+    std::array<Lane, Dim> lanes;
+
+    struct NoAlias {
+        VecteurSoA &self;
+
+        template <is_vecteur_soa RHS> VecteurSoA &operator=(RHS const &rhs) {
+            static_assert(RHS::Dim == Dim, "The dimensions of the operands must be the same.");
+            for (std::size_t d = 0; d < Dim; ++d)
+                self.lanes[d] = rhs.lane(d);
+            return self;
+        }
+    };
+
+public:
+    VecteurSoA() = default;
+
+    /// Construct `size` points, whose values are unspecified.
+    explicit VecteurSoA(std::size_t size) { resize(size); }
+
+    /// Construct `size` points with all the coordinates set to `v`.
+    VecteurSoA(std::size_t size, Scalar const &v) {
+        for (auto &lane : lanes)
+            lane = Lane(size, v);
+    }
+
+    /// Evaluate an SoA expression.
+    template <is_vecteur_soa RHS>
+    VecteurSoA(RHS const &rhs)
+        requires(not std::is_same_v<RHS, VecteurSoA>)
+    {
+        static_assert(RHS::Dim == Dim, "The dimensions of the operands must be the same.");
+        for (std::size_t d = 0; d < Dim; ++d)
+            lanes[d] = rhs.lane(d);
+    }
+
+    /// Construct from the rows of an Eigen matrix, e.g., an `Eigen::MatrixX3f`.
+    ///
+    /// \note Both the column-major (SoA) and the row-major (AoS) matrices are accepted, where the
+    /// former is a plain copy per lane.
+    template <typename Matrix> explicit VecteurSoA(Eigen::MatrixBase<Matrix> const &matrix) {
+        if (matrix.cols() != static_cast<Eigen::Index>(Dim))
+            throw Anyhow("VecteurSoA: Expected {} columns, got {}", Dim, matrix.cols());
+
+        resize(static_cast<std::size_t>(matrix.rows()));
+        for (std::size_t d = 0; d < Dim; ++d)
+            lane_map(d) = matrix.col(static_cast<Eigen::Index>(d)).template cast<Scalar>();
+    }
+
+    template <is_vecteur_soa RHS>
+    VecteurSoA &operator=(RHS const &rhs)
+        requires(not std::is_same_v<RHS, VecteurSoA>)
+    {
+        // Evaluate into a temporary, since the lanes of `rhs` might read the other lanes of this.
+        return *this = VecteurSoA(rhs);
+    }
+
+    /// Assign without the temporary, i.e., `*this` must not be an operand of the expression.
+    [[nodiscard]] auto noalias() KIRA_LIFETIME_BOUND { return NoAlias{*this}; }
+
+public:
+    [[nodiscard]] constexpr Lane const &lane(std::size_t d) const { return lanes[d]; }
+    [[nodiscard]] constexpr Lane &lane(std::size_t d) { return lanes[d]; }
+
+    /// Resize to `size` points, whose values are unspecified afterwards.
+    void resize(std::size_t size) {
+        for (auto &lane : lanes)
+            lane.realloc(size);
+    }
+
+    /// Gather the point `i`.
+    [[nodiscard]] Point point(std::size_t i) const {
+        Point result;
+        for (std::size_t d = 0; d < Dim; ++d)
+            result[d] = lanes[d][i];
+        return result;
+    }
+
+    /// Scatter `p` to the point `i`.
+    void set_point(std::size_t i, Point const &p) {
+        for (std::size_t d = 0; d < Dim; ++d)
+            lanes[d][i] = p[d];
+    }
+
+    /// Convert to an Eigen matrix with a row per point, e.g., `Eigen::MatrixX3f` by default.
+    template <int Options = Eigen::ColMajor>
+    [[nodiscard]] auto to_eigen() const {
+        Eigen::Matrix<Scalar, Eigen::Dynamic, static_cast<int>(Dim), Options> result(
+            this->size(), static_cast<Eigen::Index>(Dim)
+        );
+        for (std::size_t d = 0; d < Dim; ++d)
+            result.col(static_cast<Eigen::Index>(d)) = lane_map(d);
+        return result;
+    }
+
+private:
+    [[nodiscard]] auto lane_map(std::size_t d) {
+        return Eigen::Map<Eigen::Vector<Scalar, Eigen::Dynamic>>(lanes[d].data(), this->size());
+    }
+
+    [[nodiscard]] auto lane_map(std::size_t d) const {
+        return Eigen::Map<Eigen::Vector<Scalar, Eigen::Dynamic> const>(
+            lanes[d].data(), this->size()
+        );
+    }
+};
+
+/// \name SoA router
+/// \{
+
+#define KIRA_ROUTE_SOA_BINARY(name)                                                                \
+    template <is_vecteur_soa LHS, typename RHS>                                                    \
+    constexpr auto name(LHS const &a1, RHS const &a2) {                                            \
+        if constexpr (is_vecteur_soa<RHS>)                                                         \
+            static_assert(LHS::Dim == RHS::Dim, "The dimensions must be the same.");               \
+        return detail::make_soa<LHS::Dim>([&](std::size_t d) {                                     \
+            return name(a1.lane(d), detail::lane_or_broadcast(a2, d));                             \
+        });                                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    template <typename LHS, is_vecteur_soa RHS>                                                    \
+        requires(not is_vecteur_soa<LHS>)                                                          \
+    constexpr auto name(LHS const &a1, RHS const &a2) {                                            \
+        return detail::make_soa<RHS::Dim>([&](std::size_t d) { return name(a1, a2.lane(d)); });    \
+    }
+
+KIRA_ROUTE_SOA_BINARY(operator+)
+KIRA_ROUTE_SOA_BINARY(operator-)
+KIRA_ROUTE_SOA_BINARY(operator*)
+KIRA_ROUTE_SOA_BINARY(operator/)
+#undef KIRA_ROUTE_SOA_BINARY
+
+constexpr auto operator-(is_vecteur_soa auto const &a) { return a.neg(); }
+/// \}
+
+/// \name Batched transforms
+/// \{
+
+/// Transform every point by the affine `m`, i.e., the lane `i` is `m(i, 0) * x + m(i, 1) * y +
+/// m(i, 2) * z + m(i, 3)`, which is rewritten into a chain of fused multiply-adds.
+template <typename Scalar, is_vecteur_soa RHS>
+    requires(RHS::Dim == 3)
+[[nodiscard]] constexpr auto transform_points(VecteurMatrix<Scalar, 4, 4> const &m, RHS const &p) {
+    return detail::make_soa<3>([&](std::size_t i) {
+        return p.lane(0) * m(i, 0) + p.lane(1) * m(i, 1) + p.lane(2) * m(i, 2) + m(i, 3);
+    });
+}
+
+/// Transform every vector by the linear part of `m`, i.e., without the translation.
+template <typename Scalar, is_vecteur_soa RHS>
+    requires(RHS::Dim == 3)
+[[nodiscard]] constexpr auto transform_vectors(VecteurMatrix<Scalar, 4, 4> const &m, RHS const &v) {
+    return detail::make_soa<3>([&](std::size_t i) {
+        return v.lane(0) * m(i, 0) + v.lane(1) * m(i, 1) + v.lane(2) * m(i, 2);
+    });
+}
+/// \}
+} // namespace kira::vecteur
+
+namespace kira {
+using vecteur::is_vecteur_soa;
+using vecteur::VecteurSoA;
+
+using Vec3fSoA = VecteurSoA<float, 3>;
+using Vec3dSoA = VecteurSoA<double, 3>;
+} // namespace kira
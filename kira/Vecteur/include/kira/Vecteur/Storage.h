@@ -1,14 +1,19 @@
 #pragma once
 
 #include <array>
-#include <cstdlib>
 #include <span>
 
 #include "kira/Anyhow.h"
 #include "kira/Compiler.h"
 
+#include "Allocator.h"
 #include "Traits.h"
 
+/// The number of elements a dynamic vecteur holds inline before spilling to the heap.
+#ifndef KIRA_VECTEUR_INLINE_CAPACITY
+#define KIRA_VECTEUR_INLINE_CAPACITY 16
+#endif
+
 namespace kira::vecteur {
 //! NOTE(krr): Copy assignment matrix:
 //! | this \ rhs | static | dynamic | rvalue dynamic |
@@ -26,8 +31,37 @@ namespace kira::vecteur {
 //!
 //! Storage implements all the constructors and assignment operators for the vector classes, s.t.
 //! code can be reused for different leaf node types.
+//!
+//! The dynamic storage holds up to `InlineCapacity` elements inline, in the spirit of
+//! `kira::SmallVector`, and only spills to the heap past that. "realloc" above thus only touches
+//! the heap if either the old or the new size exceeds the inline capacity, while (6) copies the
+//! elements instead of stealing the pointer if the rhs is inline. The heap storage is obtained
+//! from the `Allocator` policy (see Allocator.h), which might be a per-thread arena.
+
+namespace detail {
+/// The inline elements of the dynamic storage.
+template <typename Scalar, std::size_t Capacity, std::size_t alignment> struct InlineBuffer {
+    alignas(alignment) Scalar buffer[Capacity];
+
+    constexpr Scalar *data() { return buffer; }
+    constexpr Scalar const *data() const { return buffer; }
+};
 
-template <typename Scalar, std::size_t Size, std::size_t alignment> struct VecteurStorage {
+/// No inline elements, i.e., always allocate on the heap.
+template <typename Scalar, std::size_t alignment> struct InlineBuffer<Scalar, 0, alignment> {
+    constexpr Scalar *data() { return nullptr; }
+    constexpr Scalar const *data() const { return nullptr; }
+};
+} // namespace detail
+
+/// \tparam InlineCapacity The number of elements held without a heap allocation, only used by
+/// the dynamic storage.
+/// \tparam Allocator The allocator policy of the heap storage, only used by the dynamic storage.
+template <
+    typename Scalar, std::size_t Size, std::size_t alignment,
+    std::size_t InlineCapacity = (Size == std::dynamic_extent ? KIRA_VECTEUR_INLINE_CAPACITY : 0),
+    typename Allocator = VecteurDefaultAllocator>
+struct VecteurStorage {
     alignas(alignment) Scalar storage[Size];
 
 public:
@@ -149,14 +183,46 @@ public:
     }
 };
 
-template <typename Scalar, std::size_t alignment>
-struct VecteurStorage<Scalar, std::dynamic_extent, alignment> {
+template <typename Scalar, std::size_t alignment, std::size_t InlineCapacity, typename Allocator>
+struct VecteurStorage<Scalar, std::dynamic_extent, alignment, InlineCapacity, Allocator> {
 private:
-    Scalar *storage{nullptr};
+    Scalar *storage{inlined.data()};
     std::size_t asize{0};
+    KIRA_NO_UNIQUE_ADDRESS detail::InlineBuffer<Scalar, InlineCapacity, alignment> inlined;
+
+    static Scalar *allocate(std::size_t size) {
+        auto *ptr = static_cast<Scalar *>(Allocator::allocate(sizeof(Scalar) * size, alignment));
+        if (!ptr)
+            throw Anyhow("VecteurStorage: Failed to allocate {} bytes", sizeof(Scalar) * size);
+        return ptr;
+    }
+
+    static void deallocate(Scalar *ptr) { Allocator::deallocate(ptr); }
+
+    /// Free the heap storage if any, and fall back to the inline one.
+    constexpr void release() {
+        if (not is_inline())
+            deallocate(storage);
+        storage = inlined.data();
+        asize = 0;
+    }
+
+    /// Take over the elements of `rhs`, which is left empty. `*this` must be empty.
+    constexpr void take(VecteurStorage &rhs) noexcept {
+        if (rhs.is_inline()) {
+            std::copy_n(rhs.storage, rhs.asize, storage);
+        } else {
+            storage = rhs.storage;
+            rhs.storage = rhs.inlined.data();
+        }
+
+        asize = rhs.asize;
+        rhs.asize = 0;
+    }
 
 public:
-    VecteurStorage() = default;
+    // Not defaulted, s.t. the value-initialized temporaries do not zero the inline elements.
+    constexpr VecteurStorage() noexcept {}
 
 #if 0
     constexpr VecteurStorage(Scalar *storage, std::size_t size) : storage{storage}, asize{size} {
@@ -165,49 +231,26 @@ public:
     }
 #endif
 
-    //! NOTE(krr): we do not use the aligned new/delete here because of
-    //! 1. A MSVC compiler issue.
-    //! 2. A valgrind error reported if we use the aligned new/delete.
-
     constexpr ~VecteurStorage() {
-#ifdef _WIN32
-        _aligned_free(storage);
-#else
-        std::free(storage);
-#endif
+        if (not is_inline())
+            deallocate(storage);
     }
 
     constexpr explicit VecteurStorage(std::size_t size) : asize{size} {
-#ifdef _WIN32
-        storage = static_cast<Scalar *>(_aligned_malloc(sizeof(Scalar) * size, alignment));
-#else
-        storage = static_cast<Scalar *>(std::aligned_alloc(alignment, sizeof(Scalar) * size));
-#endif
-        if (!storage)
-            throw Anyhow("VecteurStorage: Failed to allocate {} bytes", sizeof(Scalar) * size);
+        if (size > InlineCapacity)
+            storage = allocate(size);
     }
 
-    constexpr VecteurStorage(VecteurStorage const &rhs) : asize{rhs.asize} {
-#ifdef _WIN32
-        storage = static_cast<Scalar *>(_aligned_malloc(sizeof(Scalar) * rhs.asize, alignment));
-#else
-        storage = static_cast<Scalar *>(std::aligned_alloc(alignment, sizeof(Scalar) * rhs.asize));
-#endif
-        if (!storage)
-            throw Anyhow("VecteurStorage: Failed to allocate {} bytes", sizeof(Scalar) * rhs.asize);
+    constexpr VecteurStorage(VecteurStorage const &rhs) : VecteurStorage(rhs.asize) {
         std::copy_n(rhs.storage, asize, storage);
     }
 
-    constexpr VecteurStorage(VecteurStorage &&rhs) noexcept
-        : storage{rhs.storage}, asize{rhs.asize} {
-        rhs.storage = nullptr;
-        rhs.asize = 0;
-    }
+    constexpr VecteurStorage(VecteurStorage &&rhs) noexcept { take(rhs); }
 
-    friend void swap(VecteurStorage &lhs, VecteurStorage &rhs) {
-        using std::swap;
-        swap(lhs.storage, rhs.storage);
-        swap(lhs.asize, rhs.asize);
+    friend void swap(VecteurStorage &lhs, VecteurStorage &rhs) noexcept {
+        VecteurStorage tmp{std::move(lhs)};
+        lhs = std::move(rhs);
+        rhs = std::move(tmp);
     }
 
 public:
@@ -262,9 +305,10 @@ public:
 
     // (6) dynamic from rvalue dynamic
     constexpr decltype(auto) operator=(VecteurStorage &&rhs) noexcept {
-        VecteurStorage tmp{std::move(rhs)};
-        using std::swap;
-        swap(*this, tmp);
+        if (this == &rhs)
+            return *this;
+        release();
+        take(rhs);
         return *this;
     }
 
@@ -322,10 +366,22 @@ public:
 
     [[nodiscard]] constexpr auto to_array() = delete;
 
+    /// Whether the elements are held inline, i.e., without a heap allocation.
+    [[nodiscard]] constexpr bool is_inline() const {
+        return storage == inlined.data();
+    }
+
+    /// Resize the storage to `size` elements, whose values are unspecified afterwards.
     constexpr auto realloc(std::size_t size) {
-        auto newStorage = VecteurStorage(size);
-        using std::swap;
-        swap(*this, newStorage);
+        if (size <= InlineCapacity) {
+            release();
+        } else {
+            auto *newStorage = allocate(size);
+            release();
+            storage = newStorage;
+        }
+
+        asize = size;
     }
 };
 } // namespace kira::vecteur
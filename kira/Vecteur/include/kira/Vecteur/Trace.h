@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kira/Assertions.h"
+
+#include "Base.h"
+#include "Generic.h"
+#include "Lazy.h"
+#include "Traits.h"
+#include "detail/Kernels.h"
+
+namespace kira::vecteur {
+//! NOTE(krr): The trace backend is the first step towards a drjit-like JIT. The operations on a
+//! `Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Trace>` do not compute anything, but
+//! record a node into a graph, which is only executed at `eval()` (or when an element is read):
+//!
+//!     TraceXf const a(positions), b(weights);
+//!     TraceXf const c = a * b + 1.0F;       // recorded
+//!     TraceXf const d = (c * c).sqrt() - c; // recorded, shares `c`
+//!     d.eval();                             // a single fused loop
+//!
+//! At evaluation, the graph reachable from the evaluated variables is compiled into a program with
+//! the common subexpressions merged (e.g., `a * b` recorded twice is computed once), while the
+//! nodes that are not reachable are never executed (dead-code elimination comes for free, since an
+//! unused variable simply drops its nodes). The program is then interpreted a chunk of a few KiB at
+//! a time, where every instruction is a dispatched SIMD kernel of `detail/Kernels.h` over the
+//! chunk, s.t. the intermediate values live in the L1-resident registers instead of the temporary
+//! arrays of the size of the vecteur. Large vecteurs run the chunks on the pool, see \c par.
+//!
+//! `schedule()` defers the evaluation of a variable to the next `eval()` (of any variable of the
+//! same scalar type) or `TraceEvalScheduled()`, s.t. several outputs sharing subexpressions are
+//! fused into the same loop. Once evaluated, a variable becomes an input and releases its graph.
+//!
+//! The trace is per thread: the unevaluated variables must not be shared between the threads. Only
+//! the scalar types of the kernels are supported, and the operands of an operation must be of the
+//! same scalar type and size (a scalar is broadcast). The operations on the scalars alone are
+//! folded at record time.
+
+template <typename Scalar, std::size_t Size, typename Derived>
+struct VecteurImpl<Scalar, Size, VecteurBackend::Trace, false, Derived> {
+    static_assert(Size == std::dynamic_extent, "The trace backend only supports dynamic vecteurs.");
+};
+
+namespace detail {
+/// The kind of a recorded node.
+enum class TraceOp : uint8_t {
+    Input,   //< An evaluated buffer.
+    Literal, //< A scalar broadcast to all the elements.
+    Unary,   //< `UnaryKernelOp(lhs)`.
+    Binary,  //< `BinaryKernelOp(lhs, rhs)`.
+};
+
+/// A node of the trace, which is shared by the variables and the nodes referencing it.
+template <typename Scalar> struct TraceNode {
+    using Leaf = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+    TraceOp op{TraceOp::Literal};
+    uint8_t kernel{}; //< The `UnaryKernelOp` or `BinaryKernelOp`.
+    std::size_t size{};
+    Scalar literal{};
+    std::shared_ptr<TraceNode> lhs, rhs;
+    Leaf buffer; //< The elements of an `Input`.
+
+    /// Release the operands without recursion, as the chains recorded by the loops may be deeper
+    /// than the stack allows: the operands owned only here are taken over and emptied one by one.
+    ~TraceNode() {
+        std::vector<std::shared_ptr<TraceNode>> released;
+        auto const release = [&](std::shared_ptr<TraceNode> &operand) {
+            if (operand and operand.use_count() == 1)
+                released.push_back(std::move(operand));
+        };
+        release(lhs);
+        release(rhs);
+        while (not released.empty()) {
+            auto node = std::move(released.back());
+            released.pop_back();
+            release(node->lhs);
+            release(node->rhs);
+        }
+    }
+};
+
+template <typename Scalar> using TraceNodePtr = std::shared_ptr<TraceNode<Scalar>>;
+
+/// Evaluate `nodes` along with the scheduled nodes of `Scalar`, after which all of them are inputs.
+template <typename Scalar> void TraceEval(std::span<TraceNodePtr<Scalar> const> nodes);
+
+/// Defer the evaluation of `node` to the next \c TraceEval of `Scalar`.
+template <typename Scalar> void TraceSchedule(TraceNodePtr<Scalar> node);
+
+#define KIRA_TRACE_DECLARE(Scalar)                                                                 \
+    extern template void TraceEval<Scalar>(std::span<TraceNodePtr<Scalar> const> nodes);           \
+    extern template void TraceSchedule<Scalar>(TraceNodePtr<Scalar> node);
+
+KIRA_TRACE_DECLARE(float)
+KIRA_TRACE_DECLARE(double)
+KIRA_TRACE_DECLARE(int32_t)
+KIRA_TRACE_DECLARE(int64_t)
+#undef KIRA_TRACE_DECLARE
+} // namespace detail
+
+/// Evaluate all the scheduled variables of all the scalar types.
+void TraceEvalScheduled();
+
+/// The statistics of the last evaluation of the current thread, mostly for the tests.
+struct TraceStats {
+    std::size_t nodes{};        //< The unevaluated nodes reachable from the outputs.
+    std::size_t instructions{}; //< The instructions after the common subexpressions are merged.
+    std::size_t registers{};    //< The chunk-sized scratch registers.
+    std::size_t threads{};      //< The threads the chunks are split across.
+};
+
+/// \copydoc TraceStats
+[[nodiscard]] TraceStats LastTraceStats();
+
+#define KIRA_VECTEUR_TRACE_TYPE Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Trace>
+template <typename Scalar>
+struct VecteurImpl<
+    Scalar, std::dynamic_extent, VecteurBackend::Trace, false, KIRA_VECTEUR_TRACE_TYPE>
+    : VecteurBase<Scalar, std::dynamic_extent, VecteurBackend::Trace, KIRA_VECTEUR_TRACE_TYPE> {
+private:
+    using Self = KIRA_VECTEUR_TRACE_TYPE;
+#undef KIRA_VECTEUR_TRACE_TYPE
+    using Node = detail::TraceNode<Scalar>;
+    using NodePtr = detail::TraceNodePtr<Scalar>;
+
+    static_assert(detail::is_kernel_scalar<Scalar>, "The scalar type is not supported by kernels.");
+
+    NodePtr node;
+
+public:
+    using Leaf = typename Node::Leaf;
+
+    VecteurImpl() = default;
+
+    /// `size` elements of `v`, which is folded into the operations instead of being stored.
+    VecteurImpl(std::size_t size, Scalar const &v) : node(literal(size, v)) {}
+
+    /// Take the elements of a lazy leaf or expression, which is evaluated.
+    template <is_vecteur RHS>
+    explicit VecteurImpl(RHS const &rhs)
+        requires(RHS::is_lazy())
+        : node(std::make_shared<Node>()) {
+        node->op = detail::TraceOp::Input;
+        node->size = rhs.size();
+        node->buffer = Leaf(rhs);
+    }
+
+    /// \copydoc VecteurImpl(RHS const &)
+    explicit VecteurImpl(Leaf &&leaf) : node(std::make_shared<Node>()) {
+        node->op = detail::TraceOp::Input;
+        node->size = leaf.size();
+        node->buffer = std::move(leaf);
+    }
+
+public:
+    [[nodiscard]] std::size_t size() const { return node ? node->size : 0; }
+
+    /// Whether this has recorded operations to evaluate.
+    [[nodiscard]] bool is_recorded() const {
+        return node and (node->op == detail::TraceOp::Unary or node->op == detail::TraceOp::Binary);
+    }
+
+    /// Read the element `i`, which evaluates this first.
+    [[nodiscard]] Scalar entry(auto i) const { return buffer()[i]; }
+
+    /// The elements, which evaluates this first.
+    [[nodiscard]] Leaf const &buffer() const KIRA_LIFETIME_BOUND {
+        KIRA_ASSERT(node, "Reading an empty trace vecteur.");
+        if (node->op != detail::TraceOp::Input)
+            detail::TraceEval<Scalar>(std::span(&node, 1));
+        return node->buffer;
+    }
+
+    /// \copydoc buffer
+    [[nodiscard]] Scalar const *data() const { return buffer().data(); }
+
+    /// Evaluate this along with the scheduled variables in a single fused loop.
+    Self eval_() const {
+        (void)buffer();
+        return derived_();
+    }
+
+    /// Evaluate this at the next `eval()` instead, see \c TraceEvalScheduled.
+    void schedule() const {
+        if (node and node->op != detail::TraceOp::Input)
+            detail::TraceSchedule<Scalar>(node);
+    }
+
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Recorded arithmetic interface
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+#define KIRA_TRACE_BINARY_OP(name, op)                                                             \
+    [[nodiscard]] Self name(Self const &rhs) const {                                               \
+        return binary(detail::BinaryKernelOp::op, node, rhs.node);                                 \
+    }                                                                                              \
+                                                                                                   \
+    template <typename RHS>                                                                        \
+        requires(std::is_arithmetic_v<RHS>)                                                        \
+    [[nodiscard]] Self name(RHS const &rhs) const {                                                \
+        return binary(detail::BinaryKernelOp::op, node, literal(size(), Scalar(rhs)));             \
+    }                                                                                              \
+                                                                                                   \
+    template <typename LHS>                                                                        \
+        requires(std::is_arithmetic_v<LHS>)                                                        \
+    [[nodiscard]] Self r##name(LHS const &lhs) const {                                             \
+        return binary(detail::BinaryKernelOp::op, literal(size(), Scalar(lhs)), node);             \
+    }
+
+    KIRA_TRACE_BINARY_OP(add_, Add)
+    KIRA_TRACE_BINARY_OP(sub_, Sub)
+    KIRA_TRACE_BINARY_OP(mul_, Mul)
+    KIRA_TRACE_BINARY_OP(div_, Div)
+    KIRA_TRACE_BINARY_OP(max_, Max)
+    KIRA_TRACE_BINARY_OP(min_, Min)
+    KIRA_TRACE_BINARY_OP(atan2_, Atan2)
+    KIRA_TRACE_BINARY_OP(pow_, Pow)
+#undef KIRA_TRACE_BINARY_OP
+
+#define KIRA_TRACE_UNARY_OP(name, op)                                                              \
+    [[nodiscard]] Self name() const { return unary(detail::UnaryKernelOp::op, node); }
+
+    KIRA_TRACE_UNARY_OP(neg_, Neg)
+    KIRA_TRACE_UNARY_OP(sqr_, Sqr)
+    KIRA_TRACE_UNARY_OP(abs_, Abs)
+    KIRA_TRACE_UNARY_OP(sqrt_, Sqrt)
+    KIRA_TRACE_UNARY_OP(rsqrt_, RSqrt)
+    KIRA_TRACE_UNARY_OP(floor_, Floor)
+    KIRA_TRACE_UNARY_OP(ceil_, Ceil)
+    KIRA_TRACE_UNARY_OP(exp_, Exp)
+    KIRA_TRACE_UNARY_OP(log_, Log)
+    KIRA_TRACE_UNARY_OP(sin_, Sin)
+    KIRA_TRACE_UNARY_OP(cos_, Cos)
+    KIRA_TRACE_UNARY_OP(asin_, Asin)
+    KIRA_TRACE_UNARY_OP(acos_, Acos)
+    KIRA_TRACE_UNARY_OP(atan_, Atan)
+#undef KIRA_TRACE_UNARY_OP
+
+    [[nodiscard]] Self normalize_() const { return div_(norm_()); }
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+public:
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \name Reduction interface
+    // -----------------------------------------------------------------------------------------------------------------
+    /// \{
+
+    //! NOTE(krr): The reductions are scheduling points, i.e., the operands are evaluated first and
+    //! reduced by the lazy backend.
+
+#define KIRA_TRACE_REDUCTION0(name)                                                                \
+    [[nodiscard]] auto name##_() const { return buffer().name(); }
+#define KIRA_TRACE_REDUCTION1(name)                                                                \
+    [[nodiscard]] auto name##_(Self const &rhs) const {                                            \
+        rhs.schedule();                                                                            \
+        return buffer().name(rhs.buffer());                                                        \
+    }
+
+    KIRA_TRACE_REDUCTION0(hsum)
+    KIRA_TRACE_REDUCTION0(hsum_compensated)
+    KIRA_TRACE_REDUCTION0(hprod)
+    KIRA_TRACE_REDUCTION0(hmax)
+    KIRA_TRACE_REDUCTION0(hmin)
+    KIRA_TRACE_REDUCTION0(norm2)
+    KIRA_TRACE_REDUCTION0(norm)
+    KIRA_TRACE_REDUCTION1(dot)
+    KIRA_TRACE_REDUCTION1(dot_compensated)
+    KIRA_TRACE_REDUCTION1(eq)
+#undef KIRA_TRACE_REDUCTION0
+#undef KIRA_TRACE_REDUCTION1
+
+    [[nodiscard]] auto near_(Self const &rhs, auto const &epsilon) const {
+        rhs.schedule();
+        return buffer().near(rhs.buffer(), epsilon);
+    }
+
+    /// \}
+    // -----------------------------------------------------------------------------------------------------------------
+
+private:
+    explicit VecteurImpl(NodePtr node) : node(std::move(node)) {}
+
+    Self const &derived_() const { return *static_cast<Self const *>(this); }
+
+    static NodePtr literal(std::size_t size, Scalar v) {
+        auto result = std::make_shared<Node>();
+        result->op = detail::TraceOp::Literal;
+        result->size = size;
+        result->literal = v;
+        return result;
+    }
+
+    static Self binary(detail::BinaryKernelOp op, NodePtr const &lhs, NodePtr const &rhs) {
+        KIRA_ASSERT(lhs and rhs, "Recording an operation on an empty trace vecteur.");
+        KIRA_ASSERT(
+            lhs->size == rhs->size, "The size of the operands must be the same: {} != {}",
+            lhs->size, rhs->size
+        );
+        if (lhs->op == detail::TraceOp::Literal and rhs->op == detail::TraceOp::Literal) {
+            Scalar result{};
+            detail::BinaryKernel(op, &lhs->literal, rhs->literal, &result, 1);
+            return Self(literal(lhs->size, result));
+        }
+
+        auto result = std::make_shared<Node>();
+        result->op = detail::TraceOp::Binary;
+        result->kernel = static_cast<uint8_t>(op);
+        result->size = lhs->size;
+        result->lhs = lhs;
+        result->rhs = rhs;
+        return Self(std::move(result));
+    }
+
+    static Self unary(detail::UnaryKernelOp op, NodePtr const &operand) {
+        KIRA_ASSERT(operand, "Recording an operation on an empty trace vecteur.");
+        if (operand->op == detail::TraceOp::Literal) {
+            Scalar result{};
+            detail::UnaryKernel(op, &operand->literal, &result, 1);
+            return Self(literal(operand->size, result));
+        }
+
+        auto result = std::make_shared<Node>();
+        result->op = detail::TraceOp::Unary;
+        result->kernel = static_cast<uint8_t>(op);
+        result->size = operand->size;
+        result->lhs = operand;
+        return Self(std::move(result));
+    }
+};
+} // namespace kira::vecteur
+
+namespace kira {
+using vecteur::LastTraceStats;
+using vecteur::TraceEvalScheduled;
+using vecteur::TraceStats;
+
+using TraceXi = vecteur::Vecteur<int32_t, std::dynamic_extent, vecteur::VecteurBackend::Trace>;
+using TraceXf = vecteur::Vecteur<float, std::dynamic_extent, vecteur::VecteurBackend::Trace>;
+using TraceXd = vecteur::Vecteur<double, std::dynamic_extent, vecteur::VecteurBackend::Trace>;
+} // namespace kira
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <cmath>
 #include <span>
 #include <type_traits>
 
+#include <hwy/base.h>
+
 #include "Base.h"
 
 namespace kira::vecteur {
+/// The narrow floating-point scalars, which are only stored as is, but computed in `float`.
+///
+/// \see Narrow.h
+template <typename T>
+concept is_narrow_scalar =
+    std::is_same_v<T, hwy::float16_t> or std::is_same_v<T, hwy::bfloat16_t>;
+
 // Any vecteur leaf that inherits from VectuerBase must be a vecteur.
 template <typename T, typename D = std::decay_t<T>>
 concept is_vecteur =
@@ -30,6 +40,47 @@ template <typename T> constexpr auto size_or_1(T const &obj) {
         return 1UL;
 }
 
+/// Evaluate `a * b + c`, which is fused into a single rounding if the target has the FMA
+/// instructions. Otherwise, `std::fma` is emulated by the libm and is much slower than the separate
+/// multiply and add.
+template <typename Scalar> constexpr Scalar mul_add(Scalar a, Scalar b, Scalar c) {
+#if defined(FP_FAST_FMAF)
+    if constexpr (std::is_same_v<Scalar, float>)
+        if (not std::is_constant_evaluated())
+            return std::fma(a, b, c);
+#endif
+#if defined(FP_FAST_FMA)
+    if constexpr (std::is_same_v<Scalar, double>)
+        if (not std::is_constant_evaluated())
+            return std::fma(a, b, c);
+#endif
+    return a * b + c;
+}
+
+/// Evaluate `a * b + c` with a single rounding for the floating-point scalars regardless of the
+/// target, i.e., `std::fma` is emulated by the libm without the FMA instructions. This is only
+/// used where the fusion is asked for, see `VecteurOptimizerPolicy::fuseMulAdd`.
+///
+/// \note The constant evaluation is not fused, since `std::fma` is not `constexpr` until C++23.
+template <typename Scalar> constexpr Scalar fused_mul_add(Scalar a, Scalar b, Scalar c) {
+    if constexpr (std::is_floating_point_v<Scalar>)
+        if (not std::is_constant_evaluated())
+            return std::fma(a, b, c);
+    return a * b + c;
+}
+
+/// Evaluate `sum + x`, while the rounding error of the addition is accumulated into `comp` (TwoSum
+/// of Knuth), s.t. `sum + comp` is the compensated sum. Unlike the branch of Neumaier, the error is
+/// exact regardless of the magnitudes of the operands.
+///
+/// \note This is optimized away by `-ffast-math`.
+template <typename Scalar> constexpr Scalar two_sum(Scalar sum, Scalar x, Scalar &comp) {
+    auto const t = sum + x;
+    auto const z = t - sum;
+    comp += (sum - (t - z)) + (x - z);
+    return t;
+}
+
 template <typename T> consteval auto height_or_1() {
     if constexpr (is_vecteur<T>)
         return T::height;
@@ -55,7 +106,7 @@ template <typename T> struct VecteurOperandType {
 
 template <typename Scalar, std::size_t Size, VecteurBackend backend>
 struct VecteurOperandType<Vecteur<Scalar, Size, backend>> {
-    using type = Scalar;
+    using type = std::conditional_t<is_narrow_scalar<Scalar>, float, Scalar>;
     static constexpr std::size_t size = Size;
     static constexpr bool is_vecteur = true;
     static constexpr bool is_dynamic = (size == std::dynamic_extent);
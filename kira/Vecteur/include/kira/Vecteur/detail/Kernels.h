@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace kira::vecteur::detail {
+//! NOTE(krr): These are the entry points of the SIMD kernels compiled in `src/Highway.cpp`. The
+//! kernels are built once for every target in `HWY_TARGETS` and the best one supported by the host
+//! CPU is selected through `HWY_DYNAMIC_DISPATCH` at the first call, so a single binary picks
+//! SSE4/AVX2/AVX-512 at runtime instead of being fixed by `-march`.
+//!
+//! The entry points are not templates, since a dispatch table can only hold concrete functions.
+//! They are overloaded on all the scalar types in `is_kernel_scalar`.
+
+/// Scalar types the dispatched kernels are compiled for.
+template <typename Scalar>
+concept is_kernel_scalar = std::is_same_v<Scalar, float> or std::is_same_v<Scalar, double> or
+                           std::is_same_v<Scalar, int32_t> or std::is_same_v<Scalar, int64_t>;
+
+/// Element-wise binary operations implemented by the kernels.
+///
+/// \note `Atan2` and `Pow` are only vectorized for floating-point scalars, see
+/// \c TranscendentalUlp for their accuracy.
+enum class BinaryKernelOp : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Min,
+    Max,
+    Atan2,
+    Pow,
+};
+
+/// Element-wise unary operations implemented by the kernels.
+///
+/// \note The operations past `Abs` are only vectorized for floating-point scalars. The integers
+/// are evaluated element-wise with the semantic of the generic backend.
+enum class UnaryKernelOp : uint8_t {
+    Neg,
+    Sqr,
+    Abs,
+    Sqrt,
+    RSqrt,
+    Floor,
+    Ceil,
+    Exp,
+    Log,
+    Sin,
+    Cos,
+    Asin,
+    Acos,
+    Atan,
+};
+
+//! NOTE(krr): The transcendental functions are vectorized with the polynomial approximations of
+//! `hwy/contrib/math`, both by the kernels and the lazy packets. They are not correctly rounded,
+//! the maximum error against `std::` (in ULP, for both `float` and `double`) is:
+//!
+//! | function       | ULP | domain                                                        |
+//! | -------------- | --- | ------------------------------------------------------------- |
+//! | `exp`          | 1   | `[-inf, 104]` for `float`, `[-inf, 706]` for `double`         |
+//! | `log`          | 4   | `(0, inf]`                                                    |
+//! | `sin`, `cos`   | 3   | `[-39000, 39000]`, the error grows unbounded past that        |
+//! | `asin`, `acos` | 2   | `[-1, 1]`                                                     |
+//! | `atan`         | 3   | all                                                           |
+//! | `atan2`        | 3   | all                                                           |
+//! | `pow`          | 5   | `|y * log(x)| <= 1`                                           |
+//!
+//! `pow(x, y)` is `exp(y * log(|x|))` with the sign and the special cases of `std::pow` fixed,
+//! thus its error grows with `|y * log(x)|` past that, since `exp` amplifies the error of the
+//! product. The small static vecteurs and the expressions evaluated at compile time call
+//! `std::` instead, thus the results of the same input might differ within these bounds.
+
+/// The documented maximum error of the vectorized transcendental functions, in ULP.
+inline constexpr int TranscendentalUlp = 5;
+
+/// Reductions implemented by the kernels.
+enum class ReduceKernelOp : uint8_t {
+    Sum,     //< `sum(lhs[i])`, `rhs` is ignored.
+    Dot,     //< `sum(lhs[i] * rhs[i])`.
+    SqrDist, //< `sum((lhs[i] - rhs[i])^2)`.
+};
+
+/// The summation used by the reductions.
+enum class Summation : uint8_t {
+    /// Sum into \c ReduceAccumulators independent accumulators, which are combined pairwise.
+    Accumulators,
+    /// Same as \c Accumulators, but every accumulator carries the rounding error of its additions,
+    /// which is added back at the end (Neumaier). Exact for integers, thus only differs for the
+    /// floating-point scalars.
+    Compensated,
+};
+
+//! NOTE(krr): The reductions are latency-bound by the dependency of the accumulator, i.e., a single
+//! accumulator only issues an addition every 4 cycles or so. Sum into several independent
+//! accumulators instead. The summation order is deterministic, i.e., the same for the same size on
+//! the same target, and is shared by the kernels, the lazy packets and the scalar loops:
+//!
+//! - the elements are split into the blocks of `lanes` elements, where `lanes` is the number of
+//!   lanes of the target (1 for the scalar loops);
+//! - the block `j` is added to the accumulator `j % ReduceAccumulators` as long as there are
+//!   `ReduceAccumulators` full blocks left, the rest of the blocks are added to the accumulator 0
+//!   (the lazy packets sum the last partial block element-wise and add it after the lanes instead);
+//! - the accumulators are combined pairwise, i.e., `(a0 + a1) + (a2 + a3)`, then the lanes are
+//!   summed.
+//!
+//! Thus, the result of a floating-point reduction might differ between the targets (see
+//! `HighwayTargetName()`) in the last bits, but not between the runs.
+
+/// Number of the independent accumulators of the reductions.
+inline constexpr std::size_t ReduceAccumulators = 4;
+
+#define KIRA_KERNEL_DECLARE(Scalar)                                                                \
+    void BinaryKernel(                                                                             \
+        BinaryKernelOp op, Scalar const *lhs, Scalar const *rhs, Scalar *out, std::size_t size     \
+    );                                                                                             \
+    void BinaryKernel(                                                                             \
+        BinaryKernelOp op, Scalar const *lhs, Scalar rhs, Scalar *out, std::size_t size            \
+    );                                                                                             \
+    void BinaryKernel(                                                                             \
+        BinaryKernelOp op, Scalar lhs, Scalar const *rhs, Scalar *out, std::size_t size            \
+    );                                                                                             \
+    void UnaryKernel(UnaryKernelOp op, Scalar const *in, Scalar *out, std::size_t size);         \
+    Scalar ReduceKernel(                                                                           \
+        ReduceKernelOp op, Summation summation, Scalar const *lhs, Scalar const *rhs,              \
+        std::size_t size                                                                           \
+    );
+
+/// \fn BinaryKernel
+/// `out[i] = lhs[i] op rhs[i]` for `i` in `[0, size)`, where either operand can be a scalar that
+/// is broadcast to all the elements.
+///
+/// \note The pointers are not required to be aligned, `out` may alias the operands.
+
+/// \fn UnaryKernel
+/// `out[i] = op(in[i])` for `i` in `[0, size)`.
+///
+/// \note The pointers are not required to be aligned, `out` may alias `in`.
+
+/// \fn ReduceKernel
+/// Reduce `lhs` (and `rhs`) of `size` elements into a scalar, see \c ReduceKernelOp.
+///
+/// \note The sum of zero elements is zero.
+
+KIRA_KERNEL_DECLARE(float)
+KIRA_KERNEL_DECLARE(double)
+KIRA_KERNEL_DECLARE(int32_t)
+KIRA_KERNEL_DECLARE(int64_t)
+#undef KIRA_KERNEL_DECLARE
+} // namespace kira::vecteur::detail
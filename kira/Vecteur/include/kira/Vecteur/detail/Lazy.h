@@ -1,16 +1,25 @@
 #pragma once
 
+#include <cmath>
 #include <string_view>
 
 #include "../Traits.h"
+#include "Packet.h"
 
 namespace kira::vecteur::detail {
+//! NOTE(krr): Besides the scalar `operator()`, the operations that map to the Highway operations
+//! with the same semantic provide a `packet()` and set `has_packet`. The expression trees composed
+//! only by them are evaluated with packets, see `VecteurLazyBase::eval_()`.
+
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpAdd {
     static constexpr std::string_view expr_str = "+";
     constexpr auto operator()(LHSScalar const &lhs, RHSScalar const &rhs) const
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return lhs + rhs;
     }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Add(lhs, rhs); }
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpSub {
@@ -19,6 +28,9 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpSub {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return lhs - rhs;
     }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Sub(lhs, rhs); }
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpMul {
@@ -27,6 +39,9 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpMul {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return lhs * rhs;
     }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Mul(lhs, rhs); }
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpDiv {
@@ -35,6 +50,10 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpDiv {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return lhs / rhs;
     }
+
+    static constexpr bool has_packet =
+        std::is_floating_point_v<typename PromotedType<LHSScalar, RHSScalar>::type>;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Div(lhs, rhs); }
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpMod {
@@ -43,6 +62,8 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpMod {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return lhs % rhs;
     }
+
+    static constexpr bool has_packet = false;
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpMax {
@@ -51,6 +72,9 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpMax {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return std::max(lhs, rhs);
     }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Max(lhs, rhs); }
 };
 
 template <typename LHSScalar, typename RHSScalar> struct BinaryOpMin {
@@ -59,47 +83,216 @@ template <typename LHSScalar, typename RHSScalar> struct BinaryOpMin {
         -> PromotedType<LHSScalar, RHSScalar>::type {
         return std::min(lhs, rhs);
     }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) { return hn::Min(lhs, rhs); }
+};
+
+//! NOTE(krr): The transcendental operations below are packetable for the floating-point scalars,
+//! where the packets are the approximations of `hwy/contrib/math`, see `TranscendentalUlp`.
+
+template <typename LHSScalar, typename RHSScalar> struct BinaryOpAtan2 {
+    static constexpr std::string_view expr_str = "atan2";
+    constexpr auto operator()(LHSScalar const &lhs, RHSScalar const &rhs) const
+        -> PromotedType<LHSScalar, RHSScalar>::type {
+        return std::atan2(lhs, rhs);
+    }
+
+    static constexpr bool has_packet =
+        std::is_floating_point_v<typename PromotedType<LHSScalar, RHSScalar>::type>;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) {
+        return hn::Atan2(hn::DFromV<V>(), lhs, rhs);
+    }
+};
+
+template <typename LHSScalar, typename RHSScalar> struct BinaryOpPow {
+    static constexpr std::string_view expr_str = "pow";
+    constexpr auto operator()(LHSScalar const &lhs, RHSScalar const &rhs) const
+        -> PromotedType<LHSScalar, RHSScalar>::type {
+        return std::pow(lhs, rhs);
+    }
+
+    static constexpr bool has_packet =
+        std::is_floating_point_v<typename PromotedType<LHSScalar, RHSScalar>::type>;
+    template <class V> static KIRA_FORCEINLINE V packet(V lhs, V rhs) {
+        return vecteur::HWY_NAMESPACE::Pow(lhs, rhs);
+    }
 };
 
 template <typename Scalar> struct UnaryOp0Abs {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::abs(operand); }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) { return hn::Abs(operand); }
 };
 
 template <typename Scalar> struct UnaryOp0Ceil {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::ceil(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) { return hn::Ceil(operand); }
 };
 
 template <typename Scalar> struct UnaryOp0Exp {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::exp(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Exp(hn::DFromV<V>(), operand);
+    }
 };
 
 template <typename Scalar> struct UnaryOp0Floor {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::floor(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) { return hn::Floor(operand); }
 };
 
 template <typename Scalar> struct UnaryOp0Log {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::log(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Log(hn::DFromV<V>(), operand);
+    }
 };
 
 template <typename Scalar> struct UnaryOp0Round {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::round(operand); }
+
+    static constexpr bool has_packet = false;
 };
 
 template <typename Scalar> struct UnaryOp0Sqrt {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::sqrt(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) { return hn::Sqrt(operand); }
 };
 
 template <typename Scalar> struct UnaryOp0RSqrt {
     constexpr auto operator()(Scalar const &operand) const -> Scalar {
         return 1 / std::sqrt(operand);
     }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Div(hn::Set(hn::DFromV<V>(), Scalar(1)), hn::Sqrt(operand));
+    }
 };
 
 template <typename Scalar> struct UnaryOp0Neg {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return -operand; }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) { return hn::Neg(operand); }
 };
 
 template <typename Scalar> struct UnaryOp0Sqr {
     constexpr auto operator()(Scalar const &operand) const -> Scalar { return operand * operand; }
+
+    static constexpr bool has_packet = true;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Mul(operand, operand);
+    }
+};
+
+template <typename Scalar> struct UnaryOp0Sin {
+    constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::sin(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Sin(hn::DFromV<V>(), operand);
+    }
+};
+
+template <typename Scalar> struct UnaryOp0Cos {
+    constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::cos(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Cos(hn::DFromV<V>(), operand);
+    }
+};
+
+template <typename Scalar> struct UnaryOp0Asin {
+    constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::asin(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Asin(hn::DFromV<V>(), operand);
+    }
+};
+
+template <typename Scalar> struct UnaryOp0Acos {
+    constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::acos(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Acos(hn::DFromV<V>(), operand);
+    }
+};
+
+template <typename Scalar> struct UnaryOp0Atan {
+    constexpr auto operator()(Scalar const &operand) const -> Scalar { return std::atan(operand); }
+
+    static constexpr bool has_packet = std::is_floating_point_v<Scalar>;
+    template <class V> static KIRA_FORCEINLINE V packet(V operand) {
+        return hn::Atan(hn::DFromV<V>(), operand);
+    }
+};
+
+//! NOTE(krr): The ternary operations are only created by the `VecteurOptimizer`, see the rewrite
+//! rules there. They are fused for the floating-point scalars in both the packets and the
+//! remainder, s.t. the result does not depend on the position of the element. The targets without
+//! the FMA instructions thus evaluate them by `std::fma` elementwise.
+
+template <typename Scalar> struct TernaryOpMulAdd {
+    static constexpr std::string_view expr_str = "fma";
+    constexpr auto operator()(Scalar const &a, Scalar const &b, Scalar const &c) const -> Scalar {
+        return fused_mul_add(a, b, c);
+    }
+
+    static constexpr bool has_packet = not std::is_floating_point_v<Scalar> or
+                                       is_packet_mul_add_fused;
+    template <class V> static KIRA_FORCEINLINE V packet(V a, V b, V c) {
+        if constexpr (std::is_floating_point_v<Scalar>)
+            return hn::MulAdd(a, b, c);
+        else
+            return hn::Add(hn::Mul(a, b), c);
+    }
+};
+
+template <typename Scalar> struct TernaryOpMulSub {
+    static constexpr std::string_view expr_str = "fms";
+    constexpr auto operator()(Scalar const &a, Scalar const &b, Scalar const &c) const -> Scalar {
+        return fused_mul_add(a, b, Scalar(-c));
+    }
+
+    static constexpr bool has_packet = not std::is_floating_point_v<Scalar> or
+                                       is_packet_mul_add_fused;
+    template <class V> static KIRA_FORCEINLINE V packet(V a, V b, V c) {
+        if constexpr (std::is_floating_point_v<Scalar>)
+            return hn::MulSub(a, b, c);
+        else
+            return hn::Sub(hn::Mul(a, b), c);
+    }
+};
+
+template <typename Scalar> struct TernaryOpNegMulAdd {
+    static constexpr std::string_view expr_str = "fnma";
+    constexpr auto operator()(Scalar const &a, Scalar const &b, Scalar const &c) const -> Scalar {
+        return fused_mul_add(Scalar(-a), b, c);
+    }
+
+    static constexpr bool has_packet = not std::is_floating_point_v<Scalar> or
+                                       is_packet_mul_add_fused;
+    template <class V> static KIRA_FORCEINLINE V packet(V a, V b, V c) {
+        if constexpr (std::is_floating_point_v<Scalar>)
+            return hn::NegMulAdd(a, b, c);
+        else
+            return hn::Sub(c, hn::Mul(a, b));
+    }
 };
 } // namespace kira::vecteur::detail
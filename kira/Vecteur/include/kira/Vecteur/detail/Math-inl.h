@@ -0,0 +1,51 @@
+// NOTE(krr): This header is shared by the kernels, which include it once per Highway target (see
+// `src/Highway-inl.h`), and the lazy packets of the static target (see `Packet.h`), thus it uses
+// the per-target include guard instead of `#pragma once`. Both evaluate the same functions here,
+// s.t. the eager and lazy backends agree on every element.
+#if defined(KIRA_VECTEUR_DETAIL_MATH_INL_H_) == defined(HWY_TARGET_TOGGLE)
+#ifdef KIRA_VECTEUR_DETAIL_MATH_INL_H_
+#undef KIRA_VECTEUR_DETAIL_MATH_INL_H_
+#else
+#define KIRA_VECTEUR_DETAIL_MATH_INL_H_
+#endif
+
+#include <hwy/contrib/math/math-inl.h>
+#include <hwy/highway.h>
+
+HWY_BEFORE_NAMESPACE();
+namespace kira::vecteur::HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+/// `pow(x, y)` as `exp(y * log(|x|))`, with the sign and the special cases of `std::pow` fixed,
+/// see \c detail::TranscendentalUlp.
+template <class V> HWY_INLINE V Pow(V x, V y) {
+    using T = hn::TFromV<V>;
+    auto const tag = hn::DFromV<V>();
+    auto const zero = hn::Zero(tag), one = hn::Set(tag, T(1));
+    auto const ax = hn::Abs(x);
+
+    // `log(0)` is out of the domain of the approximation.
+    auto const zeroBase = hn::IfThenElse(hn::Lt(y, zero), hn::Inf(tag), zero);
+    auto result = hn::IfThenElse(
+        hn::Eq(ax, zero), zeroBase, hn::Exp(tag, hn::Mul(y, hn::Log(tag, ax)))
+    );
+
+    // The sign of the negative bases, including `-0`, is the parity of the integer exponents,
+    // while the other exponents are not defined for them.
+    auto const half = hn::Mul(y, hn::Set(tag, T(0.5)));
+    auto const integral = hn::Eq(hn::Floor(y), y);
+    auto const odd = hn::AndNot(hn::Eq(hn::Floor(half), half), integral);
+    auto const negative = hn::Lt(hn::CopySign(one, x), zero);
+    result = hn::IfThenElse(hn::And(negative, odd), hn::Neg(result), result);
+    result = hn::IfThenElse(hn::AndNot(integral, hn::Lt(x, zero)), hn::NaN(tag), result);
+
+    // `pow(x, 0)`, `pow(1, y)` and `pow(-1, inf)` are 1, even for the NaNs.
+    auto const unit = hn::Or(
+        hn::Or(hn::Eq(y, zero), hn::Eq(x, one)), hn::And(hn::Eq(ax, one), hn::IsInf(y))
+    );
+    return hn::IfThenElse(unit, one, result);
+}
+} // namespace kira::vecteur::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#endif // KIRA_VECTEUR_DETAIL_MATH_INL_H_
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <hwy/contrib/math/math-inl.h>
+#include <hwy/highway.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "kira/Compiler.h"
+
+#include "Kernels.h"
+#include "Math-inl.h"
+
+namespace kira::vecteur::detail {
+//! NOTE(krr): Unlike the kernels in `src/Highway.cpp`, the lazy expressions are templates
+//! instantiated in the user's translation units, so they cannot be dynamically dispatched. The
+//! packets are thus compiled for the static target, i.e., the best target enabled by the compiler
+//! flags (e.g., `KRR_BUILD_FOR_NATIVE`), which is at least SSE2 on x86-64.
+namespace hn = hwy::HWY_NAMESPACE;
+
+/// Scalar types the packets are evaluated for.
+template <typename Scalar>
+concept is_packet_scalar = is_kernel_scalar<Scalar>;
+
+/// The descriptor of a full packet of `Scalar`.
+template <typename Scalar> using PacketTag = hn::ScalableTag<Scalar>;
+
+//! NOTE(krr): The last packet of an expression only holds the remaining `lanes` elements, which
+//! are loaded and stored with the masked `LoadN` and `StoreN`, while `FullPacket` is passed for
+//! the others. Every element thus goes through the same `packet()` of the ops, instead of the
+//! remainder going through `entry()`, whose algorithm might differ (e.g., the polynomials of the
+//! transcendentals against `std::`). The lanes past the remainder hold the ops of zeros, thus they
+//! are never stored, and are zeroed by \c zero_past before being reduced.
+
+/// Marks the packets whose lanes are all elements of the expression.
+struct FullPacket {};
+
+/// Load the packet starting at `ptr`.
+template <class D> KIRA_FORCEINLINE auto load_packet(D tag, hn::TFromD<D> const *ptr, FullPacket) {
+    return hn::LoadU(tag, ptr);
+}
+
+/// Load the first `lanes` elements and zero the others, without touching the memory past
+/// `ptr + lanes`.
+template <class D>
+KIRA_FORCEINLINE auto load_packet(D tag, hn::TFromD<D> const *ptr, std::size_t lanes) {
+    return hn::LoadN(tag, ptr, lanes);
+}
+
+/// Store the packet starting at `ptr`.
+template <class V, class D>
+KIRA_FORCEINLINE void store_packet(V v, D tag, hn::TFromD<D> *ptr, FullPacket) {
+    hn::StoreU(v, tag, ptr);
+}
+
+/// Store the first `lanes` elements, without touching the memory past `ptr + lanes`.
+template <class V, class D>
+KIRA_FORCEINLINE void store_packet(V v, D tag, hn::TFromD<D> *ptr, std::size_t lanes) {
+    hn::StoreN(v, tag, ptr, lanes);
+}
+
+/// The packet as is, whose lanes are all elements.
+template <class V, class D> KIRA_FORCEINLINE V zero_past(D /*tag*/, V v, FullPacket) { return v; }
+
+/// Zero the lanes past the remaining `lanes` elements, s.t. they add nothing to the reductions.
+template <class V, class D> KIRA_FORCEINLINE V zero_past(D tag, V v, std::size_t lanes) {
+    return hn::IfThenElseZero(hn::FirstN(tag, lanes), v);
+}
+
+/// Load the packet of the operand starting at the element `i`, or broadcast the scalar operand.
+template <typename T, class D>
+KIRA_FORCEINLINE auto packet_or_scalar(T const &obj, D tag, auto i, auto lanes) {
+    if constexpr (requires { obj.packet(tag, i, lanes); })
+        return obj.packet(tag, i, lanes);
+    else
+        return hn::Set(tag, hn::TFromD<D>(obj));
+}
+
+/// Whether the operand can be loaded as packets of `Scalar`. Scalar operands are broadcast after
+/// the conversion, thus they are always packetable, while the vecteur operands must be of the same
+/// scalar type.
+template <typename T, typename Scalar> consteval bool packetable_or_scalar() {
+    if constexpr (requires { T::packetable; })
+        return T::packetable and std::is_same_v<typename T::Scalar, Scalar>;
+    else
+        return std::is_arithmetic_v<T>;
+}
+
+/// Whether `hn::MulAdd` and its variants are fused for the floating-point packets of the static
+/// target, while the targets without the FMA instructions (e.g., SSE4) multiply and add separately.
+inline constexpr bool is_packet_mul_add_fused = HWY_NATIVE_FMA;
+
+/// Whether the packets of `Scalar` can be gathered with the indices of `Index`, i.e., the indices
+/// are integers of the same width as `Scalar`, or 32-bit indices of a 64-bit `Scalar`, which are
+/// promoted. The unsigned indices are reinterpreted as signed, thus must be less than `2^31`.
+template <typename Scalar, typename Index> consteval bool is_gather_index() {
+    if constexpr (not is_packet_scalar<Scalar> or not std::is_integral_v<Index>)
+        return false;
+    else
+        return sizeof(Index) == sizeof(Scalar) or (sizeof(Index) == 4 and sizeof(Scalar) == 8);
+}
+
+/// Load the packet of the indices starting at `indices`, as the signed integers of the width of
+/// the lanes of `tag`, see \c is_gather_index. The indices past the remaining `lanes` are zero.
+template <class D, typename Index>
+KIRA_FORCEINLINE auto packet_indices(D /*tag*/, Index const *indices, auto lanes) {
+    using Signed = std::make_signed_t<Index>;
+    auto const *ptr = reinterpret_cast<Signed const *>(indices);
+    auto const itag = hn::RebindToSigned<D>();
+    if constexpr (sizeof(Index) == sizeof(hn::TFromD<D>))
+        return load_packet(itag, ptr, lanes);
+    else
+        return hn::PromoteTo(itag, load_packet(hn::Rebind<Signed, D>(), ptr, lanes));
+}
+
+/// Reduce `[0, size)` with \c Summation::Accumulators, in the same order as the kernels.
+///
+/// \param accumulate A callable `(acc, tag, i, lanes)` returning `acc` plus the terms of the
+/// packet starting at `i`, where `lanes` is either \c FullPacket or the number of the remaining
+/// elements, whose terms past them must be zeroed by \c zero_past.
+template <typename Scalar, typename Accumulate>
+KIRA_FORCEINLINE Scalar reduce_packets(std::size_t size, Accumulate const &accumulate) {
+    static_assert(ReduceAccumulators == 4);
+
+    auto const tag = PacketTag<Scalar>();
+    auto const lanes = hn::Lanes(tag);
+    auto acc0 = hn::Zero(tag), acc1 = hn::Zero(tag), acc2 = hn::Zero(tag), acc3 = hn::Zero(tag);
+
+    std::size_t i = 0;
+    for (; i + 4 * lanes <= size; i += 4 * lanes) {
+        acc0 = accumulate(acc0, tag, i, FullPacket{});
+        acc1 = accumulate(acc1, tag, i + lanes, FullPacket{});
+        acc2 = accumulate(acc2, tag, i + 2 * lanes, FullPacket{});
+        acc3 = accumulate(acc3, tag, i + 3 * lanes, FullPacket{});
+    }
+    for (; i + lanes <= size; i += lanes)
+        acc0 = accumulate(acc0, tag, i, FullPacket{});
+    if (i < size)
+        acc0 = accumulate(acc0, tag, i, size - i);
+
+    return hn::ReduceSum(tag, hn::Add(hn::Add(acc0, acc1), hn::Add(acc2, acc3)));
+}
+} // namespace kira::vecteur::detail
@@ -1,10 +1,47 @@
 #pragma once
 
 #include "../Traits.h"
+#include "Kernels.h"
 
 namespace kira::vecteur::detail {
 //! NOTE(krr): This is abstracted out, because many backends will have the same implementation,
 //! while reduction is hard to be optimized by expression template.
+//!
+//! The sums follow the order documented in `Kernels.h` with a single lane, s.t. the small static
+//! vecteurs (less than `ReduceAccumulators` elements) are still summed from left to right.
+
+/// Reduce `accumulate(acc, i)` for `i` in `[0, size)` with \c Summation::Accumulators.
+template <typename Result, typename Accumulate>
+constexpr Result reduce(std::size_t size, Accumulate const &accumulate) {
+    Result acc[ReduceAccumulators]{};
+    std::size_t i = 0;
+    for (; i + ReduceAccumulators <= size; i += ReduceAccumulators)
+        for (std::size_t k = 0; k < ReduceAccumulators; ++k)
+            acc[k] = accumulate(acc[k], i + k);
+    for (; i < size; ++i)
+        acc[0] = accumulate(acc[0], i);
+
+    static_assert(ReduceAccumulators == 4);
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/// Sum `term(i)` for `i` in `[0, size)` with \c Summation::Compensated.
+template <typename Result, typename Term>
+constexpr Result reduce_compensated(std::size_t size, Term const &term) {
+    Result sums[ReduceAccumulators]{}, comps[ReduceAccumulators]{};
+    std::size_t i = 0;
+    for (; i + ReduceAccumulators <= size; i += ReduceAccumulators)
+        for (std::size_t k = 0; k < ReduceAccumulators; ++k)
+            sums[k] = two_sum<Result>(sums[k], term(i + k), comps[k]);
+    for (; i < size; ++i)
+        sums[0] = two_sum<Result>(sums[0], term(i), comps[0]);
+
+    static_assert(ReduceAccumulators == 4);
+    Result comp = (comps[0] + comps[1]) + (comps[2] + comps[3]);
+    Result const lhs = two_sum<Result>(sums[0], sums[1], comp);
+    Result const rhs = two_sum<Result>(sums[2], sums[3], comp);
+    return two_sum<Result>(lhs, rhs, comp) + comp;
+}
 
 template <typename Derived> struct VecteurReductionMixin {
 private:
@@ -17,14 +54,22 @@ public:
         requires(is_static_operable<Derived, RHS>)
     {
         CheckDynamicOperable(derived_(), rhs);
-        auto result = derived_().entry(0_U) * rhs.entry(0_U);
-        if (std::is_constant_evaluated())
-            for (std::size_t i = 1; i < derived_().size(); ++i)
-                result += derived_().entry(i) * rhs.entry(i);
-        else
-            for (std::size_t i = 1; i < derived_().size(); ++i)
-                result = std::fma(derived_().entry(i), rhs.entry(i), result);
-        return result;
+        using Result = decltype(derived_().entry(0_U) * rhs.entry(0_U));
+        return reduce<Result>(derived_().size(), [&](Result acc, std::size_t i) {
+            return mul_add<Result>(derived_().entry(i), rhs.entry(i), acc);
+        });
+    }
+
+    /// \copydoc dot_ with \c Summation::Compensated.
+    template <is_vecteur RHS>
+    constexpr auto dot_compensated_(RHS const &rhs) const
+        requires(is_static_operable<Derived, RHS>)
+    {
+        CheckDynamicOperable(derived_(), rhs);
+        using Result = decltype(derived_().entry(0_U) * rhs.entry(0_U));
+        return reduce_compensated<Result>(derived_().size(), [&](std::size_t i) {
+            return Result(derived_().entry(i) * rhs.entry(i));
+        });
     }
 
     template <is_vecteur RHS>
@@ -44,23 +89,31 @@ public:
     {
         CheckDynamicOperable(derived_(), rhs);
 
-        auto sqrDist = typename Derived::Scalar{0};
-        for (std::size_t i = 0; i < derived_().size(); ++i) {
+        using Scalar = typename Derived::Scalar;
+        auto const sqrDist = reduce<Scalar>(derived_().size(), [&](Scalar acc, std::size_t i) {
             auto const diff = derived_().entry(i) - rhs.entry(i);
-            sqrDist += diff * diff;
-        }
+            return acc + diff * diff;
+        });
 
         return sqrDist <= epsilon * epsilon;
     }
 
-    constexpr auto norm2_() const { return derived_().sqr().hsum(); }
-    constexpr auto norm_() const { return std::sqrt(norm2_()); }
+    constexpr auto norm2_() const { return derived_().dot(derived_()); }
+    constexpr auto norm_() const { return std::sqrt(derived_().norm2()); }
 
     constexpr auto hsum_() const {
-        auto result = derived_().entry(0_U);
-        for (std::size_t i = 1; i < derived_().size(); ++i)
-            result += derived_().entry(i);
-        return result;
+        using Result = std::remove_cvref_t<decltype(derived_().entry(0_U))>;
+        return reduce<Result>(derived_().size(), [&](Result acc, std::size_t i) {
+            return acc + derived_().entry(i);
+        });
+    }
+
+    /// \copydoc hsum_ with \c Summation::Compensated.
+    constexpr auto hsum_compensated_() const {
+        using Result = std::remove_cvref_t<decltype(derived_().entry(0_U))>;
+        return reduce_compensated<Result>(derived_().size(), [&](std::size_t i) {
+            return derived_().entry(i);
+        });
     }
 
     constexpr auto hprod_() const {
@@ -0,0 +1,91 @@
+#include "kira/Vecteur/Allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace kira::vecteur {
+namespace {
+/// Set in the count of a block once the arena lets go of it.
+constexpr std::size_t droppedBit = std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1);
+} // namespace
+
+VecteurArena &VecteurArena::local() {
+    static thread_local VecteurArena arena;
+    return arena;
+}
+
+void VecteurArena::freeCounted(BlockCount *count) noexcept {
+    // The last allocation of a block which the arena let go of frees it.
+    if (count->fetch_sub(1, std::memory_order_acq_rel) == (droppedBit | 1)) {
+        count->~BlockCount();
+        VecteurHeapAllocator::deallocate(count);
+    }
+}
+
+void VecteurArena::drop(Block const &block) noexcept {
+    if (block.count->fetch_or(droppedBit, std::memory_order_acq_rel) == 0) {
+        block.count->~BlockCount();
+        VecteurHeapAllocator::deallocate(block.count);
+    }
+}
+
+void VecteurArena::reset() {
+    // Only this thread counts the allocations, thus a block without any stays without any.
+    std::size_t kept = 0;
+    for (auto const &block : blocks) {
+        if (block.count->load(std::memory_order_acquire) == 0)
+            blocks[kept++] = block;
+        else
+            drop(block);
+    }
+    blocks.resize(kept);
+    current = 0;
+    cursor = 0;
+}
+
+void VecteurArena::release() {
+    for (auto const &block : blocks)
+        drop(block);
+    blocks.clear();
+    current = 0;
+    cursor = 0;
+}
+
+std::size_t VecteurArena::used() const {
+    std::size_t result = cursor;
+    for (std::size_t i = 0; i < current and i < blocks.size(); ++i)
+        result += blocks[i].size;
+    return result;
+}
+
+std::size_t VecteurArena::capacity() const {
+    std::size_t result = 0;
+    for (auto const &block : blocks)
+        result += block.size;
+    return result;
+}
+
+void *VecteurArena::allocateSlow(std::size_t bytes) {
+    // The blocks are aligned to `BlockAlignment`, thus an allocation at the beginning of a block
+    // does not need any padding. The blocks skipped here are left unused until `reset()`.
+    if (current < blocks.size())
+        ++current;
+    while (current < blocks.size() and blocks[current].size < bytes)
+        ++current;
+
+    if (current == blocks.size()) {
+        // The count takes the first `BlockAlignment` bytes, s.t. the data stays aligned.
+        auto const size = std::max(blockSize, bytes);
+        auto *base = static_cast<std::byte *>(
+            VecteurHeapAllocator::allocate(BlockAlignment + size, BlockAlignment)
+        );
+        if (!base)
+            return nullptr;
+        blocks.push_back({base + BlockAlignment, size, new (base) BlockCount(0)});
+    }
+
+    cursor = bytes;
+    return blocks[current].data;
+}
+} // namespace kira::vecteur
@@ -0,0 +1,422 @@
+// NOTE(krr): This header is compiled once per Highway target (see `src/Highway.cpp`), thus it
+// uses the per-target include guard instead of `#pragma once`. It is private to the module, and
+// lives next to its only includer s.t. it is not installed with the public headers.
+#if defined(KIRA_VECTEUR_SRC_HIGHWAY_INL_H_) == defined(HWY_TARGET_TOGGLE)
+#ifdef KIRA_VECTEUR_SRC_HIGHWAY_INL_H_
+#undef KIRA_VECTEUR_SRC_HIGHWAY_INL_H_
+#else
+#define KIRA_VECTEUR_SRC_HIGHWAY_INL_H_
+#endif
+
+#include <hwy/contrib/math/math-inl.h>
+#include <hwy/highway.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "kira/Vecteur/Traits.h"
+#include "kira/Vecteur/detail/Kernels.h"
+#include "kira/Vecteur/detail/Math-inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace kira::vecteur::HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+//! NOTE(krr): The target pragma of `HWY_BEFORE_NAMESPACE` does not reach the lambdas on clang,
+//! which are then compiled for the baseline and cannot inline the ops of the target. Every lambda
+//! here is thus marked `HWY_ATTR`, including the ones passed to the loops.
+
+/// Marks the iterations of \c StripMining that process a full vector.
+struct FullVector {};
+
+/// Strip-mine the loop `[0, size)` into full vectors and a single partial vector.
+///
+/// \param loopBody A callable `(tag, i, lanes)` processing the elements starting at `i`, where
+/// `lanes` is either \c FullVector or the number of remaining elements. Pass `lanes` to
+/// \c LoadLanes and \c StoreLanes, s.t. the remainder is handled with the masked loads instead of a
+/// scalar loop.
+template <typename Scalar, typename LoopBody>
+HWY_INLINE void StripMining(std::size_t size, LoopBody const &loopBody) {
+    std::size_t i = 0;
+
+    auto const tag = hn::ScalableTag<Scalar>();
+    auto const lanes = hn::Lanes(tag);
+    for (; i + lanes <= size; i += lanes)
+        loopBody(tag, i, FullVector{});
+
+    if (i < size)
+        loopBody(tag, i, size - i);
+}
+
+/// Load a full vector.
+template <class D>
+HWY_INLINE auto LoadLanes(D tag, hn::TFromD<D> const *ptr, FullVector) {
+    return hn::LoadU(tag, ptr);
+}
+
+/// Load the first `lanes` elements and zero the others. This never touches the memory past
+/// `ptr + lanes`.
+template <class D>
+HWY_INLINE auto LoadLanes(D tag, hn::TFromD<D> const *ptr, std::size_t lanes) {
+    return hn::LoadN(tag, ptr, lanes);
+}
+
+/// Store a full vector.
+template <class D, class V>
+HWY_INLINE void StoreLanes(V v, D tag, hn::TFromD<D> *ptr, FullVector) {
+    hn::StoreU(v, tag, ptr);
+}
+
+/// Store the first `lanes` elements. This never touches the memory past `ptr + lanes`.
+template <class D, class V>
+HWY_INLINE void StoreLanes(V v, D tag, hn::TFromD<D> *ptr, std::size_t lanes) {
+    hn::StoreN(v, tag, ptr, lanes);
+}
+
+/// Fetch the operand from the memory.
+template <class D>
+HWY_INLINE auto Fetch(D tag, hn::TFromD<D> const *operand, std::size_t i, auto lanes) {
+    return LoadLanes(tag, operand + i, lanes);
+}
+
+/// Broadcast the scalar operand.
+template <class D>
+HWY_INLINE auto Fetch(D tag, hn::TFromD<D> const &operand, std::size_t, auto) {
+    return hn::Set(tag, operand);
+}
+
+/// Evaluate the operand at the element `i` for the scalar fallbacks.
+template <typename Scalar> HWY_INLINE Scalar FetchScalar(Scalar const *operand, std::size_t i) {
+    return operand[i];
+}
+
+/// \copydoc FetchScalar
+template <typename Scalar> HWY_INLINE Scalar FetchScalar(Scalar const &operand, std::size_t) {
+    return operand;
+}
+
+/// `out = op(lhs, rhs)`, where the operands are either pointers or scalars.
+template <typename Scalar, typename LHS, typename RHS, typename Op>
+HWY_INLINE void BinaryLoop(LHS lhs, RHS rhs, Scalar *out, std::size_t size, Op const &op) {
+    StripMining<Scalar>(size, [&](auto tag, std::size_t i, auto lanes) HWY_ATTR {
+        auto const v1 = Fetch(tag, lhs, i, lanes);
+        auto const v2 = Fetch(tag, rhs, i, lanes);
+        StoreLanes(op(v1, v2), tag, out + i, lanes);
+    });
+}
+
+/// `out = op(lhs, rhs)` with scalar `op`, for the operations Highway does not provide.
+template <typename Scalar, typename LHS, typename RHS, typename Op>
+HWY_INLINE void BinaryScalarLoop(LHS lhs, RHS rhs, Scalar *out, std::size_t size, Op const &op) {
+    for (std::size_t i = 0; i < size; ++i)
+        out[i] = op(FetchScalar(lhs, i), FetchScalar(rhs, i));
+}
+
+/// `out = op(in)`, where `op` works on vectors.
+template <typename Scalar, typename Op>
+HWY_INLINE void UnaryLoop(Scalar const *in, Scalar *out, std::size_t size, Op const &op) {
+    StripMining<Scalar>(size, [&](auto tag, std::size_t i, auto lanes) HWY_ATTR {
+        auto const v = LoadLanes(tag, in + i, lanes);
+        StoreLanes(op(v), tag, out + i, lanes);
+    });
+}
+
+/// `out = op(in)` with scalar `op`, for the operations Highway does not provide.
+template <typename Scalar, typename Op>
+HWY_INLINE void UnaryScalarLoop(Scalar const *in, Scalar *out, std::size_t size, Op const &op) {
+    for (std::size_t i = 0; i < size; ++i)
+        out[i] = op(in[i]);
+}
+
+/// `acc + a * b`, which is fused for the floating-point scalars.
+template <class V> HWY_INLINE V MulAccumulate(V a, V b, V acc) {
+    if constexpr (hwy::IsFloat<hn::TFromV<V>>())
+        return hn::MulAdd(a, b, acc);
+    else
+        return hn::Add(acc, hn::Mul(a, b));
+}
+
+/// `sum + x`, where the rounding error is accumulated into `comp`, see \c detail::two_sum.
+template <class V> HWY_INLINE V TwoSum(V sum, V x, V &comp) {
+    auto const t = hn::Add(sum, x);
+    auto const z = hn::Sub(t, sum);
+    comp = hn::Add(comp, hn::Add(hn::Sub(sum, hn::Sub(t, z)), hn::Sub(x, z)));
+    return t;
+}
+
+//! NOTE(krr): The accumulators are spelled out instead of being an array, since the vectors of
+//! the scalable targets (SVE, RVV) are sizeless and cannot be stored in arrays.
+
+/// Reduce `[0, size)` with \c detail::Summation::Accumulators.
+///
+/// \param accumulate A callable `(acc, tag, i, lanes)` returning `acc` plus the terms of the
+/// elements starting at `i`, see \c StripMining for `lanes`. The terms of the lanes past the
+/// remainder must be zero, which holds for the terms computed from \c LoadLanes.
+template <typename Scalar, typename Accumulate>
+HWY_INLINE Scalar ReduceLoop(std::size_t size, Accumulate const &accumulate) {
+    static_assert(detail::ReduceAccumulators == 4);
+
+    auto const tag = hn::ScalableTag<Scalar>();
+    auto const lanes = hn::Lanes(tag);
+    auto acc0 = hn::Zero(tag), acc1 = hn::Zero(tag), acc2 = hn::Zero(tag), acc3 = hn::Zero(tag);
+
+    std::size_t i = 0;
+    for (; i + 4 * lanes <= size; i += 4 * lanes) {
+        acc0 = accumulate(acc0, tag, i, FullVector{});
+        acc1 = accumulate(acc1, tag, i + lanes, FullVector{});
+        acc2 = accumulate(acc2, tag, i + 2 * lanes, FullVector{});
+        acc3 = accumulate(acc3, tag, i + 3 * lanes, FullVector{});
+    }
+
+    for (; i + lanes <= size; i += lanes)
+        acc0 = accumulate(acc0, tag, i, FullVector{});
+    if (i < size)
+        acc0 = accumulate(acc0, tag, i, size - i);
+
+    return hn::ReduceSum(tag, hn::Add(hn::Add(acc0, acc1), hn::Add(acc2, acc3)));
+}
+
+/// Sum `[0, size)` with \c detail::Summation::Compensated.
+///
+/// \param term A callable `(tag, i, lanes)` returning the terms of the elements starting at `i`,
+/// with the same requirements as the ones of \c ReduceLoop.
+template <typename Scalar, typename Term>
+HWY_INLINE Scalar CompensatedReduceLoop(std::size_t size, Term const &term) {
+    static_assert(detail::ReduceAccumulators == 4);
+
+    auto const tag = hn::ScalableTag<Scalar>();
+    auto const lanes = hn::Lanes(tag);
+    auto sum0 = hn::Zero(tag), sum1 = hn::Zero(tag), sum2 = hn::Zero(tag), sum3 = hn::Zero(tag);
+    auto comp0 = hn::Zero(tag), comp1 = hn::Zero(tag), comp2 = hn::Zero(tag),
+         comp3 = hn::Zero(tag);
+
+    std::size_t i = 0;
+    for (; i + 4 * lanes <= size; i += 4 * lanes) {
+        sum0 = TwoSum(sum0, term(tag, i, FullVector{}), comp0);
+        sum1 = TwoSum(sum1, term(tag, i + lanes, FullVector{}), comp1);
+        sum2 = TwoSum(sum2, term(tag, i + 2 * lanes, FullVector{}), comp2);
+        sum3 = TwoSum(sum3, term(tag, i + 3 * lanes, FullVector{}), comp3);
+    }
+
+    for (; i + lanes <= size; i += lanes)
+        sum0 = TwoSum(sum0, term(tag, i, FullVector{}), comp0);
+    if (i < size)
+        sum0 = TwoSum(sum0, term(tag, i, size - i), comp0);
+
+    auto comp = hn::Add(hn::Add(comp0, comp1), hn::Add(comp2, comp3));
+    auto const lhs = TwoSum(sum0, sum1, comp);
+    auto const rhs = TwoSum(sum2, sum3, comp);
+    auto const sum = TwoSum(lhs, rhs, comp);
+
+    // The lanes are few, sum them one by one s.t. their errors are compensated as well.
+    HWY_ALIGN Scalar sums[hn::MaxLanes(tag)];
+    HWY_ALIGN Scalar comps[hn::MaxLanes(tag)];
+    hn::Store(sum, tag, sums);
+    hn::Store(comp, tag, comps);
+
+    Scalar result{}, error{};
+    for (std::size_t k = 0; k < lanes; ++k) {
+        result = detail::two_sum<Scalar>(result, sums[k], error);
+        error += comps[k];
+    }
+    return result + error;
+}
+
+template <typename Scalar, typename LHS, typename RHS>
+HWY_NOINLINE void
+BinaryKernelImpl(detail::BinaryKernelOp op, LHS lhs, RHS rhs, Scalar *out, std::size_t size) {
+    using detail::BinaryKernelOp;
+
+    switch (op) {
+    case BinaryKernelOp::Add:
+        return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+            return hn::Add(a, b);
+        });
+    case BinaryKernelOp::Sub:
+        return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+            return hn::Sub(a, b);
+        });
+    case BinaryKernelOp::Mul:
+        return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+            return hn::Mul(a, b);
+        });
+    case BinaryKernelOp::Div:
+        if constexpr (hwy::IsFloat<Scalar>())
+            return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return hn::Div(a, b);
+            });
+        else
+            // Integer division is not vectorized by Highway.
+            return BinaryScalarLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return a / b;
+            });
+    case BinaryKernelOp::Min:
+        return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+            return hn::Min(a, b);
+        });
+    case BinaryKernelOp::Max:
+        return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+            return hn::Max(a, b);
+        });
+    case BinaryKernelOp::Atan2:
+        if constexpr (hwy::IsFloat<Scalar>())
+            return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return hn::Atan2(hn::DFromV<decltype(a)>(), a, b);
+            });
+        else
+            return BinaryScalarLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return Scalar(std::atan2(a, b));
+            });
+    case BinaryKernelOp::Pow:
+        if constexpr (hwy::IsFloat<Scalar>())
+            return BinaryLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return Pow(a, b);
+            });
+        else
+            return BinaryScalarLoop(lhs, rhs, out, size, [](auto a, auto b) HWY_ATTR {
+                return Scalar(std::pow(a, b));
+            });
+    }
+}
+
+#define KIRA_HIGHWAY_MATH_CASE(op)                                                                 \
+    case UnaryKernelOp::op:                                                                        \
+        return UnaryLoop(in, out, size, [](auto v) HWY_ATTR {                                      \
+            return hn::op(hn::DFromV<decltype(v)>(), v);                                           \
+        });
+#define KIRA_SCALAR_MATH_CASE(op, func)                                                            \
+    case UnaryKernelOp::op:                                                                        \
+        return UnaryScalarLoop(in, out, size, [](auto v) HWY_ATTR { return Scalar(func(v)); });
+
+template <typename Scalar>
+HWY_NOINLINE void
+UnaryKernelImpl(detail::UnaryKernelOp op, Scalar const *in, Scalar *out, std::size_t size) {
+    using detail::UnaryKernelOp;
+
+    switch (op) {
+    case UnaryKernelOp::Neg:
+        return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Neg(v); });
+    case UnaryKernelOp::Sqr:
+        return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Mul(v, v); });
+    case UnaryKernelOp::Abs:
+        return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Abs(v); });
+    default: break;
+    }
+
+    // The rest are only meaningful for floating-point scalars, keep the semantic of the generic
+    // backend for the others.
+    if constexpr (hwy::IsFloat<Scalar>()) {
+        switch (op) {
+        case UnaryKernelOp::Sqrt:
+            return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Sqrt(v); });
+        case UnaryKernelOp::RSqrt:
+            return UnaryLoop(in, out, size, [](auto v) HWY_ATTR {
+                return hn::Div(hn::Set(hn::DFromV<decltype(v)>(), Scalar(1)), hn::Sqrt(v));
+            });
+        case UnaryKernelOp::Floor:
+            return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Floor(v); });
+        case UnaryKernelOp::Ceil:
+            return UnaryLoop(in, out, size, [](auto v) HWY_ATTR { return hn::Ceil(v); });
+        KIRA_HIGHWAY_MATH_CASE(Exp)
+        KIRA_HIGHWAY_MATH_CASE(Log)
+        KIRA_HIGHWAY_MATH_CASE(Sin)
+        KIRA_HIGHWAY_MATH_CASE(Cos)
+        KIRA_HIGHWAY_MATH_CASE(Asin)
+        KIRA_HIGHWAY_MATH_CASE(Acos)
+        KIRA_HIGHWAY_MATH_CASE(Atan)
+        default: break;
+        }
+    } else {
+        switch (op) {
+        case UnaryKernelOp::Sqrt:
+            return UnaryScalarLoop(in, out, size, [](auto v) HWY_ATTR {
+                return Scalar(std::sqrt(v));
+            });
+        case UnaryKernelOp::RSqrt:
+            return UnaryScalarLoop(in, out, size, [](auto v) HWY_ATTR {
+                return Scalar(1 / std::sqrt(v));
+            });
+        case UnaryKernelOp::Floor:
+        case UnaryKernelOp::Ceil:
+            if (in != out)
+                std::copy_n(in, size, out);
+            return;
+        KIRA_SCALAR_MATH_CASE(Exp, std::exp)
+        KIRA_SCALAR_MATH_CASE(Log, std::log)
+        KIRA_SCALAR_MATH_CASE(Sin, std::sin)
+        KIRA_SCALAR_MATH_CASE(Cos, std::cos)
+        KIRA_SCALAR_MATH_CASE(Asin, std::asin)
+        KIRA_SCALAR_MATH_CASE(Acos, std::acos)
+        KIRA_SCALAR_MATH_CASE(Atan, std::atan)
+        default: break;
+        }
+    }
+}
+#undef KIRA_HIGHWAY_MATH_CASE
+#undef KIRA_SCALAR_MATH_CASE
+
+template <typename Scalar>
+HWY_NOINLINE Scalar ReduceKernelImpl(
+    detail::ReduceKernelOp op, detail::Summation summation, Scalar const *lhs, Scalar const *rhs,
+    std::size_t size
+) {
+    using detail::ReduceKernelOp;
+
+    // Integer sums are exact, there is nothing to compensate.
+    bool const compensated =
+        hwy::IsFloat<Scalar>() and summation == detail::Summation::Compensated;
+
+    auto const sum = [&](auto tag, std::size_t i, auto lanes) HWY_ATTR {
+        return LoadLanes(tag, lhs + i, lanes);
+    };
+    auto const product = [&](auto tag, std::size_t i, auto lanes) HWY_ATTR {
+        return hn::Mul(LoadLanes(tag, lhs + i, lanes), LoadLanes(tag, rhs + i, lanes));
+    };
+    auto const sqrDist = [&](auto tag, std::size_t i, auto lanes) HWY_ATTR {
+        auto const diff = hn::Sub(LoadLanes(tag, lhs + i, lanes), LoadLanes(tag, rhs + i, lanes));
+        return hn::Mul(diff, diff);
+    };
+
+    switch (op) {
+    case ReduceKernelOp::Sum:
+        if (compensated)
+            return CompensatedReduceLoop<Scalar>(size, sum);
+        return ReduceLoop<Scalar>(
+            size,
+            [&](auto acc, auto tag, std::size_t i, auto lanes) HWY_ATTR {
+                return hn::Add(acc, sum(tag, i, lanes));
+            }
+        );
+    case ReduceKernelOp::Dot:
+        if (compensated)
+            return CompensatedReduceLoop<Scalar>(size, product);
+        return ReduceLoop<Scalar>(
+            size,
+            [&](auto acc, auto tag, std::size_t i, auto lanes) HWY_ATTR {
+                auto const v1 = LoadLanes(tag, lhs + i, lanes);
+                auto const v2 = LoadLanes(tag, rhs + i, lanes);
+                return MulAccumulate(v1, v2, acc);
+            }
+        );
+    case ReduceKernelOp::SqrDist:
+        if (compensated)
+            return CompensatedReduceLoop<Scalar>(size, sqrDist);
+        return ReduceLoop<Scalar>(
+            size,
+            [&](auto acc, auto tag, std::size_t i, auto lanes) HWY_ATTR {
+                auto const v1 = LoadLanes(tag, lhs + i, lanes);
+                auto const v2 = LoadLanes(tag, rhs + i, lanes);
+                auto const diff = hn::Sub(v1, v2);
+                return MulAccumulate(diff, diff, acc);
+            }
+        );
+    }
+
+    return Scalar{};
+}
+} // namespace kira::vecteur::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#endif // KIRA_VECTEUR_SRC_HIGHWAY_INL_H_
@@ -0,0 +1,110 @@
+#include "kira/Vecteur/Highway.h"
+
+#include "kira/Vecteur/detail/Kernels.h"
+
+// Compile this file once for every target in `HWY_TARGETS`.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/Highway.cpp"
+#include <hwy/foreach_target.h> // IWYU pragma: keep
+
+#include <hwy/highway.h>
+
+#include "Highway-inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace kira::vecteur::HWY_NAMESPACE {
+/// The target this translation unit is compiled for, used to report the dispatched target.
+int64_t CurrentTarget() { return HWY_TARGET; }
+
+#define KIRA_KERNEL_INSTANTIATE(suffix, Scalar)                                                    \
+    void BinaryKernelVV##suffix(                                                                   \
+        detail::BinaryKernelOp op, Scalar const *lhs, Scalar const *rhs, Scalar *out,              \
+        std::size_t size                                                                           \
+    ) {                                                                                            \
+        BinaryKernelImpl(op, lhs, rhs, out, size);                                                 \
+    }                                                                                              \
+                                                                                                   \
+    void BinaryKernelVS##suffix(                                                                   \
+        detail::BinaryKernelOp op, Scalar const *lhs, Scalar rhs, Scalar *out, std::size_t size    \
+    ) {                                                                                            \
+        BinaryKernelImpl(op, lhs, rhs, out, size);                                                 \
+    }                                                                                              \
+                                                                                                   \
+    void BinaryKernelSV##suffix(                                                                   \
+        detail::BinaryKernelOp op, Scalar lhs, Scalar const *rhs, Scalar *out, std::size_t size    \
+    ) {                                                                                            \
+        BinaryKernelImpl(op, lhs, rhs, out, size);                                                 \
+    }                                                                                              \
+                                                                                                   \
+    void UnaryKernel##suffix(                                                                      \
+        detail::UnaryKernelOp op, Scalar const *in, Scalar *out, std::size_t size                  \
+    ) {                                                                                            \
+        UnaryKernelImpl(op, in, out, size);                                                        \
+    }                                                                                              \
+                                                                                                   \
+    Scalar ReduceKernel##suffix(                                                                   \
+        detail::ReduceKernelOp op, detail::Summation summation, Scalar const *lhs,                 \
+        Scalar const *rhs, std::size_t size                                                        \
+    ) {                                                                                            \
+        return ReduceKernelImpl(op, summation, lhs, rhs, size);                                    \
+    }
+
+KIRA_KERNEL_INSTANTIATE(F32, float)
+KIRA_KERNEL_INSTANTIATE(F64, double)
+KIRA_KERNEL_INSTANTIATE(I32, int32_t)
+KIRA_KERNEL_INSTANTIATE(I64, int64_t)
+#undef KIRA_KERNEL_INSTANTIATE
+} // namespace kira::vecteur::HWY_NAMESPACE
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace kira::vecteur {
+HWY_EXPORT(CurrentTarget);
+
+int64_t HighwayTarget() { return HWY_DYNAMIC_DISPATCH(CurrentTarget)(); }
+
+char const *HighwayTargetName() { return hwy::TargetName(HighwayTarget()); }
+
+#define KIRA_KERNEL_EXPORT(suffix, Scalar)                                                         \
+    HWY_EXPORT(BinaryKernelVV##suffix);                                                            \
+    HWY_EXPORT(BinaryKernelVS##suffix);                                                            \
+    HWY_EXPORT(BinaryKernelSV##suffix);                                                            \
+    HWY_EXPORT(UnaryKernel##suffix);                                                               \
+    HWY_EXPORT(ReduceKernel##suffix);                                                              \
+                                                                                                   \
+    void detail::BinaryKernel(                                                                     \
+        BinaryKernelOp op, Scalar const *lhs, Scalar const *rhs, Scalar *out, std::size_t size     \
+    ) {                                                                                            \
+        HWY_DYNAMIC_DISPATCH(BinaryKernelVV##suffix)(op, lhs, rhs, out, size);                     \
+    }                                                                                              \
+                                                                                                   \
+    void detail::BinaryKernel(                                                                     \
+        BinaryKernelOp op, Scalar const *lhs, Scalar rhs, Scalar *out, std::size_t size            \
+    ) {                                                                                            \
+        HWY_DYNAMIC_DISPATCH(BinaryKernelVS##suffix)(op, lhs, rhs, out, size);                     \
+    }                                                                                              \
+                                                                                                   \
+    void detail::BinaryKernel(                                                                     \
+        BinaryKernelOp op, Scalar lhs, Scalar const *rhs, Scalar *out, std::size_t size            \
+    ) {                                                                                            \
+        HWY_DYNAMIC_DISPATCH(BinaryKernelSV##suffix)(op, lhs, rhs, out, size);                     \
+    }                                                                                              \
+                                                                                                   \
+    void detail::UnaryKernel(UnaryKernelOp op, Scalar const *in, Scalar *out, std::size_t size) {  \
+        HWY_DYNAMIC_DISPATCH(UnaryKernel##suffix)(op, in, out, size);                              \
+    }                                                                                              \
+                                                                                                   \
+    Scalar detail::ReduceKernel(                                                                   \
+        ReduceKernelOp op, Summation summation, Scalar const *lhs, Scalar const *rhs,              \
+        std::size_t size                                                                           \
+    ) {                                                                                            \
+        return HWY_DYNAMIC_DISPATCH(ReduceKernel##suffix)(op, summation, lhs, rhs, size);          \
+    }
+
+KIRA_KERNEL_EXPORT(F32, float)
+KIRA_KERNEL_EXPORT(F64, double)
+KIRA_KERNEL_EXPORT(I32, int32_t)
+KIRA_KERNEL_EXPORT(I64, int64_t)
+#undef KIRA_KERNEL_EXPORT
+} // namespace kira::vecteur
+#endif
@@ -0,0 +1,21 @@
+#include "kira/Vecteur/Parallel.h"
+
+#include "kira/ThreadPool.h"
+
+namespace kira::vecteur {
+std::size_t ParallelConcurrency() { return ThreadPool::GetInstance().GetConcurrency(); }
+
+void detail::ParallelForImpl(
+    std::size_t count, void (*task)(void const *, std::size_t), void const *context
+) {
+    // A block per range, s.t. the idle threads steal the blocks one at a time.
+    kira::ParallelFor(
+        0, count,
+        [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i)
+                task(context, i);
+        },
+        1
+    );
+}
+} // namespace kira::vecteur
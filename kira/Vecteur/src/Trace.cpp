@@ -0,0 +1,310 @@
+#include "kira/Vecteur/Trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "kira/Vecteur/detail/Kernels.h"
+
+namespace kira::vecteur {
+namespace {
+//! NOTE(krr): The size of a register, i.e., the number of the elements an instruction processes at
+//! a time. A program rarely needs more than 8 registers, which then fit in the L1 cache, while the
+//! dispatch of a kernel is amortized over a few hundred elements.
+constexpr std::size_t ChunkBytes = 4096;
+
+thread_local TraceStats lastStats;
+
+template <typename Scalar> std::vector<detail::TraceNodePtr<Scalar>> &Scheduled() {
+    thread_local std::vector<detail::TraceNodePtr<Scalar>> scheduled;
+    return scheduled;
+}
+
+/// An instruction of the compiled program, which reads the registers of the earlier instructions.
+template <typename Scalar> struct Instruction {
+    detail::TraceOp op;
+    uint8_t kernel;
+    Scalar literal;
+    uint32_t lhs, rhs;             //< The operand instructions.
+    Scalar const *input;           //< The buffer of an `Input`.
+    std::size_t reg;               //< The scratch register, unless written to `outputs`.
+    std::vector<Scalar *> outputs; //< The buffers of the evaluated nodes merged into this.
+
+    /// The key of the common subexpression elimination.
+    [[nodiscard]] auto key() const {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &literal, sizeof(Scalar));
+        return std::tuple(op, kernel, bits, lhs, rhs, input);
+    }
+};
+
+template <typename Scalar> struct InstructionHash {
+    std::size_t operator()(auto const &key) const {
+        auto const [op, kernel, bits, lhs, rhs, input] = key;
+        std::size_t result = std::hash<uint64_t>{}(bits);
+        for (std::size_t const v :
+             {std::size_t(op), std::size_t(kernel), std::size_t(lhs), std::size_t(rhs),
+              std::hash<Scalar const *>{}(input)})
+            result ^= v + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+        return result;
+    }
+};
+
+/// The program evaluating the nodes of the same size.
+template <typename Scalar> class Program {
+    using Node = detail::TraceNode<Scalar>;
+
+    std::vector<Instruction<Scalar>> instructions;
+    std::size_t size;
+    std::size_t registers{};
+    std::size_t nodes{};
+
+public:
+    explicit Program(std::size_t size) : size(size) {}
+
+    /// Compile the graph reachable from `node`, whose result is written to `output`.
+    void Compile(Node *root, Scalar *output, auto &visited, auto &merged) {
+        // Post-order traversal without recursion, since the chains of the nodes might be long.
+        std::vector<std::pair<Node *, bool>> stack{{root, false}};
+        while (not stack.empty()) {
+            auto const [node, expanded] = stack.back();
+            stack.pop_back();
+            if (visited.contains(node))
+                continue;
+
+            bool const hasOperands =
+                node->op == detail::TraceOp::Unary or node->op == detail::TraceOp::Binary;
+            if (hasOperands and not expanded) {
+                stack.emplace_back(node, true);
+                if (node->rhs)
+                    stack.emplace_back(node->rhs.get(), false);
+                stack.emplace_back(node->lhs.get(), false);
+                continue;
+            }
+
+            Instruction<Scalar> instruction{
+                .op = node->op,
+                .kernel = node->kernel,
+                .literal = node->op == detail::TraceOp::Literal ? node->literal : Scalar{},
+                .lhs = node->lhs ? visited.at(node->lhs.get()) : 0,
+                .rhs = node->rhs ? visited.at(node->rhs.get()) : 0,
+                .input = node->op == detail::TraceOp::Input ? node->buffer.data() : nullptr,
+                .reg = 0,
+                .outputs = {},
+            };
+            nodes += hasOperands;
+
+            auto const [it, inserted] =
+                merged.try_emplace(instruction.key(), uint32_t(instructions.size()));
+            if (inserted)
+                instructions.push_back(std::move(instruction));
+            visited.emplace(node, it->second);
+        }
+
+        instructions[visited.at(root)].outputs.push_back(output);
+    }
+
+    /// Assign the scratch registers, which are reused once their last reader is done.
+    void Allocate() {
+        std::vector<std::size_t> lastUse(instructions.size(), 0);
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            auto const &instruction = instructions[i];
+            if (instruction.op == detail::TraceOp::Unary or
+                instruction.op == detail::TraceOp::Binary) {
+                lastUse[instruction.lhs] = i;
+                if (instruction.op == detail::TraceOp::Binary)
+                    lastUse[instruction.rhs] = i;
+            }
+        }
+
+        std::vector<std::size_t> free;
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            auto &instruction = instructions[i];
+            if (instruction.op != detail::TraceOp::Unary and
+                instruction.op != detail::TraceOp::Binary)
+                continue;
+
+            // The kernels allow the output to alias the operands, thus the registers of the
+            // operands read for the last time are released before the output is assigned.
+            auto const release = [&](uint32_t operand) {
+                auto const &source = instructions[operand];
+                bool const ownsRegister = (source.op == detail::TraceOp::Unary or
+                                           source.op == detail::TraceOp::Binary) and
+                                          source.outputs.empty();
+                if (ownsRegister and lastUse[operand] == i and
+                    std::find(free.begin(), free.end(), source.reg) == free.end())
+                    free.push_back(source.reg);
+            };
+            release(instruction.lhs);
+            if (instruction.op == detail::TraceOp::Binary)
+                release(instruction.rhs);
+
+            if (not instruction.outputs.empty())
+                continue;
+            if (free.empty()) {
+                instruction.reg = registers++;
+            } else {
+                instruction.reg = free.back();
+                free.pop_back();
+            }
+        }
+    }
+
+    /// Run the program over the chunks `[begin, end)`.
+    void Run(std::size_t begin, std::size_t end) const {
+        constexpr std::size_t chunk = ChunkBytes / sizeof(Scalar);
+        std::vector<Scalar> scratch(registers * chunk);
+        std::vector<Scalar const *> values(instructions.size());
+
+        for (std::size_t c = begin; c < end; ++c) {
+            auto const start = c * chunk, count = std::min(chunk, size - start);
+            for (std::size_t i = 0; i < instructions.size(); ++i) {
+                auto const &instruction = instructions[i];
+                Scalar *out = instruction.outputs.empty() ? scratch.data() + instruction.reg * chunk
+                                                          : instruction.outputs.front() + start;
+                switch (instruction.op) {
+                case detail::TraceOp::Input:
+                    values[i] = instruction.input + start;
+                    continue;
+                case detail::TraceOp::Literal:
+                    // Folded into the binary kernels with a scalar operand.
+                    continue;
+                case detail::TraceOp::Unary:
+                    detail::UnaryKernel(
+                        detail::UnaryKernelOp(instruction.kernel), values[instruction.lhs], out,
+                        count
+                    );
+                    break;
+                case detail::TraceOp::Binary: {
+                    auto const op = detail::BinaryKernelOp(instruction.kernel);
+                    auto const &lhs = instructions[instruction.lhs];
+                    auto const &rhs = instructions[instruction.rhs];
+                    if (lhs.op == detail::TraceOp::Literal)
+                        detail::BinaryKernel(op, lhs.literal, values[instruction.rhs], out, count);
+                    else if (rhs.op == detail::TraceOp::Literal)
+                        detail::BinaryKernel(op, values[instruction.lhs], rhs.literal, out, count);
+                    else
+                        detail::BinaryKernel(
+                            op, values[instruction.lhs], values[instruction.rhs], out, count
+                        );
+                    break;
+                }
+                }
+
+                values[i] = out;
+                for (std::size_t o = 1; o < instruction.outputs.size(); ++o)
+                    std::copy_n(out, count, instruction.outputs[o] + start);
+            }
+        }
+    }
+
+    /// Run the program over all the chunks, whose blocks are run on the pool past `par.threshold`.
+    void Run() {
+        constexpr std::size_t chunk = ChunkBytes / sizeof(Scalar);
+        constexpr std::size_t block = detail::ParallelBlock<Scalar> / chunk;
+        auto const chunks = (size + chunk - 1) / chunk;
+        auto const blocks = (chunks + block - 1) / block;
+        auto const threads =
+            size < par.threshold ? std::size_t{1} : std::min(ParallelConcurrency(), blocks);
+
+        lastStats.nodes += nodes;
+        lastStats.instructions += instructions.size();
+        lastStats.registers = std::max(lastStats.registers, registers);
+        lastStats.threads = std::max(lastStats.threads, threads);
+
+        if (threads == 1) {
+            Run(0, chunks);
+            return;
+        }
+
+        detail::ParallelFor(blocks, [&](std::size_t b) {
+            Run(b * block, std::min(chunks, (b + 1) * block));
+        });
+    }
+};
+
+/// \copydoc detail::TraceEval without resetting the statistics.
+template <typename Scalar> void Eval(std::span<detail::TraceNodePtr<Scalar> const> nodes) {
+    using detail::TraceNode;
+    using detail::TraceOp;
+
+    // Take the scheduled nodes, s.t. the evaluation below might schedule the others.
+    auto outputs = std::exchange(Scheduled<Scalar>(), {});
+    outputs.insert(outputs.end(), nodes.begin(), nodes.end());
+
+    // The programs are fused per size, since a loop runs over the elements of the same index.
+    std::map<std::size_t, std::vector<TraceNode<Scalar> *>> groups;
+    for (auto const &node : outputs) {
+        if (node->op == TraceOp::Input)
+            continue;
+        auto &group = groups[node->size];
+        if (std::find(group.begin(), group.end(), node.get()) == group.end())
+            group.push_back(node.get());
+    }
+
+    for (auto const &[size, group] : groups) {
+        std::vector<typename TraceNode<Scalar>::Leaf> buffers;
+        buffers.reserve(group.size());
+
+        Program<Scalar> program(size);
+        std::unordered_map<TraceNode<Scalar> *, uint32_t> visited;
+        std::unordered_map<
+            decltype(std::declval<Instruction<Scalar>>().key()), uint32_t, InstructionHash<Scalar>>
+            merged;
+        for (auto *node : group) {
+            auto &buffer = buffers.emplace_back(size);
+            if (node->op == TraceOp::Literal)
+                std::fill_n(buffer.data(), size, node->literal);
+            else
+                program.Compile(node, buffer.data(), visited, merged);
+        }
+        program.Allocate();
+        program.Run();
+
+        // The evaluated nodes become inputs, which releases the graph behind them.
+        for (std::size_t i = 0; i < group.size(); ++i) {
+            auto *node = group[i];
+            node->op = TraceOp::Input;
+            node->buffer = std::move(buffers[i]);
+            node->lhs.reset();
+            node->rhs.reset();
+        }
+    }
+}
+} // namespace
+
+namespace detail {
+template <typename Scalar> void TraceEval(std::span<TraceNodePtr<Scalar> const> nodes) {
+    lastStats = {};
+    Eval(nodes);
+}
+
+template <typename Scalar> void TraceSchedule(TraceNodePtr<Scalar> node) {
+    Scheduled<Scalar>().push_back(std::move(node));
+}
+
+#define KIRA_TRACE_INSTANTIATE(Scalar)                                                             \
+    template void TraceEval<Scalar>(std::span<TraceNodePtr<Scalar> const> nodes);                  \
+    template void TraceSchedule<Scalar>(TraceNodePtr<Scalar> node);
+
+KIRA_TRACE_INSTANTIATE(float)
+KIRA_TRACE_INSTANTIATE(double)
+KIRA_TRACE_INSTANTIATE(int32_t)
+KIRA_TRACE_INSTANTIATE(int64_t)
+#undef KIRA_TRACE_INSTANTIATE
+} // namespace detail
+
+void TraceEvalScheduled() {
+    lastStats = {};
+    Eval<float>({});
+    Eval<double>({});
+    Eval<int32_t>({});
+    Eval<int64_t>({});
+}
+
+TraceStats LastTraceStats() { return lastStats; }
+} // namespace kira::vecteur
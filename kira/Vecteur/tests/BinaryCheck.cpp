@@ -1,9 +0,0 @@
-#include <iostream>
-
-#include "kira/Vecteur.h"
-
-#include "ArithLib.h"
-
-using namespace kira;
-
-int main() {}
@@ -56,6 +56,143 @@ static_assert(is_safely_convertible<bool, float>);
 static_assert(!is_safely_convertible<int, bool>);
 static_assert(!is_safely_convertible<float, bool>);
 
+// The rewrite rules of `VecteurOptimizer`, which are checked on the types of the expressions.
+namespace optimizer {
+using vecteur::CwiseBinaryOp;
+using vecteur::CwiseTernaryOp;
+using vecteur::VecteurFastMathPolicy;
+using vecteur::VecteurOptimizer;
+using vecteur::VecteurReductionOptimizer;
+namespace detail = vecteur::detail;
+
+using LazyVec3f = Vecteur<float, 3, VecteurBackend::Lazy>;
+using LazyVecXd = Vecteur<double, std::dynamic_extent, VecteurBackend::Lazy>;
+using LazyVec3i = Vecteur<int, 3, VecteurBackend::Lazy>;
+
+// Only used in the unevaluated contexts.
+LazyVec3f const &a();
+LazyVec3f const &b();
+LazyVec3f const &c();
+LazyVec3f const &d();
+LazyVecXd const &ad();
+LazyVecXd const &bd();
+LazyVecXd const &cd();
+LazyVec3i const &ai();
+LazyVec3i const &bi();
+LazyVec3i const &ci();
+
+template <typename T> using op_t = typename std::decay_t<T>::Op;
+
+/// The expression rewritten with the fast-math policy, which fuses the multiply-add.
+template <typename T>
+using fused_t = typename VecteurOptimizer<std::decay_t<T>, VecteurFastMathPolicy>::type;
+template <typename T> using fused_op_t = op_t<fused_t<T>>;
+
+// a * b + c -> fma(a, b, c), for all the scalar types.
+static_assert(std::is_same_v<
+              fused_t<decltype(a() * b() + c())>,
+              CwiseTernaryOp<detail::TernaryOpMulAdd<float>, LazyVec3f, LazyVec3f, LazyVec3f>>);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(ad() * bd() + cd())>, detail::TernaryOpMulAdd<double>>
+);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(ai() * bi() + ci())>, detail::TernaryOpMulAdd<int>>
+);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(a() * 2.0F + 1.0F)>, detail::TernaryOpMulAdd<float>>
+);
+
+// Only with the policy, and only for the products of the type of the sum.
+static_assert(std::is_same_v<
+              VecteurOptimizer<std::decay_t<decltype(a() * b() + c())>>::type,
+              std::decay_t<decltype(a() * b() + c())>> or KIRA_VECTEUR_FUSE_MUL_ADD);
+static_assert(std::is_same_v<
+              fused_t<decltype(ai() * bi() + 0.5F)>, std::decay_t<decltype(ai() * bi() + 0.5F)>>);
+
+// c + a * b -> fma(a, b, c)
+static_assert(std::is_same_v<
+              fused_t<decltype(c() + a() * b())>,
+              CwiseTernaryOp<detail::TernaryOpMulAdd<float>, LazyVec3f, LazyVec3f, LazyVec3f>>);
+
+// a * b - c -> fms(a, b, c), c - a * b -> fnma(a, b, c)
+static_assert(
+    std::is_same_v<fused_op_t<decltype(a() * b() - c())>, detail::TernaryOpMulSub<float>>
+);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(c() - a() * b())>, detail::TernaryOpNegMulAdd<float>>
+);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(cd() - ad() * bd())>, detail::TernaryOpNegMulAdd<double>>
+);
+
+// a * b + c * d -> fma(a, b, c * d), a * b - c * d -> fms(a, b, c * d)
+static_assert(std::is_same_v<
+              fused_t<decltype(a() * b() + c() * d())>,
+              CwiseTernaryOp<
+                  detail::TernaryOpMulAdd<float>, LazyVec3f, LazyVec3f, decltype(c() * d())>>);
+static_assert(
+    std::is_same_v<fused_op_t<decltype(a() * b() - c() * d())>, detail::TernaryOpMulSub<float>>
+);
+
+// a * b + c * d + a * d -> fma(a, d, a * b + c * d)
+static_assert(std::is_same_v<
+              fused_t<decltype(a() * b() + c() * d() + a() * d())>,
+              CwiseTernaryOp<
+                  detail::TernaryOpMulAdd<float>, LazyVec3f, LazyVec3f,
+                  decltype(a() * b() + c() * d())>>);
+
+// (x * s0) * s1 -> x * (s0 * s1) and x / s -> x * (1 / s), only with the fast-math policy.
+using ScaledTwice = CwiseBinaryOp<detail::BinaryOpMul<float, float>, decltype(a() * 2.0F), float>;
+using ScaledTwiceLeft =
+    CwiseBinaryOp<detail::BinaryOpMul<float, float>, decltype(2.0F * a()), float>;
+using Divided = CwiseBinaryOp<detail::BinaryOpDiv<float, float>, LazyVec3f, float>;
+using Scaled = CwiseBinaryOp<detail::BinaryOpMul<float, float>, LazyVec3f, float>;
+static_assert(std::is_same_v<VecteurOptimizer<ScaledTwice, VecteurFastMathPolicy>::type, Scaled>);
+static_assert(std::is_same_v<
+              VecteurOptimizer<ScaledTwiceLeft, VecteurFastMathPolicy>::type, Scaled>);
+static_assert(std::is_same_v<VecteurOptimizer<Divided, VecteurFastMathPolicy>::type, Scaled>);
+static_assert(
+    std::is_same_v<VecteurOptimizer<ScaledTwice>::type, ScaledTwice> or KIRA_VECTEUR_FAST_MATH
+);
+static_assert(std::is_same_v<VecteurOptimizer<Divided>::type, Divided> or KIRA_VECTEUR_FAST_MATH);
+static_assert(std::is_same_v<
+              VecteurOptimizer<
+                  CwiseBinaryOp<detail::BinaryOpDiv<int, int>, LazyVec3i, int>,
+                  VecteurFastMathPolicy>::type,
+              CwiseBinaryOp<detail::BinaryOpDiv<int, int>, LazyVec3i, int>>);
+
+// hsum(a * b) -> dot(a, b), hsum(sqr(a)) -> dot(a, a), only for the floating-point scalars and
+// only when the products are allowed to be fused.
+template <typename T>
+constexpr bool reduction_rewritten = VecteurReductionOptimizer<T, VecteurFastMathPolicy>::rewritten;
+static_assert(reduction_rewritten<decltype(a() * b())>);
+static_assert(reduction_rewritten<decltype(ad() * bd())>);
+static_assert(reduction_rewritten<decltype(a().sqr())>);
+static_assert(not reduction_rewritten<decltype(ai() * bi())>);
+static_assert(not reduction_rewritten<decltype(a() + b())>);
+static_assert(
+    not VecteurReductionOptimizer<decltype(a() * b())>::rewritten or KIRA_VECTEUR_FUSE_MUL_ADD
+);
+static_assert(
+    not VecteurReductionOptimizer<decltype(a().sqr())>::rewritten or KIRA_VECTEUR_FUSE_MUL_ADD
+);
+} // namespace optimizer
+
+// The matrices are evaluated at compile time by the generic implementation.
+namespace matrix {
+constexpr Mat3d m(Vec3d(2, 0, 0), Vec3d(0, 3, 0), Vec3d(1, 0, 4));
+static_assert(m(0, 2) == 1 and m.transpose()(2, 0) == 1);
+static_assert(m * Mat3d::identity() == m and Mat3d::identity() * m == m);
+static_assert(m * Vec3d(1, 1, 1) == Vec3d(3, 3, 4));
+static_assert(m.determinant() == 24 and m.trace() == 9);
+static_assert(m * m.inverse() == Mat3d::identity());
+
+constexpr Mat4f t(Vec4f(1, 0, 0, 0), Vec4f(0, 1, 0, 0), Vec4f(0, 0, 1, 0), Vec4f(1, 2, 3, 1));
+static_assert(t.transform_point(Vec3f(1, 1, 1)) == Vec3f(2, 3, 4));
+static_assert(t.transform_vector(Vec3f(1, 1, 1)) == Vec3f(1, 1, 1));
+static_assert((t * t)(2, 3) == 6 and t.determinant() == 1);
+} // namespace matrix
+
 // NOTE(krr): great tests generated by Claude
 namespace {
 ut::suite vecteur = [] {
@@ -288,6 +425,17 @@ ut::suite vecteur = [] {
         expect((v2.hsum() == 10.0_f)(.01)) << "Sum should be close to 10.0";
     };
 
+    "hsum_compensated"_test = [] {
+        // The ones are absorbed by 1e8 in a float accumulator.
+        constexpr kira::Vecteur<float, 6> v1{1e8f, 1.0f, 1.0f, 1.0f, 1.0f, -1e8f};
+        static_assert(v1.hsum_compensated() == 4.0f);
+        expect(v1.hsum_compensated() == 4.0_f);
+
+        constexpr kira::Vecteur<float, 6> v2{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+        static_assert(v1.dot_compensated(v2) == 4.0f);
+        expect(v1.dot_compensated(v2) == 4.0_f);
+    };
+
     "hprod"_test = [] {
         kira::Vecteur<int, 3> v1{1, 2, 3};
         expect(v1.hprod() == 6_i);
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <random>
 #include <span>
+#include <thread>
 
 #include "kira/Vecteur.h"
 
@@ -125,7 +129,8 @@ TEST_F(VecteurDynamicTests, MoveConstruct) {
         Vecteur v1(10, 11);
         auto *ptr = v1.data();
         Vecteur v2(std::move(v1));
-        EXPECT_EQ(ptr, v2.data());
+        // The heap storage is stolen, while the inline elements are copied.
+        EXPECT_EQ(ptr == v2.data(), not v2.is_inline());
         EXPECT_EQ(v2.size(), 10);
         for (auto i = 0; i < 10; ++i)
             EXPECT_EQ(v2[i], 11);
@@ -246,7 +251,8 @@ TEST_F(VecteurDynamicTests, AssignmentFromStatic) {
     auto *ptr = v2.data();
     v2 = v1;
     auto *ptr2 = v2.data();
-    EXPECT_NE(ptr, ptr2);
+    // Reallocated only if the size exceeds the inline capacity.
+    EXPECT_EQ(ptr != ptr2, not v2.is_inline());
     EXPECT_EQ(v2.size(), 3);
     for (auto i = 0; i < 3; ++i)
         EXPECT_EQ(v2[i], v1[i]);
@@ -290,7 +296,7 @@ TEST_F(VecteurDynamicTests, AssignemtFromDynamicLessSize) {
     auto *ptr = v1.data();
     v1 = v2;
     auto *ptr2 = v1.data();
-    EXPECT_NE(ptr, ptr2);
+    EXPECT_EQ(ptr != ptr2, not v1.is_inline());
     EXPECT_EQ(v1.size(), 2);
     for (auto i = 0; i < 2; ++i)
         EXPECT_EQ(v1[i], v2[i]);
@@ -313,7 +319,7 @@ TEST_F(VecteurDynamicTests, AssignmentFromDynamicMoreSize) {
     auto *ptr = v1.data();
     v1 = v2;
     auto *ptr2 = v1.data();
-    EXPECT_NE(ptr, ptr2);
+    EXPECT_EQ(ptr != ptr2, not v1.is_inline());
     EXPECT_EQ(v1.size(), 3);
     for (auto i = 0; i < 3; ++i)
         EXPECT_EQ(v1[i], v2[i]);
@@ -357,7 +363,7 @@ TEST_F(VecteurDynamicTests, MoveAssignmentFromDynamic) {
     auto *ptr = v2.data();
     v1 = std::move(v2);
     auto *ptr2 = v1.data();
-    EXPECT_EQ(ptr, ptr2);
+    EXPECT_EQ(ptr == ptr2, not v1.is_inline());
     EXPECT_EQ(v1.size(), 3);
     for (auto i = 0; i < 3; ++i)
         EXPECT_EQ(v1[i], 13 + i);
@@ -369,12 +375,144 @@ TEST_F(VecteurDynamicTests, MoveAssignmentFromDynamicDifferentSize) {
     auto *ptr = v2.data();
     v1 = std::move(v2);
     auto *ptr2 = v1.data();
-    EXPECT_EQ(ptr, ptr2);
+    EXPECT_EQ(ptr == ptr2, not v1.is_inline());
     EXPECT_EQ(v1.size(), 2);
     for (auto i = 0; i < 2; ++i)
         EXPECT_EQ(v1[i], 13 + i);
 }
 
+TEST_F(VecteurDynamicTests, InlineStorage) {
+    constexpr std::size_t capacity = KIRA_VECTEUR_INLINE_CAPACITY;
+    InstantiateDynamicTests<int>([&]<typename Vecteur>() {
+        Vecteur small(capacity, 1), large(capacity + 1, 2);
+        EXPECT_TRUE(small.is_inline());
+        EXPECT_FALSE(large.is_inline());
+
+        // (6) the heap storage is stolen.
+        auto *ptr = large.data();
+        Vecteur moved(std::move(large));
+        EXPECT_EQ(moved.data(), ptr);
+        EXPECT_EQ(large.size(), 0);
+
+        // (4) spill to the heap and back.
+        Vecteur v1 = small;
+        EXPECT_TRUE(v1.is_inline());
+        v1 = moved;
+        EXPECT_FALSE(v1.is_inline());
+        EXPECT_NE(v1.data(), moved.data());
+        v1 = small;
+        EXPECT_TRUE(v1.is_inline());
+        for (std::size_t i = 0; i < capacity; ++i)
+            EXPECT_EQ(v1[i], 1);
+
+        // (6) the inline elements are copied.
+        v1 = std::move(moved);
+        EXPECT_EQ(v1.data(), ptr);
+        v1 = std::move(small);
+        EXPECT_TRUE(v1.is_inline());
+        EXPECT_EQ(v1.size(), capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+            EXPECT_EQ(v1[i], 1);
+    });
+
+    // No inline elements, i.e., always allocate on the heap.
+    using HeapStorage = vecteur::VecteurStorage<float, std::dynamic_extent, alignof(float), 0>;
+    static_assert(sizeof(HeapStorage) == sizeof(float *) + sizeof(std::size_t));
+    HeapStorage v1(3), v2(v1);
+    EXPECT_FALSE(v1.is_inline());
+    EXPECT_NE(v1.data(), v2.data());
+}
+
+TEST_F(VecteurDynamicTests, ArenaAllocation) {
+    using vecteur::VecteurArena;
+    using vecteur::VecteurArenaScope;
+
+    auto &arena = VecteurArena::local();
+    arena.reset();
+
+    InstantiateDynamicTests<float>([&]<typename Vecteur>() {
+        using Scalar = typename Vecteur::Scalar;
+        auto const v1 = RandDynamicVecteur<Vecteur>(rtsize);
+        EXPECT_FALSE(arena.owns(v1.data()));
+
+        {
+            VecteurArenaScope const scope;
+            Vecteur v2 = v1 + v1;
+            EXPECT_TRUE(arena.owns(v2.data()));
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v2.data()) % alignof(Scalar), 0);
+            for (std::size_t i = 0; i < rtsize; ++i)
+                EXPECT_EQ(v2[i], v1[i] + v1[i]);
+
+            // Nested scopes, and realloc within the arena.
+            VecteurArenaScope const nested;
+            auto const used = arena.used();
+            v2 = Vecteur(rtsize * 2, 1);
+            EXPECT_TRUE(arena.owns(v2.data()));
+            EXPECT_GT(arena.used(), used);
+            for (std::size_t i = 0; i < rtsize * 2; ++i)
+                EXPECT_EQ(v2[i], 1);
+        }
+
+        // Not owned by the arena after the scope.
+        Vecteur const v3 = v1 * 2;
+        EXPECT_FALSE(arena.owns(v3.data()));
+    });
+
+    EXPECT_GT(arena.used(), 0);
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0);
+
+    // Larger than a block, and the blocks are reused after `reset()`.
+    VecteurArena local(256);
+    auto *p1 = local.allocate(1024, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p1) % 64, 0);
+    auto *p2 = local.allocate(8, 8);
+    EXPECT_TRUE(local.owns(p1) and local.owns(p2));
+    local.reset();
+    EXPECT_EQ(local.allocate(1024, 64), p1);
+    local.release();
+    EXPECT_EQ(local.capacity(), 0);
+}
+
+TEST_F(VecteurDynamicTests, ArenaLifetime) {
+    using vecteur::VecteurArena;
+    using vecteur::VecteurArenaScope;
+
+    // Larger than the inline storage, and than a block of the arena of the test.
+    constexpr std::size_t size = 4096;
+    auto &arena = VecteurArena::local();
+    std::unique_ptr<VecXf> released, moved, kept, orphan;
+    {
+        VecteurArenaScope const scope;
+        released = std::make_unique<VecXf>(size, 1.0F);
+        moved = std::make_unique<VecXf>(size, 2.0F);
+        kept = std::make_unique<VecXf>(size, 3.0F);
+        EXPECT_TRUE(arena.owns(kept->data()));
+
+        // Not reused by the allocations after `reset()`.
+        arena.reset();
+        EXPECT_FALSE(arena.owns(kept->data()));
+        VecXf const other(size, 4.0F);
+        EXPECT_EQ((*kept)[size - 1], 3.0F);
+    }
+
+    // Outliving `release()`, and destroyed by another thread.
+    arena.release();
+    EXPECT_EQ(arena.capacity(), 0);
+    EXPECT_EQ((*released)[size - 1], 1.0F);
+    released.reset();
+    std::thread([&] { moved.reset(); }).join();
+    kept.reset();
+
+    // Outliving the arena and the thread allocating it.
+    std::thread([&] {
+        VecteurArenaScope const scope;
+        orphan = std::make_unique<VecXf>(size, 5.0F);
+    }).join();
+    EXPECT_EQ((*orphan)[0], 5.0F);
+    orphan.reset();
+}
+
 TEST_F(VecteurDynamicTests, DontConstructStaticFromDynamic) {
     static_assert(
         !std::is_constructible_v<
@@ -441,6 +579,302 @@ TEST_F(VecteurDynamicTests, Division) {
     });
 }
 
+TEST_F(VecteurDynamicTests, HighwayKernels) {
+    EXPECT_NE(std::string_view{HighwayTargetName()}, "");
+
+    // An odd size to cover the remainder of the strip-mined loops.
+    constexpr std::size_t size = rtsize + 5;
+    InstantiateDynamicTests<float>([&]<typename Vecteur>() {
+        auto v1 = RandDynamicVecteur<Vecteur>(size);
+        auto v2 = RandDynamicVecteur<Vecteur>(size);
+
+        Vecteur v3 = v1 + v2;
+        ASSERT_EQ(v3.size(), size);
+        for (std::size_t i = 0; i < size; ++i)
+            EXPECT_FLOAT_EQ(v3[i], v1[i] + v2[i]);
+
+        Vecteur v4 = v1.sqrt();
+        for (std::size_t i = 0; i < size; ++i)
+            EXPECT_FLOAT_EQ(v4[i], std::sqrt(v1[i]));
+
+        Vecteur v5 = v1.rsqrt();
+        for (std::size_t i = 0; i < size; ++i)
+            EXPECT_FLOAT_EQ(v5[i], 1 / std::sqrt(v1[i]));
+    });
+}
+
+TEST_F(VecteurDynamicTests, HighwayKernelsOperators) {
+    constexpr std::size_t size = rtsize + 5;
+    InstantiateDynamicTests<double>([&]<typename Vecteur>() {
+        auto v1 = RandDynamicVecteur<Vecteur>(size);
+        Vecteur v2 = RandDynamicVecteur<Vecteur>(size) + 1.0;
+
+        Vecteur sub = v1 - v2, mul = v1 * v2, div = v1 / v2;
+        Vecteur min = v1.min(v2), max = v1.max(v2);
+        Vecteur rsub = 2.0 - v1, rdiv = 2.0 / v2, smul = v1 * 2.0, smax = v1.max(50.0);
+        Vecteur neg = -v1, sqr = v1.sqr(), abs = (v1 - 50.0).abs(), floor = v1.floor();
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_DOUBLE_EQ(sub[i], v1[i] - v2[i]);
+            EXPECT_DOUBLE_EQ(mul[i], v1[i] * v2[i]);
+            EXPECT_DOUBLE_EQ(div[i], v1[i] / v2[i]);
+            EXPECT_DOUBLE_EQ(min[i], std::min(v1[i], v2[i]));
+            EXPECT_DOUBLE_EQ(max[i], std::max(v1[i], v2[i]));
+            EXPECT_DOUBLE_EQ(rsub[i], 2.0 - v1[i]);
+            EXPECT_DOUBLE_EQ(rdiv[i], 2.0 / v2[i]);
+            EXPECT_DOUBLE_EQ(smul[i], v1[i] * 2.0);
+            EXPECT_DOUBLE_EQ(smax[i], std::max(v1[i], 50.0));
+            EXPECT_DOUBLE_EQ(neg[i], -v1[i]);
+            EXPECT_DOUBLE_EQ(sqr[i], v1[i] * v1[i]);
+            EXPECT_DOUBLE_EQ(abs[i], std::abs(v1[i] - 50.0));
+            EXPECT_DOUBLE_EQ(floor[i], std::floor(v1[i]));
+        }
+    });
+
+    InstantiateDynamicTests<int>([&]<typename Vecteur>() {
+        auto v1 = RandDynamicVecteur<Vecteur>(size);
+        Vecteur v2 = RandDynamicVecteur<Vecteur>(size) + 1;
+
+        Vecteur div = v1 / v2, rsub = 7 - v1, abs = (v1 - 50).abs();
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(div[i], v1[i] / v2[i]);
+            EXPECT_EQ(rsub[i], 7 - v1[i]);
+            EXPECT_EQ(abs[i], std::abs(v1[i] - 50));
+        }
+    });
+}
+
+TEST_F(VecteurDynamicTests, Transcendentals) {
+    constexpr std::size_t size = rtsize + 5;
+    auto const checkUlp = [](auto result, auto expected) {
+        using Scalar = decltype(result);
+        auto const ulp =
+            std::numeric_limits<Scalar>::epsilon() * vecteur::detail::TranscendentalUlp;
+        EXPECT_NEAR(result, expected, ulp * std::max(std::abs(expected), Scalar(1)));
+    };
+
+    auto const check = [&]<typename Scalar>() {
+        InstantiateDynamicTests<Scalar>([&]<typename Vecteur>() {
+            Vecteur x(size), y(size), unit(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                x[i] = Scalar(i) * Scalar(0.25) + Scalar(0.125);
+                y[i] = Scalar(i % 7) - Scalar(3);
+                unit[i] = Scalar(2) * Scalar(i) / Scalar(size - 1) - Scalar(1);
+            }
+
+            Vecteur const exp = (-x).exp(), log = x.log(), sin = y.sin(), cos = y.cos();
+            Vecteur const asin = unit.asin(), acos = unit.acos(), atan = y.atan();
+            Vecteur const atan2 = y.atan2(unit), pow = x.pow(Scalar(1.5));
+            for (std::size_t i = 0; i < size; ++i) {
+                checkUlp(exp[i], std::exp(-x[i]));
+                checkUlp(log[i], std::log(x[i]));
+                checkUlp(sin[i], std::sin(y[i]));
+                checkUlp(cos[i], std::cos(y[i]));
+                checkUlp(asin[i], std::asin(unit[i]));
+                checkUlp(acos[i], std::acos(unit[i]));
+                checkUlp(atan[i], std::atan(y[i]));
+                checkUlp(atan2[i], std::atan2(y[i], unit[i]));
+                checkUlp(pow[i], std::pow(x[i], Scalar(1.5)));
+            }
+
+            // The special cases of `pow` follow `std::pow`.
+            Vecteur const bases = y.pow(y), squares = y.pow(Scalar(2)), roots = y.pow(Scalar(0.5));
+            for (std::size_t i = 0; i < size; ++i) {
+                checkUlp(bases[i], std::pow(y[i], y[i]));
+                checkUlp(squares[i], y[i] * y[i]);
+                if (y[i] < 0)
+                    EXPECT_TRUE(std::isnan(roots[i]));
+                else
+                    checkUlp(roots[i], std::sqrt(y[i]));
+            }
+
+            // The exact special cases, including the signed zeros, the infinities and the NaNs.
+            constexpr Scalar inf = std::numeric_limits<Scalar>::infinity();
+            constexpr Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+            constexpr Scalar specials[][2] = {
+                {1, nan},  {1, inf},  {-1, inf}, {-1, -inf}, {nan, 0},  {-0.0, -3},
+                {-0.0, 3}, {-0.0, -2}, {-0.0, 2}, {0, -3},    {0, 3},    {-2, Scalar(0.5)},
+            };
+            Vecteur sx(size), sy(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                sx[i] = specials[i % std::size(specials)][0];
+                sy[i] = specials[i % std::size(specials)][1];
+            }
+            Vecteur const special = sx.pow(sy);
+            for (std::size_t i = 0; i < size; ++i) {
+                auto const expected = std::pow(sx[i], sy[i]);
+                if (std::isnan(expected)) {
+                    EXPECT_TRUE(std::isnan(special[i])) << sx[i] << "^" << sy[i];
+                } else {
+                    EXPECT_EQ(special[i], expected) << sx[i] << "^" << sy[i];
+                    EXPECT_EQ(std::signbit(special[i]), std::signbit(expected));
+                }
+            }
+        });
+    };
+
+    check.template operator()<float>();
+    check.template operator()<double>();
+
+    // The lazy expressions stay fused, except for the multiply-adds fused on a target without the
+    // FMA instructions, which are evaluated element-wise.
+    using LazyVecteur = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+    LazyVecteur const a(size, 0.5F);
+    static_assert(
+        std::decay_t<decltype(a.sin() * a.cos() + a.pow(a).exp())>::packetable or
+        (KIRA_VECTEUR_FUSE_MUL_ADD and not vecteur::detail::is_packet_mul_add_fused)
+    );
+    static_assert(std::decay_t<decltype(a.atan2(2.0F).acos())>::packetable);
+
+    // The integers are evaluated element-wise with the semantic of the generic backend.
+    InstantiateDynamicTests<int>([&]<typename Vecteur>() {
+        Vecteur v(size, 3);
+        Vecteur const pow = v.pow(2), exp = v.exp();
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(pow[i], 9);
+            EXPECT_EQ(exp[i], static_cast<int>(std::exp(3)));
+        }
+    });
+}
+
+TEST_F(VecteurDynamicTests, LazyPacketEvaluation) {
+    using LazyVecteur = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+
+    constexpr std::size_t size = rtsize + 5;
+    auto a = RandDynamicVecteur<LazyVecteur>(size);
+    auto b = RandDynamicVecteur<LazyVecteur>(size);
+    auto c = RandDynamicVecteur<LazyVecteur>(size);
+
+    // A 10-op expression, which is fused into a single loop without the early evaluation.
+    auto const expr = ((a * b + c) / (a + 1.0F) - b.sqrt()).max(c * 0.5F).abs() * 2.0F - a;
+    static_assert(
+        std::decay_t<decltype(expr)>::packetable or
+        (KIRA_VECTEUR_FUSE_MUL_ADD and not vecteur::detail::is_packet_mul_add_fused)
+    );
+    static_assert(std::decay_t<decltype(expr)>::height > 4);
+
+    LazyVecteur result = expr;
+    ASSERT_EQ(result.size(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto const gt =
+            std::abs(std::max((a[i] * b[i] + c[i]) / (a[i] + 1.0F) - std::sqrt(b[i]), c[i] * 0.5F)
+            ) * 2.0F -
+            a[i];
+        EXPECT_NEAR(result[i], gt, 1e-4F * std::abs(gt) + 1e-4F);
+    }
+
+    // The last elements, which do not fill a packet, are evaluated by the same packets as the
+    // others, i.e., the same as when they are followed by more elements.
+    LazyVecteur padded(size + rtsize, 1.0F);
+    for (std::size_t i = 0; i < size; ++i)
+        padded[i] = a[i];
+    LazyVecteur const tail = (a.sin() * 0.5F).exp(), full = (padded.sin() * 0.5F).exp();
+    for (std::size_t i = 0; i < size; ++i)
+        EXPECT_EQ(tail[i], full[i]);
+    EXPECT_EQ((a.sin() * 0.5F).exp().hsum(), tail.hsum());
+
+    // Operations without packets fall back to the element-wise evaluation.
+    auto const roundExpr = (a * b).round() + c;
+    static_assert(not std::decay_t<decltype(roundExpr)>::packetable);
+    LazyVecteur rounded = roundExpr;
+    for (std::size_t i = 0; i < size; ++i)
+        EXPECT_FLOAT_EQ(rounded[i], std::round(a[i] * b[i]) + c[i]);
+}
+
+TEST_F(VecteurDynamicTests, LazyOptimizerRewrites) {
+    using LazyVecteur = Vecteur<double, std::dynamic_extent, VecteurBackend::Lazy>;
+
+    constexpr std::size_t size = rtsize + 5;
+    auto a = RandDynamicVecteur<LazyVecteur>(size);
+    auto b = RandDynamicVecteur<LazyVecteur>(size);
+    auto c = RandDynamicVecteur<LazyVecteur>(size);
+    auto d = RandDynamicVecteur<LazyVecteur>(size);
+
+    LazyVecteur fma = a * b + c, fms = a * b - c, fnma = c - a * b;
+    LazyVecteur chain = a * b + c * d + a * d, scaled = a * 2.0 * 0.5, divided = a / 4.0;
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_DOUBLE_EQ(fma[i], a[i] * b[i] + c[i]);
+        EXPECT_DOUBLE_EQ(fms[i], a[i] * b[i] - c[i]);
+        EXPECT_DOUBLE_EQ(fnma[i], c[i] - a[i] * b[i]);
+        EXPECT_DOUBLE_EQ(chain[i], a[i] * b[i] + c[i] * d[i] + a[i] * d[i]);
+        EXPECT_DOUBLE_EQ(scaled[i], a[i]);
+        EXPECT_DOUBLE_EQ(divided[i], a[i] / 4.0);
+    }
+
+    // With the policy, every element is rounded once, in the packets and the remainder alike. The
+    // floats are multiplied inexactly, unlike the doubles of the float values above.
+    using LazyVecXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+    auto af = RandDynamicVecteur<LazyVecXf>(size);
+    auto bf = RandDynamicVecteur<LazyVecXf>(size);
+    auto cf = RandDynamicVecteur<LazyVecXf>(size);
+    using Sum = std::decay_t<decltype(af * bf + cf)>;
+    using Difference = std::decay_t<decltype(cf - af * bf)>;
+    LazyVecXf fused =
+        vecteur::VecteurOptimizer<Sum, vecteur::VecteurFastMathPolicy>{af * bf + cf}();
+    LazyVecXf negFused =
+        vecteur::VecteurOptimizer<Difference, vecteur::VecteurFastMathPolicy>{cf - af * bf}();
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(fused[i], std::fma(af[i], bf[i], cf[i]));
+        EXPECT_EQ(negFused[i], std::fma(-af[i], bf[i], cf[i]));
+    }
+
+    double dot = 0, norm2 = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        dot += a[i] * b[i];
+        norm2 += a[i] * a[i];
+    }
+
+    EXPECT_NEAR((a * b).hsum(), dot, 1e-9 * dot);
+    EXPECT_NEAR(a.norm2(), norm2, 1e-9 * norm2);
+}
+
+TEST_F(VecteurDynamicTests, Reductions) {
+    // Cover the 4 accumulators, the remaining full blocks and the remainder.
+    constexpr std::size_t size = rtsize * 8 + 5;
+    InstantiateDynamicTests<double>([&]<typename Vecteur>() {
+        auto v1 = RandDynamicVecteur<Vecteur>(size);
+        auto v2 = RandDynamicVecteur<Vecteur>(size);
+
+        long double sum = 0, dot = 0, sqrDist = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            sum += v1[i];
+            dot += static_cast<long double>(v1[i]) * v2[i];
+            sqrDist += static_cast<long double>(v1[i] - v2[i]) * (v1[i] - v2[i]);
+        }
+
+        EXPECT_NEAR(v1.hsum(), sum, 1e-12 * sum);
+        EXPECT_NEAR(v1.hsum_compensated(), sum, 1e-12 * sum);
+        EXPECT_NEAR(v1.dot(v2), dot, 1e-12 * dot);
+        EXPECT_NEAR(v1.dot_compensated(v2), dot, 1e-12 * dot);
+        EXPECT_NEAR(v1.norm(), std::sqrt(v1.dot(v1)), 1e-12 * std::sqrt(dot));
+        EXPECT_TRUE(v1.near(v2, std::sqrt(sqrDist) * (1 + 1e-9)));
+        EXPECT_FALSE(v1.near(v2, std::sqrt(sqrDist) * (1 - 1e-9)));
+
+        // The summation order is deterministic.
+        EXPECT_EQ(v1.hsum(), v1.hsum());
+        EXPECT_EQ(v1.dot(v2), v1.dot(v2));
+    });
+
+    InstantiateDynamicTests<int>([&]<typename Vecteur>() {
+        auto v1 = RandDynamicVecteur<Vecteur>(size);
+        int sum = 0;
+        for (std::size_t i = 0; i < size; ++i)
+            sum += v1[i];
+        EXPECT_EQ(v1.hsum(), sum);
+        EXPECT_EQ(v1.hsum_compensated(), sum);
+    });
+
+    // The ones are absorbed by 1e8 in a float accumulator, but not by the compensated sum.
+    InstantiateDynamicTests<float>([&]<typename Vecteur>() {
+        Vecteur v1(size), ones(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v1[i] = ones[i] = 1.0F;
+        v1[0] = 1e8F;
+        v1[size - 1] = -1e8F;
+        EXPECT_EQ(v1.hsum_compensated(), static_cast<float>(size - 2));
+        EXPECT_EQ(v1.dot_compensated(ones), static_cast<float>(size - 2));
+    });
+}
+
 // This is an exception that clang-16 cannot compile.
 #if (defined(__clang__) and (__clang_major__ >= 18)) or (defined(__GNUC__) and (__GNUC__ >= 11))
 TEST_F(VecteurDynamicTests, FresnelConductor) {
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/Gather.h"
+
+using namespace kira;
+
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+class VecteurGatherTests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    // Not a multiple of the lanes, s.t. the remainder is covered.
+    static constexpr std::size_t nelems{37};
+
+    template <typename Scalar> [[nodiscard]] static LazyX<Scalar> RandVecteur(std::size_t size) {
+        std::mt19937 gen(size);
+        std::uniform_real_distribution<double> valDis(-100.0, 100.0);
+
+        LazyX<Scalar> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = static_cast<Scalar>(valDis(gen));
+        return result;
+    }
+
+    /// Random indices in `[0, bound)`, which repeat.
+    template <typename Index>
+    [[nodiscard]] static std::vector<Index> RandIndices(std::size_t size, std::size_t bound) {
+        std::mt19937 gen(size + bound);
+        std::uniform_int_distribution<std::size_t> idxDis(0, bound - 1);
+
+        std::vector<Index> result(size);
+        for (auto &index : result)
+            index = static_cast<Index>(idxDis(gen));
+        return result;
+    }
+
+    /// A random permutation of `[0, size)`, i.e., no index repeats.
+    template <typename Index>
+    [[nodiscard]] static std::vector<Index> RandPermutation(std::size_t size) {
+        std::vector<Index> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = static_cast<Index>(i);
+        std::shuffle(result.begin(), result.end(), std::mt19937(size));
+        return result;
+    }
+};
+
+TEST_F(VecteurGatherTests, Gather) {
+    auto const checkGather = [&]<typename Scalar, typename Index>() {
+        auto const source = RandVecteur<Scalar>(nelems);
+        auto const indices = RandIndices<Index>(2 * nelems + 1, nelems);
+
+        LazyX<Scalar> const result = gather(source, indices);
+        ASSERT_EQ(result.size(), indices.size());
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            EXPECT_EQ(result[i], source[indices[i]]);
+
+        // Fused into the surrounding expression.
+        LazyX<Scalar> const fused = gather(source, indices) * Scalar(2) + Scalar(1);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            EXPECT_EQ(fused[i], source[indices[i]] * Scalar(2) + Scalar(1));
+        // The summation order might differ from the leaf in the last bits.
+        EXPECT_NEAR(
+            static_cast<double>(gather(source, indices).hsum()),
+            static_cast<double>(result.hsum()), 1e-3
+        );
+    };
+
+    checkGather.template operator()<float, int32_t>();
+    checkGather.template operator()<float, uint32_t>();
+    checkGather.template operator()<double, int32_t>();
+    checkGather.template operator()<double, int64_t>();
+    checkGather.template operator()<double, uint64_t>();
+    checkGather.template operator()<int32_t, int32_t>();
+    checkGather.template operator()<int64_t, uint32_t>();
+
+    // The indices of a different width are gathered element-wise.
+    static_assert(GatherOp<LazyX<float>, int32_t>::packetable);
+    static_assert(GatherOp<LazyX<double>, uint32_t>::packetable);
+    static_assert(not GatherOp<LazyX<float>, int16_t>::packetable);
+    checkGather.template operator()<float, int16_t>();
+}
+
+TEST_F(VecteurGatherTests, ScatterAdd) {
+    auto const checkScatter = [&]<typename Scalar, typename Index>() {
+        auto const values = RandVecteur<Scalar>(2 * nelems + 1);
+
+        // The indices repeat, thus the lanes of a packet might conflict.
+        auto const indices = RandIndices<Index>(values.size(), nelems);
+        auto target = RandVecteur<Scalar>(nelems);
+        auto reference = target;
+        scatter(target, indices) += values * Scalar(2);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            reference[indices[i]] += values[i] * Scalar(2);
+        for (std::size_t i = 0; i < nelems; ++i)
+            EXPECT_EQ(target[i], reference[i]);
+
+        // No index repeats.
+        auto const permutation = RandPermutation<Index>(values.size());
+        auto permuted = RandVecteur<Scalar>(values.size());
+        auto permutedReference = permuted;
+        scatter(permuted, permutation).conflict_free() += values;
+        for (std::size_t i = 0; i < permutation.size(); ++i)
+            permutedReference[permutation[i]] += values[i];
+        for (std::size_t i = 0; i < values.size(); ++i)
+            EXPECT_EQ(permuted[i], permutedReference[i]);
+    };
+
+    checkScatter.template operator()<float, int32_t>();
+    checkScatter.template operator()<double, int32_t>();
+    checkScatter.template operator()<double, int64_t>();
+    checkScatter.template operator()<int32_t, uint32_t>();
+    checkScatter.template operator()<float, int16_t>();
+}
+
+TEST_F(VecteurGatherTests, MeshNormals) {
+    // A 5x5 grid of vertices with a random height, i.e., 32 triangles sharing the vertices.
+    constexpr int n = 5;
+    Eigen::MatrixX3f vertices(n * n, 3);
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> valDis(-0.5F, 0.5F);
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+            vertices.row(y * n + x) = Eigen::RowVector3f(x, y, valDis(gen));
+
+    // The corners of the faces, e.g., `i0[f]` is the first corner of the face `f`.
+    std::vector<int32_t> i0, i1, i2;
+    for (int y = 0; y + 1 < n; ++y) {
+        for (int x = 0; x + 1 < n; ++x) {
+            auto const v = y * n + x;
+            i0.insert(i0.end(), {v, v + 1});
+            i1.insert(i1.end(), {v + 1, v + n + 1});
+            i2.insert(i2.end(), {v + n + 1, v + n});
+        }
+    }
+
+    Vec3fSoA const points(vertices);
+    auto const p0 = gather(points, i0), p1 = gather(points, i1), p2 = gather(points, i2);
+    Vec3fSoA const faceNormals = (p1 - p0).cross(p2 - p0);
+    Vec3fSoA normals(points.size(), 0.0F);
+    scatter(normals, i0) += faceNormals;
+    scatter(normals, i1) += faceNormals;
+    scatter(normals, i2) += faceNormals;
+    normals = normals.normalize();
+
+    // The area-weighted vertex normals, computed by a scalar loop.
+    Eigen::MatrixX3f reference = Eigen::MatrixX3f::Zero(n * n, 3);
+    for (std::size_t f = 0; f < i0.size(); ++f) {
+        Eigen::Vector3f const a = vertices.row(i0[f]), b = vertices.row(i1[f]),
+                              c = vertices.row(i2[f]);
+        Eigen::RowVector3f const normal = (b - a).cross(c - a).transpose();
+        reference.row(i0[f]) += normal;
+        reference.row(i1[f]) += normal;
+        reference.row(i2[f]) += normal;
+    }
+    reference.rowwise().normalize();
+
+    EXPECT_TRUE(normals.to_eigen().isApprox(reference, 1e-5F));
+    for (std::size_t i = 0; i < normals.size(); ++i)
+        EXPECT_GT(normals.lane(2)[i], 0.0F);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+class VecteurMatrixTests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    template <typename Matrix> [[nodiscard]] static Matrix RandMatrix(unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> valDis(-1.0F, 1.0F);
+
+        Matrix result;
+        for (std::size_t j = 0; j < Matrix::cols(); ++j)
+            for (std::size_t i = 0; i < Matrix::rows(); ++i)
+                result(i, j) = valDis(gen);
+        return result;
+    }
+
+    /// The naive product, which the packets are checked against.
+    template <typename LHS, typename RHS>
+    [[nodiscard]] static auto ReferenceProduct(LHS const &lhs, RHS const &rhs) {
+        VecteurMatrix<std::decay_t<decltype(lhs(0, 0))>, LHS::rows(), RHS::cols()> result;
+        for (std::size_t j = 0; j < RHS::cols(); ++j) {
+            for (std::size_t i = 0; i < LHS::rows(); ++i) {
+                result(i, j) = 0;
+                for (std::size_t k = 0; k < LHS::cols(); ++k)
+                    result(i, j) += lhs(i, k) * rhs(k, j);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(VecteurMatrixTests, Construct) {
+    Mat3f const m(Vec3f(1, 2, 3), Vec3f(4, 5, 6), Vec3f(7, 8, 9));
+    EXPECT_EQ(m(0, 0), 1);
+    EXPECT_EQ(m(2, 0), 3);
+    EXPECT_EQ(m(0, 2), 7);
+    EXPECT_EQ(m.col(1)[2], 6);
+    EXPECT_EQ(m.row(1)[2], 8);
+    EXPECT_EQ(m.transpose()(0, 2), 3);
+
+    auto const identity = Mat4f::identity();
+    EXPECT_EQ(identity.trace(), 4);
+    EXPECT_EQ(identity * identity, identity);
+}
+
+TEST_F(VecteurMatrixTests, Product) {
+    auto const checkProduct = [&]<typename LHS, typename RHS>() {
+        auto const lhs = RandMatrix<LHS>(1), rhs = RandMatrix<RHS>(2);
+        auto const result = lhs * rhs, reference = ReferenceProduct(lhs, rhs);
+        for (std::size_t j = 0; j < RHS::cols(); ++j)
+            for (std::size_t i = 0; i < LHS::rows(); ++i)
+                EXPECT_NEAR(result(i, j), reference(i, j), 1e-6);
+    };
+
+    checkProduct.template operator()<Mat2f, Mat2f>();
+    checkProduct.template operator()<Mat3f, Mat3f>();
+    checkProduct.template operator()<Mat4f, Mat4f>();
+    checkProduct.template operator()<Mat4d, Mat4d>();
+    checkProduct.template operator()<VecteurMatrix<float, 3, 4>, VecteurMatrix<float, 4, 2>>();
+
+    auto const m = RandMatrix<Mat4f>(3);
+    Vec4f const v(1, 2, 3, 4);
+    auto const result = m * v;
+    for (std::size_t i = 0; i < 4; ++i)
+        EXPECT_NEAR(result[i], m(i, 0) + 2 * m(i, 1) + 3 * m(i, 2) + 4 * m(i, 3), 1e-6);
+
+    auto const m3 = RandMatrix<Mat3f>(4);
+    auto const result3 = m3 * Vec3f(1, 2, 3);
+    for (std::size_t i = 0; i < 3; ++i)
+        EXPECT_NEAR(result3[i], m3(i, 0) + 2 * m3(i, 1) + 3 * m3(i, 2), 1e-6);
+}
+
+TEST_F(VecteurMatrixTests, Transform) {
+    auto transform = Mat4f::identity();
+    transform(0, 3) = 1;
+    transform(1, 3) = 2;
+    transform(2, 3) = 3;
+    transform(0, 0) = 2;
+
+    auto const p = transform.transform_point(Vec3f(1, 1, 1));
+    EXPECT_FLOAT_EQ(p.x(), 3);
+    EXPECT_FLOAT_EQ(p.y(), 3);
+    EXPECT_FLOAT_EQ(p.z(), 4);
+
+    auto const v = transform.transform_vector(Vec3f(1, 1, 1));
+    EXPECT_FLOAT_EQ(v.x(), 2);
+    EXPECT_FLOAT_EQ(v.y(), 1);
+    EXPECT_FLOAT_EQ(v.z(), 1);
+}
+
+TEST_F(VecteurMatrixTests, Inverse) {
+    auto const checkInverse = [&]<typename Matrix>() {
+        // Diagonally dominant, thus well-conditioned.
+        auto const m = RandMatrix<Matrix>(5) + Matrix::diagonal(4);
+        auto const product = m * m.inverse();
+        for (std::size_t j = 0; j < Matrix::cols(); ++j)
+            for (std::size_t i = 0; i < Matrix::rows(); ++i)
+                EXPECT_NEAR(product(i, j), i == j ? 1 : 0, 1e-5);
+    };
+
+    checkInverse.template operator()<Mat2f>();
+    checkInverse.template operator()<Mat3f>();
+    checkInverse.template operator()<Mat4f>();
+    checkInverse.template operator()<Mat4d>();
+
+    Mat3d const m(Vec3d(2, 0, 0), Vec3d(0, 3, 0), Vec3d(1, 0, 4));
+    EXPECT_DOUBLE_EQ(m.determinant(), 24);
+    EXPECT_DOUBLE_EQ(Mat4d::diagonal(2).determinant(), 16);
+}
+
+TEST_F(VecteurMatrixTests, PolarDecomposition) {
+    auto const a = RandMatrix<Mat3d>(6) + Mat3d::diagonal(2);
+    auto const [rotation, stretch] = polar_decomposition(a);
+
+    // `rotation` is orthogonal and `stretch` is symmetric, with `a = rotation * stretch`.
+    auto const orthogonality = rotation.transpose() * rotation - Mat3d::identity();
+    EXPECT_LT(orthogonality.norm(), 1e-12);
+    EXPECT_LT((stretch - stretch.transpose()).norm(), 1e-12);
+    EXPECT_LT((rotation * stretch - a).norm(), 1e-12);
+    EXPECT_NEAR(rotation.determinant(), 1, 1e-12);
+
+    // Already a rotation.
+    Mat3f const r(Vec3f(0, 1, 0), Vec3f(-1, 0, 0), Vec3f(0, 0, 1));
+    auto const polar = polar_decomposition(r);
+    EXPECT_LT((polar.rotation - r).norm(), 1e-6F);
+    EXPECT_LT((polar.stretch - Mat3f::identity()).norm(), 1e-6F);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/Properties.h"
+
+using namespace kira;
+
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+class VecteurNarrowTests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    // Not a multiple of the packets.
+    static constexpr std::size_t nelems{1001};
+
+    [[nodiscard]] static LazyX<float> RandVecteur(std::size_t size, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> valDis(-2.0F, 2.0F);
+
+        LazyX<float> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = valDis(gen);
+        return result;
+    }
+};
+
+TEST_F(VecteurNarrowTests, Float16) {
+    auto const a = RandVecteur(nelems, 1), b = RandVecteur(nelems, 2);
+
+    // The 11-bit significand is rounded to the nearest.
+    LazyX<float16> const h = a;
+    EXPECT_EQ(h.size(), nelems);
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_NEAR(h[i], a[i], std::abs(a[i]) * 0x1p-11F);
+
+    // Computed in `float`, where only the operands and the result are rounded.
+    LazyX<float16> c = h * b + 1.0F;
+    LazyX<float> const wide = (h * b + 1.0F).eval();
+    for (std::size_t i = 0; i < nelems; ++i) {
+        EXPECT_EQ(wide[i], h[i] * b[i] + 1.0F);
+        EXPECT_NEAR(c[i], wide[i], std::abs(wide[i]) * 0x1p-11F);
+    }
+    EXPECT_NEAR(h.dot(b), wide.hsum() - nelems, 1e-3F * nelems);
+
+    // The copies stay narrow, and the aliased assignment reads before writing.
+    LazyX<float16> d = c;
+    d = d * 2.0F;
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_EQ(d[i], c[i] * 2.0F);
+
+    LazyX<float16> e(4, 0.1F);
+    e.set(3, 65504.0F);
+    EXPECT_EQ(e[0], 0.0999755859375F);
+    EXPECT_EQ(e[3], 65504.0F);
+    EXPECT_EQ(sizeof(*e.data()), 2);
+}
+
+TEST_F(VecteurNarrowTests, BFloat16) {
+    auto const a = RandVecteur(nelems, 3);
+
+    // The 8-bit significand keeps the range of `float`.
+    LazyX<bfloat16> const h = a * 1e30F;
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_NEAR(h[i], a[i] * 1e30F, std::abs(a[i]) * 1e30F * 0x1p-8F);
+
+    LazyX<float> const back = h / 1e30F;
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_NEAR(back[i], a[i], std::abs(a[i]) * 0x1p-7F);
+}
+
+TEST_F(VecteurNarrowTests, Properties) {
+    std::string_view const source = R"(
+weights = [0.5, 0.25, 1, 3.14159]
+ids = [1, 2, 3]
+)";
+    Properties props{toml::parse(source), source};
+
+    auto const weights = props.get<LazyX<float16>>("weights");
+    ASSERT_EQ(weights.size(), 4);
+    EXPECT_EQ(weights[0], 0.5F);
+    EXPECT_EQ(weights[2], 1.0F);
+    EXPECT_NEAR(weights[3], 3.14159F, 0x1p-9F);
+
+    auto const ids = props.get<Vec3i>("ids");
+    EXPECT_EQ(ids[2], 3);
+    EXPECT_THROW((void)props.get<Vec4i>("ids"), std::exception);
+
+    // The narrow scalars are written widened, thus read back exactly.
+    props.set("weights", LazyX<float16>(weights * 2.0F));
+    auto const doubled = props.get<LazyX<bfloat16>>("weights");
+    EXPECT_EQ(doubled[1], 0.5F);
+    EXPECT_EQ(props.get<LazyX<float16>>("weights")[3], weights[3] * 2.0F);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+class VecteurParallelTests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    // Spans a few blocks and a partial one.
+    static constexpr std::size_t nelems{(std::size_t{1} << 18) + 1234};
+
+    template <typename Scalar>
+    [[nodiscard]] static LazyX<Scalar> RandVecteur(std::size_t size, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> valDis(-1.0, 1.0);
+
+        LazyX<Scalar> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = static_cast<Scalar>(valDis(gen));
+        return result;
+    }
+};
+
+TEST_F(VecteurParallelTests, ParallelFor) {
+    EXPECT_GE(vecteur::ParallelConcurrency(), 1);
+
+    std::vector<std::atomic<int>> counts(1000);
+    vecteur::detail::ParallelFor(counts.size(), [&](std::size_t i) {
+        // The nested ones share the threads with the outer ones.
+        vecteur::detail::ParallelFor(3, [&](std::size_t) { counts[i].fetch_add(1); });
+    });
+    for (auto const &count : counts)
+        EXPECT_EQ(count.load(), 3);
+}
+
+TEST_F(VecteurParallelTests, Eval) {
+    auto const a = RandVecteur<float>(nelems, 1), b = RandVecteur<float>(nelems, 2);
+
+    LazyX<float> const serial = (a * b + 1.0F).abs().sqrt() - a;
+    LazyX<float> const parallel = ((a * b + 1.0F).abs().sqrt() - a).eval(par);
+    ASSERT_EQ(parallel.size(), nelems);
+    for (std::size_t i = 0; i < nelems; ++i)
+        ASSERT_EQ(parallel[i], serial[i]);
+
+    // Below the threshold, the evaluation is the serial one.
+    LazyX<double> const small(100, 2.0);
+    EXPECT_EQ((small * 3.0).eval(par)[99], 6.0);
+}
+
+TEST_F(VecteurParallelTests, Reduce) {
+    auto const a = RandVecteur<double>(nelems, 3), b = RandVecteur<double>(nelems, 4);
+
+    double dot = 0.0, sum = 0.0;
+    for (std::size_t i = 0; i < nelems; ++i) {
+        dot += a[i] * b[i];
+        sum += a[i] - b[i];
+    }
+    EXPECT_NEAR(a.dot(b, par), dot, 1e-9);
+    EXPECT_NEAR((a - b).hsum(par), sum, 1e-9);
+    EXPECT_NEAR((a * 2.0).dot(b, par), 2.0 * dot, 1e-9);
+
+    // The blocks do not depend on the threads, thus neither does the result.
+    auto const first = a.dot(b, par);
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(a.dot(b, par), first);
+
+    // A lower threshold splits smaller vecteurs.
+    LazyX<int32_t> const ones(5000, 1);
+    EXPECT_EQ(ones.hsum(ParallelPolicy{.threshold = 0}), 5000);
+    EXPECT_EQ(ones.dot(ones * 2, ParallelPolicy{.threshold = 0}), 10000);
+}
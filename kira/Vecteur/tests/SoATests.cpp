@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <random>
+
+#include "kira/Vecteur.h"
+#include "kira/Vecteur/SoA.h"
+
+using namespace kira;
+
+using LazyXf = Vecteur<float, std::dynamic_extent, VecteurBackend::Lazy>;
+
+class VecteurSoATests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    // Not a multiple of the lanes, s.t. the remainder is covered.
+    static constexpr std::size_t npoints{37};
+
+    [[nodiscard]] static Eigen::MatrixX3f RandPoints(std::size_t size) {
+        std::mt19937 gen(size);
+        std::uniform_real_distribution<float> valDis(-1.0F, 1.0F);
+
+        Eigen::MatrixX3f result(size, 3);
+        for (Eigen::Index i = 0; i < result.rows(); ++i)
+            for (Eigen::Index j = 0; j < 3; ++j)
+                result(i, j) = valDis(gen);
+        return result;
+    }
+};
+
+TEST_F(VecteurSoATests, Construct) {
+    Vec3fSoA const v1(npoints, 2.0F);
+    EXPECT_EQ(v1.size(), npoints);
+    for (std::size_t d = 0; d < 3; ++d)
+        for (std::size_t i = 0; i < npoints; ++i)
+            EXPECT_FLOAT_EQ(v1.lane(d)[i], 2.0F);
+
+    Vec3fSoA v2(npoints);
+    v2.set_point(3, Vec3fSoA::Point(1.0F, 2.0F, 3.0F));
+    auto const p = v2.point(3);
+    EXPECT_FLOAT_EQ(p.x(), 1.0F);
+    EXPECT_FLOAT_EQ(p.y(), 2.0F);
+    EXPECT_FLOAT_EQ(p.z(), 3.0F);
+    EXPECT_FLOAT_EQ(v2.lane(2)[3], 3.0F);
+}
+
+TEST_F(VecteurSoATests, EigenConversion) {
+    Eigen::MatrixX3f const points = RandPoints(npoints);
+    Vec3fSoA const soa(points);
+    EXPECT_EQ(soa.size(), npoints);
+    for (std::size_t i = 0; i < npoints; ++i)
+        for (std::size_t d = 0; d < 3; ++d)
+            EXPECT_EQ(soa.lane(d)[i], points(i, d));
+    EXPECT_EQ(soa.to_eigen(), points);
+
+    // The row-major (AoS) layout.
+    using RowMajor = Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>;
+    RowMajor const aos = points;
+    EXPECT_EQ(Vec3fSoA(aos).to_eigen<Eigen::RowMajor>(), aos);
+
+    Eigen::MatrixXf const wrong(4, 2);
+    EXPECT_THROW(Vec3fSoA{wrong}, Anyhow);
+}
+
+TEST_F(VecteurSoATests, Arithmetic) {
+    Eigen::MatrixX3f const pa = RandPoints(npoints), pb = RandPoints(npoints + 1).topRows(npoints);
+    Vec3fSoA const a(pa), b(pb);
+    LazyXf w(npoints);
+    for (std::size_t i = 0; i < npoints; ++i)
+        w[i] = static_cast<float>(i);
+
+    Vec3fSoA const c = (a + b) * 2.0F - a;
+    Vec3fSoA const d = a * w;
+    Vec3fSoA const e = -a.abs();
+    for (std::size_t i = 0; i < npoints; ++i) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            EXPECT_FLOAT_EQ(c.lane(k)[i], (pa(i, k) + pb(i, k)) * 2.0F - pa(i, k));
+            EXPECT_FLOAT_EQ(d.lane(k)[i], pa(i, k) * w[i]);
+            EXPECT_FLOAT_EQ(e.lane(k)[i], -std::abs(pa(i, k)));
+        }
+    }
+}
+
+TEST_F(VecteurSoATests, Geometry) {
+    Eigen::MatrixX3f const pa = RandPoints(npoints), pb = RandPoints(npoints + 1).topRows(npoints);
+    Vec3fSoA a(pa);
+    Vec3fSoA const b(pb);
+
+    // Every lane is fused into a single packet loop, except for the multiply-adds fused on a target
+    // without the FMA instructions, which are evaluated element-wise.
+    static_assert(
+        std::decay_t<decltype(a.cross(b).lane(0))>::packetable or
+        (KIRA_VECTEUR_FUSE_MUL_ADD and not vecteur::detail::is_packet_mul_add_fused)
+    );
+    static_assert(std::decay_t<decltype(a.normalize().lane(0))>::packetable);
+
+    Vec3fSoA const cross = a.cross(b);
+    LazyXf const dot = a.dot(b);
+    LazyXf const norm = a.norm();
+    Vec3fSoA const normalized = a.normalize();
+    for (std::size_t i = 0; i < npoints; ++i) {
+        Eigen::Vector3f const va = pa.row(i), vb = pb.row(i);
+        Eigen::Vector3f const vc = va.cross(vb);
+        for (std::size_t k = 0; k < 3; ++k) {
+            EXPECT_NEAR(cross.lane(k)[i], vc[k], 1e-6F);
+            EXPECT_NEAR(normalized.lane(k)[i], va.normalized()[k], 1e-6F);
+        }
+        EXPECT_NEAR(dot[i], va.dot(vb), 1e-6F);
+        EXPECT_NEAR(norm[i], va.norm(), 1e-6F);
+    }
+
+    Vec3fSoA c(npoints);
+    c.noalias() = a.cross(b);
+    for (std::size_t i = 0; i < npoints; ++i)
+        for (std::size_t k = 0; k < 3; ++k)
+            EXPECT_EQ(c.lane(k)[i], cross.lane(k)[i]);
+
+    // The lanes of the cross product read the other lanes of the destination.
+    a = a.cross(b);
+    for (std::size_t i = 0; i < npoints; ++i)
+        for (std::size_t k = 0; k < 3; ++k)
+            EXPECT_EQ(a.lane(k)[i], cross.lane(k)[i]);
+}
+
+TEST_F(VecteurSoATests, Transform) {
+    Eigen::MatrixX3f const pa = RandPoints(npoints);
+    Vec3fSoA const a(pa);
+
+    Mat4f const m(Vec4f(0, 1, 0, 0), Vec4f(-2, 0, 0, 0), Vec4f(0, 0, 1, 0), Vec4f(1, 2, 3, 1));
+    Vec3fSoA const points = transform_points(m, a);
+    Vec3fSoA const vectors = transform_vectors(m, a);
+    for (std::size_t i = 0; i < npoints; ++i) {
+        auto const p = m.transform_point(a.point(i)), v = m.transform_vector(a.point(i));
+        for (std::size_t k = 0; k < 3; ++k) {
+            EXPECT_NEAR(points.lane(k)[i], p[k], 1e-6F);
+            EXPECT_NEAR(vectors.lane(k)[i], v[k], 1e-6F);
+        }
+    }
+}
@@ -666,6 +666,18 @@ TEST_F(VecteurStaticTests, ToArray) {
     });
 }
 
+TEST_F(VecteurStaticTests, LazyMatchesGeneric) {
+    Vecteur<int, 3, VecteurBackend::Generic> const ag{3, 4, 5}, bg{1, 2, 3};
+    Vecteur<int, 3, VecteurBackend::Lazy> const al{3, 4, 5}, bl{1, 2, 3};
+
+    auto const cg = ag + bg;
+    auto const fg = (cg + ag) + (ag + cg);
+    auto const cl = al + bl;
+    auto const fl = (cl + al) + (al + cl);
+    for (std::size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(fg[i], fl[i]);
+}
+
 TEST_F(VecteurStaticTests, FresnelConductor) {
     Vecteur<float, 3, VecteurBackend::Lazy> etaI{1.0f, 1.1f, 1.2f};
     Vecteur<float, 3, VecteurBackend::Lazy> etaT{1.5f, 1.6f, 1.7f};
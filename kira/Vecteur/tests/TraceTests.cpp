@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include "kira/Vecteur.h"
+
+using namespace kira;
+
+template <typename Scalar>
+using LazyX = Vecteur<Scalar, std::dynamic_extent, VecteurBackend::Lazy>;
+
+class VecteurTraceTests : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+protected:
+    // Spans a few chunks and a partial one.
+    static constexpr std::size_t nelems{5000};
+
+    template <typename Scalar>
+    [[nodiscard]] static LazyX<Scalar> RandVecteur(std::size_t size, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> valDis(1.0, 2.0);
+
+        LazyX<Scalar> result(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result[i] = static_cast<Scalar>(valDis(gen));
+        return result;
+    }
+};
+
+TEST_F(VecteurTraceTests, Record) {
+    auto const la = RandVecteur<float>(nelems, 1), lb = RandVecteur<float>(nelems, 2);
+    TraceXf const a(la), b(lb);
+
+    TraceXf const c = a * b + 1.0F;
+    TraceXf const d = (c * c).sqrt() - c / 2.0F;
+    EXPECT_TRUE(d.is_recorded());
+    EXPECT_EQ(d.size(), nelems);
+
+    for (std::size_t i = 0; i < nelems; ++i) {
+        auto const ci = la[i] * lb[i] + 1.0F;
+        EXPECT_FLOAT_EQ(d[i], std::sqrt(ci * ci) - ci / 2.0F);
+    }
+    EXPECT_FALSE(d.is_recorded());
+    // `c` is an intermediate of `d`, thus still recorded.
+    EXPECT_TRUE(c.is_recorded());
+    EXPECT_FLOAT_EQ(c[3], la[3] * lb[3] + 1.0F);
+
+    // The scalar operands are broadcast, or folded with the other scalars.
+    TraceXd const e(nelems, 2.0);
+    TraceXd const f = 1.0 - (e * 3.0).sqr();
+    EXPECT_FALSE(f.is_recorded());
+    EXPECT_DOUBLE_EQ(f[nelems - 1], -35.0);
+
+    TraceXi const g(RandVecteur<int32_t>(nelems, 3) * 10);
+    TraceXi const h = (g * g - g).max(3);
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_EQ(h[i], std::max(g[i] * g[i] - g[i], 3));
+}
+
+TEST_F(VecteurTraceTests, CommonSubexpressions) {
+    auto const la = RandVecteur<double>(nelems, 4), lb = RandVecteur<double>(nelems, 5);
+    TraceXd const a(la), b(lb);
+
+    // `a * b` is recorded twice and computed once.
+    TraceXd const c = (a * b).exp() + (a * b).log();
+    EXPECT_FALSE(c.eval().is_recorded());
+    auto const stats = LastTraceStats();
+    EXPECT_EQ(stats.nodes, 5);
+    EXPECT_EQ(stats.instructions, 6); // a, b, a * b, exp, log, +
+    EXPECT_LE(stats.registers, 2);
+    for (std::size_t i = 0; i < nelems; ++i)
+        EXPECT_NEAR(c[i], std::exp(la[i] * lb[i]) + std::log(la[i] * lb[i]), 1e-12 * c[i]);
+}
+
+TEST_F(VecteurTraceTests, Schedule) {
+    auto const la = RandVecteur<float>(nelems, 6);
+    TraceXf const a(la);
+
+    // The outputs sharing `a.sqrt()` are evaluated by a single program.
+    TraceXf const s = a.sqrt();
+    TraceXf const x = s * 2.0F, y = s + 1.0F;
+    TraceXf const unused = a.exp();
+    x.schedule();
+    y.schedule();
+    TraceEvalScheduled();
+
+    auto const stats = LastTraceStats();
+    EXPECT_FALSE(x.is_recorded());
+    EXPECT_FALSE(y.is_recorded());
+    EXPECT_TRUE(unused.is_recorded());
+    EXPECT_EQ(stats.instructions, 6); // a, sqrt, 2, *, 1, +
+    for (std::size_t i = 0; i < nelems; ++i) {
+        EXPECT_FLOAT_EQ(x[i], std::sqrt(la[i]) * 2.0F);
+        EXPECT_FLOAT_EQ(y[i], std::sqrt(la[i]) + 1.0F);
+    }
+
+    // The reductions are scheduling points.
+    TraceXf const z = a * 3.0F;
+    EXPECT_NEAR(z.dot(a), 3.0F * la.dot(la), 1e-3F * la.dot(la));
+    EXPECT_NEAR((a - 1.0F).hsum(), la.hsum() - nelems, 1e-2F);
+}
+
+TEST_F(VecteurTraceTests, LongChain) {
+    // The graph is traversed without recursion, and the registers are reused.
+    TraceXd a(nelems, 0.0);
+    TraceXd const one(LazyX<double>(nelems, 1.0));
+    for (int i = 0; i < 10000; ++i)
+        a = a + one;
+    EXPECT_DOUBLE_EQ(a[0], 10000.0);
+    EXPECT_LE(LastTraceStats().registers, 1);
+}
+
+TEST_F(VecteurTraceTests, DeepChain) {
+    // Neither evaluated nor released recursively.
+    auto const record = [] {
+        TraceXf x(LazyX<float>(4, 0.0F));
+        for (int i = 0; i < 500000; ++i)
+            x = x + 1.0F;
+        return x;
+    };
+    record();
+    EXPECT_FLOAT_EQ(record()[0], 500000.0F);
+}
+
+TEST_F(VecteurTraceTests, Parallel) {
+    constexpr std::size_t size = std::size_t{1} << 20;
+    auto const la = RandVecteur<float>(size, 7);
+    TraceXf const a(la);
+    TraceXf const b = (a * a + a).sqrt();
+    EXPECT_FALSE(b.eval().is_recorded());
+    EXPECT_GE(LastTraceStats().threads, 1);
+    for (std::size_t i = 0; i < size; i += 97)
+        EXPECT_FLOAT_EQ(b[i], std::sqrt(la[i] * la[i] + la[i]));
+    EXPECT_FLOAT_EQ(b[size - 1], std::sqrt(la[size - 1] * la[size - 1] + la[size - 1]));
+}
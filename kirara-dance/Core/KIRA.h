@@ -3,8 +3,12 @@
 #include <kira/Anyhow.h>
 #include <kira/Assertions.h>
 #include <kira/Compiler.h>
+#include <kira/FlatHashMap.h>
 #include <kira/FileResolver.h>
 #include <kira/Logger.h>
+#include <kira/MemoryTracker.h>
+#include <kira/Profiler.h>
+#include <kira/ThreadPool.h>
 
 namespace krd {
 // NOLINTBEGIN
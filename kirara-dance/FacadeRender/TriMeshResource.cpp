@@ -1,7 +1,5 @@
 #include "TriMeshResource.h"
 
-#include <tbb/parallel_for.h>
-
 namespace krd {
 void TriMeshResource::uploadTriMesh(TriangleMesh *triMesh, SlangGraphicsContext *context) {
     deviceData = std::make_shared<DeviceData>();
@@ -25,35 +23,35 @@ void TriMeshResource::uploadTriMesh(TriangleMesh *triMesh, SlangGraphicsContext
     vertices.resize(triMesh->getNumVertices());
     indices.resize(triMesh->getNumFaces() * 3);
 
-    tbb::parallel_for(
-        tbb::blocked_range<long>(0, triMesh->getNumVertices()),
-        [&](tbb::blocked_range<long> const &r) {
-        for (long i = r.begin(); i != r.end(); ++i) {
-            auto const &oVertex = oVertices.row(i);
-            auto const &oNormal = oNormals.row(i);
+    kira::ParallelFor(
+        0, static_cast<std::size_t>(triMesh->getNumVertices()),
+        [&](std::size_t begin, std::size_t end) {
+            for (auto i = static_cast<long>(begin); i != static_cast<long>(end); ++i) {
+                auto const &oVertex = oVertices.row(i);
+                auto const &oNormal = oNormals.row(i);
 
-            vertices[i].position[0] = oVertex[0];
-            vertices[i].position[1] = oVertex[1];
-            vertices[i].position[2] = oVertex[2];
+                vertices[i].position[0] = oVertex[0];
+                vertices[i].position[1] = oVertex[1];
+                vertices[i].position[2] = oVertex[2];
 
-            vertices[i].normal[0] = oNormal[0];
-            vertices[i].normal[1] = oNormal[1];
-            vertices[i].normal[2] = oNormal[2];
+                vertices[i].normal[0] = oNormal[0];
+                vertices[i].normal[1] = oNormal[1];
+                vertices[i].normal[2] = oNormal[2];
+            }
         }
-    }
     );
 
-    tbb::parallel_for(
-        tbb::blocked_range<long>(0, triMesh->getNumFaces()),
-        [&](tbb::blocked_range<long> const &r) {
-        for (long i = r.begin(); i != r.end(); ++i) {
-            auto const &oFace = oFaces.row(i);
+    kira::ParallelFor(
+        0, static_cast<std::size_t>(triMesh->getNumFaces()),
+        [&](std::size_t begin, std::size_t end) {
+            for (auto i = static_cast<long>(begin); i != static_cast<long>(end); ++i) {
+                auto const &oFace = oFaces.row(i);
 
-            indices[i * 3 + 0] = oFace[0];
-            indices[i * 3 + 1] = oFace[1];
-            indices[i * 3 + 2] = oFace[2];
+                indices[i * 3 + 0] = oFace[0];
+                indices[i * 3 + 1] = oFace[1];
+                indices[i * 3 + 2] = oFace[2];
+            }
         }
-    }
     );
 
     //
@@ -66,9 +66,15 @@ int main() try {
         LogWarn("No animation ID found");
 
     window->mainLoop([&](float deltaTime) -> void {
+        KIRA_PROFILE_SCOPE("Frame");
+        kira::MarkMemoryFrame();
+
         // This is currently a hack, to discard any modifications to the sceneRoot itself, i.e.,
         // additional resource attachments.
-        auto transientSceneRoot = sceneRoot->clone();
+        auto transientSceneRoot = [&] {
+            KIRA_MEMORY_SCOPE("SceneGraph");
+            return sceneRoot->clone();
+        }();
         KRD_ASSERT(transientSceneRoot);
 
         bool isNodeUpdated{false};
@@ -98,6 +104,13 @@ int main() try {
         SGC->renderFrame(transientSceneRoot, camera);
     });
 
+    if constexpr (kira::profilerEnabled) {
+        kira::LogProfileSummary();
+        kira::WriteChromeTrace("kirara-dance.trace.json");
+    }
+    if constexpr (kira::memoryTrackerEnabled)
+        kira::LogMemoryStats();
+
     return 0;
 } catch (std::exception const &e) {
     krd::LogError("{}", e.what());
@@ -151,14 +151,19 @@ private:
 SceneBuilder::SceneBuilder() : sceneRoot(SceneRoot::create()) {}
 
 void SceneBuilder::loadFromFile(std::filesystem::path const &path) {
+    KIRA_PROFILE_SCOPE("SceneBuilder::loadFromFile");
     if (sceneRoot)
         sceneRoot.reset();
     sceneRoot = SceneRoot::create();
 
     Assimp::Importer importer;
 
-    aiScene const *aiScene =
-        importer.ReadFile(path.string(), aiProcess_Triangulate | aiProcess_PopulateArmatureData);
+    aiScene const *aiScene = [&] {
+        KIRA_PROFILE_SCOPE("SceneBuilder::import");
+        return importer.ReadFile(
+            path.string(), aiProcess_Triangulate | aiProcess_PopulateArmatureData
+        );
+    }();
     if (!aiScene || !aiScene->mRootNode || aiScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
         throw kira::Anyhow(
             "SceneBuilder: Failed to load the scene from '{:s}': {:s}", path.string(),
@@ -201,6 +206,7 @@ void SceneBuilder::loadFromFile(std::filesystem::path const &path) {
     // A second pass is performed to actually initialize the mesh. Since the mesh initialization
     // requires the node hierarchy to be build.
     for (auto &[meshId, triMesh] : triMap) {
+        KIRA_PROFILE_SCOPE("SceneBuilder::loadMesh");
         auto *inMesh = aiScene->mMeshes[meshId];
         triMesh->loadFromAssimp(inMesh, std::string_view{}, transIdMap);
     }
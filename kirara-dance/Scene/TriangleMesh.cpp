@@ -3,7 +3,6 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <igl/per_vertex_normals.h>
-#include <tbb/parallel_for.h>
 
 #include <assimp/Importer.hpp>
 
@@ -12,6 +11,8 @@
 
 namespace krd {
 void TriangleMesh::loadFromAssimp(aiMesh const *inMesh, std::string_view name) {
+    KIRA_MEMORY_SCOPE("Mesh");
+
     // Validate the `inMesh`
     if (!inMesh->HasPositions() || !inMesh->HasFaces())
         throw kira::Anyhow(
@@ -59,6 +60,7 @@ void TriangleMesh::loadFromAssimp(
     aiMesh const *inMesh, std::string_view name,
     std::unordered_map<std::string, uint64_t> const &transIdMap
 ) {
+    KIRA_MEMORY_SCOPE("Mesh");
     loadFromAssimp(inMesh, name);
 
     if (inMesh->HasBones()) {
@@ -167,6 +169,9 @@ void TriangleMesh::calculateNormal(TriangleMesh::NormalWeightingType weighting)
 }
 
 Ref<TriangleMesh> TriangleMesh::adaptLinearBlendSkinning(Ref<Node> const &root) const {
+    KIRA_PROFILE_SCOPE("TriangleMesh::adaptLinearBlendSkinning");
+    KIRA_MEMORY_SCOPE("Skinning");
+
     // Extract the transforms
     ExtractRelativeTransforms::Desc desc{.rootNodeIds = rootNodeIds, .nodeIds = nodeIds};
     ExtractRelativeTransforms eNodeTrans(desc);
@@ -188,27 +193,31 @@ Ref<TriangleMesh> TriangleMesh::adaptLinearBlendSkinning(Ref<Node> const &root)
         boneTransforms.emplace_back(it->second);
     }
 
-    tbb::parallel_for(
-        tbb::blocked_range<long>(0, newMesh->V.rows()),
-        [&](tbb::blocked_range<long> const &range) {
-        for (auto i = range.begin(); i != range.end(); ++i) {
-            auto const eVtx = V.row(i);
-            auto vtx = float4{eVtx.x(), eVtx.y(), eVtx.z(), 1.0f};
-            auto res = float3{0.0f, 0.0f, 0.0f};
-            for (long j = 0; j < W.cols(); ++j) {
-                auto inc = mul(boneTransforms[j], mul(inverseBindMatrices[j], vtx));
-                inc.xyz() /= inc.w;
-                res += W(i, j) * inc.xyz();
+    kira::ParallelFor(
+        0, static_cast<std::size_t>(newMesh->V.rows()),
+        [&](std::size_t begin, std::size_t end) {
+            KIRA_PROFILE_SCOPE("TriangleMesh::skinVertices");
+            for (auto i = static_cast<long>(begin); i != static_cast<long>(end); ++i) {
+                auto const eVtx = V.row(i);
+                auto vtx = float4{eVtx.x(), eVtx.y(), eVtx.z(), 1.0f};
+                auto res = float3{0.0f, 0.0f, 0.0f};
+                for (long j = 0; j < W.cols(); ++j) {
+                    auto inc = mul(boneTransforms[j], mul(inverseBindMatrices[j], vtx));
+                    inc.xyz() /= inc.w;
+                    res += W(i, j) * inc.xyz();
+                }
+
+                newMesh->V(i, 0) = res.x;
+                newMesh->V(i, 1) = res.y;
+                newMesh->V(i, 2) = res.z;
             }
-
-            newMesh->V(i, 0) = res.x;
-            newMesh->V(i, 1) = res.y;
-            newMesh->V(i, 2) = res.z;
         }
-    }
     );
 
-    newMesh->calculateNormal();
+    {
+        KIRA_PROFILE_SCOPE("TriangleMesh::calculateNormal");
+        newMesh->calculateNormal();
+    }
     return newMesh;
 }
 } // namespace krd
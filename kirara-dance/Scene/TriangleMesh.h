@@ -2,6 +2,7 @@
 
 #include <Eigen/Core>
 #include <range/v3/view/single.hpp>
+#include <unordered_map>
 
 #include "Core/Math.h"
 #include "Core/Object.h"
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <kira/FlatHashMap.h>
 
 #include "Core/Math.h"
 #include "Scene/SceneRoot.h"
@@ -12,12 +11,12 @@ namespace krd {
 /// \brief A visitor to extract the node transforms.
 ///
 /// This class traverses a scene graph and computes the accumulated transformation matrices for
-/// specified nodes relative to specified root nodes. The results are stored in an unordered_map
+/// specified nodes relative to specified root nodes. The results are stored in a flat hash map
 /// mapping node IDs to their 4x4 transformation matrices.
 ///
 /// \remark The transformation of the root node itself is not included in the accumulated transform.
 class ExtractRelativeTransforms : public ConstVisitor,
-                                  public std::unordered_map<uint64_t, float4x4> {
+                                  public kira::FlatHashMap<uint64_t, float4x4> {
 public:
     /// \brief Descriptor for configuring the ExtractRelativeTransforms visitor.
     struct Desc {
@@ -108,12 +107,12 @@ public:
 private:
     /// \brief The map between a root node ID and its current accumulated transform.
     /// This is used during traversal to build up the transform chain.
-    std::unordered_map<uint64_t, float4x4> transformMap;
+    kira::FlatHashMap<uint64_t, float4x4> transformMap;
 
     /// \brief The map between a target node ID and its corresponding root node ID.
-    std::unordered_map<uint64_t, uint64_t> nodeIdMap;
+    kira::FlatHashMap<uint64_t, uint64_t> nodeIdMap;
 
     /// \brief A set of all root node IDs for quick lookup.
-    std::unordered_set<uint64_t> rootNodeIdSet;
+    kira::FlatHashSet<uint64_t> rootNodeIdSet;
 };
 } // namespace krd
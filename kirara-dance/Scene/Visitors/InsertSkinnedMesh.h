@@ -18,6 +18,7 @@ public:
 
 public:
     void apply(SceneRoot &val) override {
+        KIRA_PROFILE_SCOPE("InsertSkinnedMesh");
         root = &val;
         auto children = val.getGeomGroup()->traverse(*this);
         for (auto const &child : children)
@@ -8,6 +8,9 @@
 #include <cmath>
 #include <limits>
 
+// NOTE(krr): The primitives here are not profiled, since a zone costs more than a single test.
+// The `KIRA_PROFILE_SCOPE` zones belong around the broad- and narrow-phase loops calling them,
+// which are deferred until the collision pipeline exists.
 namespace krd::ipc {
 ///
 /// \brief Epsilon multipliers for CCD roots and predicates.